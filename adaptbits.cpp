@@ -0,0 +1,1532 @@
+/***************************************************************************
+*                   Adaptive Arrays of Arbitrary Bit Length
+*
+*   File    : adaptbits.cpp
+*   Purpose : Provides an arbitrary length array of bits that picks its
+*             own storage as its contents change.
+*
+*             Three representations are used:
+*             BIT_REP_DENSE  - a bit_array_c, Size() / CHAR_BIT bytes
+*             BIT_REP_SORTED - ascending list of set bits, 1 entry per bit
+*             BIT_REP_RUNS   - ascending list of (first, length) runs of
+*                              set bits, 1 entry per run
+*
+*             The number of set bits and the number of runs are kept up to
+*             date by every change, so the size each representation would
+*             need is always known.  After each change the smallest
+*             representation is chosen, but the array only converts to it
+*             if it is less than 1/HYSTERESIS the size of the current one.
+*             The gap between the switch points keeps an array hovering
+*             near a boundary from converting back and forth.
+*
+*             Inserting into or removing from a list moves the entries
+*             after it, so a list update costs time in proportion to the
+*             list's length.  Lists are therefore limited to
+*             MAX_LIST_ENTRIES, and a list that grows past the limit, or
+*             past the size of the dense representation, is converted
+*             right away without waiting for the hysteresis gap.
+*
+*             Bitwise operations, shifts and set relations work on runs of
+*             set bits, so every representation is read the same way and
+*             the cost depends on the number of runs rather than Size().
+*             Only operations between two dense arrays fall back to the
+*             word at a time bit_array_c versions.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "adaptbits.h"
+#include "bitwords.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* a new representation must be this many times smaller to switch to it */
+#define HYSTERESIS            2
+
+/* longest list allowed, this bounds the entries moved by one update */
+#define MAX_LIST_ENTRIES      4096
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* operations applied by Combine */
+typedef enum
+{
+    RUN_OP_AND,
+    RUN_OP_OR,
+    RUN_OP_XOR,
+    RUN_OP_NOT                  /* source array is ignored */
+} run_op_t;
+
+/***************************************************************************
+*                                FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : CountRuns
+*   Description: This function counts the runs of set bits in a bit array
+*                a word at a time.  A run starts at each set bit whose
+*                previous bit is clear.
+*   Parameters : bits - bit array to count runs in
+*   Effects    : None
+*   Returned   : Number of runs of set bits in bits
+***************************************************************************/
+static size_t CountRuns(const bit_array_c &bits)
+{
+    const unsigned char *chars;
+    size_t size, i, runs;
+    uint64_t word, last;
+
+    chars = bits.Chars();
+    size = BITS_TO_CHARS(bits.Size());
+    runs = 0;
+    last = 0;                           /* bit before the current word */
+
+    for (i = 0; (i + WORD_CHARS) <= size; i += WORD_CHARS)
+    {
+        word = LoadBigEndian(&chars[i]);
+        runs += PopCount(word & ~((word >> 1) | (last << 63)));
+        last = word & 1;
+    }
+
+    for (; i < size; i++)
+    {
+        word = chars[i];
+        runs += PopCount(word & ~((word >> 1) | (last << (CHAR_BIT - 1))));
+        last = word & 1;
+    }
+
+    return runs;
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : adaptive_bit_array_c - constructor
+*   Description: This is the adaptive_bit_array_c constructor.  A new
+*                array has no bits set, so it starts as an empty sorted
+*                list.
+*   Parameters : numBits - number of bits in the array
+*   Effects    : Array is created with all bits cleared
+*   Returned   : None
+***************************************************************************/
+adaptive_bit_array_c::adaptive_bit_array_c(const size_t numBits):
+    m_NumBits(numBits),
+    m_Count(0),
+    m_RunCount(0),
+    m_Rep(BIT_REP_SORTED),
+    m_Dense(NULL),
+    m_Members(NULL),
+    m_Runs(NULL),
+    m_Capacity(0)
+{
+    if (numBits < 1)
+    {
+        throw invalid_argument("Error: Bit Array must have at least 1 bit.");
+    }
+}
+
+/***************************************************************************
+*   Method     : ~adaptive_bit_array_c - destructor
+*   Description: This is the adaptive_bit_array_c destructor.
+*   Parameters : None
+*   Effects    : Storage is freed
+*   Returned   : None
+***************************************************************************/
+adaptive_bit_array_c::~adaptive_bit_array_c(void)
+{
+    FreeStorage();
+}
+
+/***************************************************************************
+*   Method     : FreeStorage
+*   Description: This method frees the storage of every representation.
+*   Parameters : None
+*   Effects    : Storage is freed and the list capacity is 0
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::FreeStorage(void)
+{
+    delete m_Dense;
+    delete[] m_Members;
+    delete[] m_Runs;
+
+    m_Dense = NULL;
+    m_Members = NULL;
+    m_Runs = NULL;
+    m_Capacity = 0;
+}
+
+/***************************************************************************
+*   Method     : RepSize
+*   Description: This method computes the number of bytes a representation
+*                needs to hold the current contents of the array.
+*   Parameters : rep - representation to size
+*   Effects    : None
+*   Returned   : Bytes needed by rep
+***************************************************************************/
+size_t adaptive_bit_array_c::RepSize(const bit_rep_t rep) const
+{
+    switch (rep)
+    {
+        case BIT_REP_DENSE:
+            return BITS_TO_CHARS(m_NumBits);
+
+        case BIT_REP_SORTED:
+            return m_Count * sizeof(size_t);
+
+        case BIT_REP_RUNS:
+        default:
+            return m_RunCount * sizeof(bit_run_t);
+    }
+}
+
+/***************************************************************************
+*   Method     : StorageSize
+*   Description: This method returns the number of bytes used to store the
+*                bits in the current representation.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Bytes used by the current representation
+***************************************************************************/
+size_t adaptive_bit_array_c::StorageSize(void) const
+{
+    return RepSize(m_Rep);
+}
+
+/***************************************************************************
+*   Method     : Eligible
+*   Description: This method tests if a representation may hold the
+*                current contents.  Lists longer than MAX_LIST_ENTRIES
+*                would be too slow to update.
+*   Parameters : rep - representation to test
+*   Effects    : None
+*   Returned   : true if rep may be used
+***************************************************************************/
+bool adaptive_bit_array_c::Eligible(const bit_rep_t rep) const
+{
+    switch (rep)
+    {
+        case BIT_REP_SORTED:
+            return (m_Count <= MAX_LIST_ENTRIES);
+
+        case BIT_REP_RUNS:
+            return (m_RunCount <= MAX_LIST_ENTRIES);
+
+        case BIT_REP_DENSE:
+        default:
+            return true;
+    }
+}
+
+/***************************************************************************
+*   Method     : Smallest
+*   Description: This method finds the smallest eligible representation
+*                for the current contents.  Ties go to the earlier of
+*                sorted list, runs and dense.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Smallest eligible representation
+***************************************************************************/
+bit_rep_t adaptive_bit_array_c::Smallest(void) const
+{
+    const bit_rep_t reps[] = {BIT_REP_SORTED, BIT_REP_RUNS};
+    bit_rep_t best;
+
+    best = BIT_REP_DENSE;
+    for (size_t i = 0; i < sizeof(reps) / sizeof(reps[0]); i++)
+    {
+        if (Eligible(reps[i]) && (RepSize(reps[i]) < RepSize(best)))
+        {
+            best = reps[i];
+        }
+    }
+
+    return best;
+}
+
+/***************************************************************************
+*   Method     : Adapt
+*   Description: This method picks the smallest eligible representation
+*                for the current contents and converts to it if it is less
+*                than 1/HYSTERESIS the size of the current representation.
+*                A list that is no longer eligible, or that has grown
+*                larger than the dense representation, is converted
+*                without waiting for the hysteresis gap.
+*   Parameters : None
+*   Effects    : Representation may change
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::Adapt(void)
+{
+    bit_rep_t best;
+    bool mustLeave;
+
+    mustLeave = !Eligible(m_Rep) ||
+        ((m_Rep != BIT_REP_DENSE) &&
+        (RepSize(m_Rep) > RepSize(BIT_REP_DENSE)));
+
+    best = Smallest();
+
+    if ((best != m_Rep) &&
+        (mustLeave || ((RepSize(best) * HYSTERESIS) < RepSize(m_Rep))))
+    {
+        Convert(best);
+    }
+}
+
+/***************************************************************************
+*   Method     : Convert
+*   Description: This method builds a new representation of the array's
+*                contents and then frees the old one.
+*   Parameters : rep - representation to convert to
+*   Effects    : Representation is changed
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::Convert(const bit_rep_t rep)
+{
+    bit_array_c *dense = NULL;
+    size_t *members = NULL;
+    bit_run_t *runs = NULL;
+    size_t capacity = 0;
+    size_t i, j;
+
+    if (rep == m_Rep)
+    {
+        return;
+    }
+
+    switch (rep)
+    {
+        case BIT_REP_DENSE:
+            dense = new bit_array_c(m_NumBits);
+
+            if (m_Rep == BIT_REP_SORTED)
+            {
+                dense->FromIndices(m_Members, m_Count, true);
+            }
+            else
+            {
+                for (i = 0; i < m_RunCount; i++)
+                {
+                    dense->SetRange(m_Runs[i].first, m_Runs[i].length);
+                }
+            }
+            break;
+
+        case BIT_REP_SORTED:
+            capacity = max(m_Count, (size_t)1);
+            members = new size_t[capacity];
+
+            if (m_Rep == BIT_REP_DENSE)
+            {
+                m_Dense->ToIndices(members, m_Count);
+            }
+            else
+            {
+                size_t k = 0;
+
+                for (i = 0; i < m_RunCount; i++)
+                {
+                    for (j = 0; j < m_Runs[i].length; j++)
+                    {
+                        members[k] = m_Runs[i].first + j;
+                        k++;
+                    }
+                }
+            }
+            break;
+
+        case BIT_REP_RUNS:
+            capacity = max(m_RunCount, (size_t)1);
+            runs = new bit_run_t[capacity];
+
+            if (m_Rep == BIT_REP_DENSE)
+            {
+                /* find runs a word at a time */
+                i = m_Dense->NextSet(0);
+                j = 0;
+
+                while (i < m_NumBits)
+                {
+                    size_t end = m_Dense->NextClear(i);
+
+                    runs[j].first = i;
+                    runs[j].length = end - i;
+                    j++;
+
+                    i = m_Dense->NextSet(end);
+                }
+            }
+            else
+            {
+                j = 0;
+
+                for (i = 0; i < m_Count; i++)
+                {
+                    if ((j > 0) &&
+                        ((runs[j - 1].first + runs[j - 1].length) ==
+                        m_Members[i]))
+                    {
+                        runs[j - 1].length++;
+                    }
+                    else
+                    {
+                        runs[j].first = m_Members[i];
+                        runs[j].length = 1;
+                        j++;
+                    }
+                }
+            }
+            break;
+    }
+
+    FreeStorage();
+
+    m_Dense = dense;
+    m_Members = members;
+    m_Runs = runs;
+    m_Capacity = capacity;
+    m_Rep = rep;
+}
+
+/***************************************************************************
+*   Method     : Reserve
+*   Description: This method makes sure the list used by the current
+*                representation has room for a number of entries, doubling
+*                its size if it must grow.
+*   Parameters : entries - number of entries needed
+*   Effects    : List may be reallocated
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::Reserve(const size_t entries)
+{
+    size_t capacity;
+
+    if (entries <= m_Capacity)
+    {
+        return;
+    }
+
+    capacity = max(entries, 2 * m_Capacity);
+
+    if (m_Rep == BIT_REP_SORTED)
+    {
+        size_t *members = new size_t[capacity];
+
+        copy(m_Members, m_Members + m_Count, members);
+        delete[] m_Members;
+        m_Members = members;
+    }
+    else if (m_Rep == BIT_REP_RUNS)
+    {
+        bit_run_t *runs = new bit_run_t[capacity];
+
+        copy(m_Runs, m_Runs + m_RunCount, runs);
+        delete[] m_Runs;
+        m_Runs = runs;
+    }
+
+    m_Capacity = capacity;
+}
+
+/***************************************************************************
+*   Method     : FindMember
+*   Description: This method binary searches the sorted list for a bit.
+*   Parameters : bit - bit to search for
+*   Effects    : None
+*   Returned   : Position of the first list entry that is >= bit
+***************************************************************************/
+size_t adaptive_bit_array_c::FindMember(const size_t bit) const
+{
+    return lower_bound(m_Members, m_Members + m_Count, bit) - m_Members;
+}
+
+/***************************************************************************
+*   Method     : FindRun
+*   Description: This method binary searches the run list for the runs
+*                that start at or before a bit.
+*   Parameters : bit - bit to search for
+*   Effects    : None
+*   Returned   : Number of runs that start at or before bit.  If it is
+*                non-zero, the run before it is the only one that may
+*                contain bit.
+***************************************************************************/
+size_t adaptive_bit_array_c::FindRun(const size_t bit) const
+{
+    size_t low, high;
+
+    low = 0;
+    high = m_RunCount;
+
+    while (low < high)
+    {
+        size_t middle = low + ((high - low) / 2);
+
+        if (m_Runs[middle].first <= bit)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/***************************************************************************
+*   Method     : NextRun
+*   Description: This method finds the first run of set bits at or after a
+*                bit.  A run that contains bit is cut short to start at
+*                bit.
+*   Parameters : bit - index of the first bit to examine
+*                run - receives the run found
+*   Effects    : None
+*   Returned   : true if there is a set bit at or after bit
+***************************************************************************/
+bool adaptive_bit_array_c::NextRun(const size_t bit, bit_run_t &run) const
+{
+    size_t i;
+
+    if (m_NumBits <= bit)
+    {
+        return false;
+    }
+
+    switch (m_Rep)
+    {
+        case BIT_REP_DENSE:
+            run.first = m_Dense->NextSet(bit);
+
+            if (run.first == m_NumBits)
+            {
+                return false;
+            }
+
+            run.length = m_Dense->NextClear(run.first) - run.first;
+            return true;
+
+        case BIT_REP_SORTED:
+            i = FindMember(bit);
+
+            if (i == m_Count)
+            {
+                return false;
+            }
+
+            run.first = m_Members[i];
+            run.length = 1;
+
+            while (((i + run.length) < m_Count) &&
+                (m_Members[i + run.length] == (run.first + run.length)))
+            {
+                run.length++;
+            }
+            return true;
+
+        case BIT_REP_RUNS:
+        default:
+            i = FindRun(bit);
+
+            if ((i > 0) &&
+                ((bit - m_Runs[i - 1].first) < m_Runs[i - 1].length))
+            {
+                /* bit is inside run i - 1 */
+                run.first = bit;
+                run.length = m_Runs[i - 1].first + m_Runs[i - 1].length - bit;
+                return true;
+            }
+
+            if (i == m_RunCount)
+            {
+                return false;
+            }
+
+            run = m_Runs[i];
+            return true;
+    }
+}
+
+/***************************************************************************
+*   Method     : AppendRun
+*   Description: This method adds a run of set bits after every bit that is
+*                already set.  It is used to build the result of an
+*                operation in order.  The array is kept as a run list until
+*                the list would be too long or larger than the dense
+*                representation.
+*   Parameters : first - first bit of the run, after the last set bit
+*                length - number of bits in the run
+*   Effects    : The bits in the run are set
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::AppendRun(const size_t first, const size_t length)
+{
+    bool joined;
+
+    if (length == 0)
+    {
+        return;
+    }
+
+    joined = (first > 0) && (*this)[first - 1];
+
+    if (m_Rep == BIT_REP_DENSE)
+    {
+        m_Dense->SetRange(first, length);
+    }
+    else
+    {
+        Convert(BIT_REP_RUNS);
+
+        if (joined)
+        {
+            m_Runs[m_RunCount - 1].length += length;
+        }
+        else
+        {
+            Reserve(m_RunCount + 1);
+            m_Runs[m_RunCount].first = first;
+            m_Runs[m_RunCount].length = length;
+        }
+    }
+
+    m_Count += length;
+    m_RunCount += joined ? 0 : 1;
+
+    if ((m_Rep == BIT_REP_RUNS) && (!Eligible(BIT_REP_RUNS) ||
+        (RepSize(BIT_REP_RUNS) > RepSize(BIT_REP_DENSE))))
+    {
+        Convert(BIT_REP_DENSE);
+    }
+}
+
+/***************************************************************************
+*   Method     : Take
+*   Description: This method replaces the contents of this array with the
+*                contents of another array of the same size, taking its
+*                storage instead of copying it.
+*   Parameters : src - array to take the contents of
+*   Effects    : This array holds the old contents of src.  src is
+*                cleared.
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::Take(adaptive_bit_array_c &src)
+{
+    FreeStorage();
+
+    m_Count = src.m_Count;
+    m_RunCount = src.m_RunCount;
+    m_Rep = src.m_Rep;
+    m_Dense = src.m_Dense;
+    m_Members = src.m_Members;
+    m_Runs = src.m_Runs;
+    m_Capacity = src.m_Capacity;
+
+    src.m_Dense = NULL;
+    src.m_Members = NULL;
+    src.m_Runs = NULL;
+    src.ClearAll();
+}
+
+/***************************************************************************
+*   Method     : Recount
+*   Description: This method recounts the set bits and runs of a dense
+*                array after it was changed by a bit_array_c operation.
+*   Parameters : None
+*   Effects    : Set bit and run counts are updated
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::Recount(void)
+{
+    m_Count = m_Dense->Count();
+    m_RunCount = CountRuns(*m_Dense);
+}
+
+/***************************************************************************
+*   Method     : Combine
+*   Description: This method merges the runs of this array and another
+*                array.  Between consecutive run boundaries of either array
+*                each bit has the same inputs, so the operation is applied
+*                once per stretch and the result is built a run at a time.
+*   Parameters : src - other array, the same size as this one
+*                op - run_op_t operation to apply
+*   Effects    : This array holds the result of the operation
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::Combine(const adaptive_bit_array_c &src,
+    const int op)
+{
+    adaptive_bit_array_c result(m_NumBits);
+    bit_run_t a, b;
+    bool haveA, haveB, inA, inB, out;
+    size_t pos, next;
+
+    haveA = NextRun(0, a);
+    haveB = (op != RUN_OP_NOT) && src.NextRun(0, b);
+    pos = 0;
+
+    while (pos < m_NumBits)
+    {
+        /* the stretch ends where either array's current run starts/ends */
+        inA = haveA && (a.first <= pos);
+        inB = haveB && (b.first <= pos);
+        next = m_NumBits;
+
+        if (haveA)
+        {
+            next = min(next, inA ? (a.first + a.length) : a.first);
+        }
+
+        if (haveB)
+        {
+            next = min(next, inB ? (b.first + b.length) : b.first);
+        }
+
+        switch (op)
+        {
+            case RUN_OP_AND:
+                out = inA && inB;
+                break;
+
+            case RUN_OP_OR:
+                out = inA || inB;
+                break;
+
+            case RUN_OP_XOR:
+                out = (inA != inB);
+                break;
+
+            case RUN_OP_NOT:
+            default:
+                out = !inA;
+                break;
+        }
+
+        if (out)
+        {
+            result.AppendRun(pos, next - pos);
+        }
+
+        pos = next;
+
+        if (inA && (pos == (a.first + a.length)))
+        {
+            haveA = NextRun(pos, a);
+        }
+
+        if (inB && (pos == (b.first + b.length)))
+        {
+            haveB = src.NextRun(pos, b);
+        }
+    }
+
+    result.Convert(result.Smallest());
+    Take(result);
+}
+
+/***************************************************************************
+*   Method     : SetAll
+*   Description: This method sets every bit in the array to 1.  The result
+*                is a single run.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 1.
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::SetAll(void)
+{
+    FreeStorage();
+
+    m_Rep = BIT_REP_RUNS;
+    m_Runs = new bit_run_t[1];
+    m_Runs[0].first = 0;
+    m_Runs[0].length = m_NumBits;
+    m_Capacity = 1;
+
+    m_Count = m_NumBits;
+    m_RunCount = 1;
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method sets every bit in the array to 0.  The result
+*                is an empty sorted list.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 0.
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::ClearAll(void)
+{
+    FreeStorage();
+
+    m_Rep = BIT_REP_SORTED;
+    m_Count = 0;
+    m_RunCount = 0;
+}
+
+/***************************************************************************
+*   Method     : SetBit
+*   Description: This method sets a bit in the array to 1.  The set bit and
+*                run counts are updated by looking at the neighboring bits,
+*                and the representation may change afterwards.
+*   Parameters : bit - the number of the bit to set
+*   Effects    : The specified bit will be set to 1.
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::SetBit(const size_t bit)
+{
+    bool left, right;
+    size_t i;
+
+    if ((m_NumBits <= bit) || (*this)[bit])
+    {
+        return;         /* bit out of range or already set */
+    }
+
+    left = (bit > 0) && (*this)[bit - 1];
+    right = ((bit + 1) < m_NumBits) && (*this)[bit + 1];
+
+    switch (m_Rep)
+    {
+        case BIT_REP_DENSE:
+            m_Dense->SetBit(bit);
+            break;
+
+        case BIT_REP_SORTED:
+            i = FindMember(bit);
+            Reserve(m_Count + 1);
+            memmove(&m_Members[i + 1], &m_Members[i],
+                (m_Count - i) * sizeof(size_t));
+            m_Members[i] = bit;
+            break;
+
+        case BIT_REP_RUNS:
+            i = FindRun(bit);
+
+            if (left && right)
+            {
+                /* bit joins run i - 1 and run i */
+                m_Runs[i - 1].length += 1 + m_Runs[i].length;
+                memmove(&m_Runs[i], &m_Runs[i + 1],
+                    (m_RunCount - i - 1) * sizeof(bit_run_t));
+            }
+            else if (left)
+            {
+                m_Runs[i - 1].length++;
+            }
+            else if (right)
+            {
+                m_Runs[i].first--;
+                m_Runs[i].length++;
+            }
+            else
+            {
+                Reserve(m_RunCount + 1);
+                memmove(&m_Runs[i + 1], &m_Runs[i],
+                    (m_RunCount - i) * sizeof(bit_run_t));
+                m_Runs[i].first = bit;
+                m_Runs[i].length = 1;
+            }
+            break;
+    }
+
+    m_Count++;
+    m_RunCount = m_RunCount + 1 - (left ? 1 : 0) - (right ? 1 : 0);
+
+    Adapt();
+}
+
+/***************************************************************************
+*   Method     : ClearBit
+*   Description: This method sets a bit in the array to 0.  The set bit and
+*                run counts are updated by looking at the neighboring bits,
+*                and the representation may change afterwards.
+*   Parameters : bit - the number of the bit to clear
+*   Effects    : The specified bit will be set to 0.
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::ClearBit(const size_t bit)
+{
+    bool left, right;
+    size_t i, last;
+
+    if ((m_NumBits <= bit) || !(*this)[bit])
+    {
+        return;         /* bit out of range or already clear */
+    }
+
+    left = (bit > 0) && (*this)[bit - 1];
+    right = ((bit + 1) < m_NumBits) && (*this)[bit + 1];
+
+    switch (m_Rep)
+    {
+        case BIT_REP_DENSE:
+            m_Dense->ClearBit(bit);
+            break;
+
+        case BIT_REP_SORTED:
+            i = FindMember(bit);
+            memmove(&m_Members[i], &m_Members[i + 1],
+                (m_Count - i - 1) * sizeof(size_t));
+            break;
+
+        case BIT_REP_RUNS:
+            i = FindRun(bit) - 1;       /* run containing bit */
+            last = m_Runs[i].first + m_Runs[i].length - 1;
+
+            if (left && right)
+            {
+                /* split the run in two */
+                Reserve(m_RunCount + 1);
+                memmove(&m_Runs[i + 2], &m_Runs[i + 1],
+                    (m_RunCount - i - 1) * sizeof(bit_run_t));
+                m_Runs[i + 1].first = bit + 1;
+                m_Runs[i + 1].length = last - bit;
+                m_Runs[i].length = bit - m_Runs[i].first;
+            }
+            else if (left)
+            {
+                m_Runs[i].length--;
+            }
+            else if (right)
+            {
+                m_Runs[i].first++;
+                m_Runs[i].length--;
+            }
+            else
+            {
+                memmove(&m_Runs[i], &m_Runs[i + 1],
+                    (m_RunCount - i - 1) * sizeof(bit_run_t));
+            }
+            break;
+    }
+
+    m_Count--;
+    m_RunCount = m_RunCount - 1 + (left ? 1 : 0) + (right ? 1 : 0);
+
+    Adapt();
+}
+
+/***************************************************************************
+*   Method     : operator()
+*   Description: Overload of the () operator.  This method approximates
+*                array indices used for assignment.  It returns an
+*                adaptive_bit_index_c which includes an = method used to
+*                set bit values, so the counts and representation are kept
+*                up to date.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : adaptive_bit_index_c (pointer to bit)
+***************************************************************************/
+adaptive_bit_index_c adaptive_bit_array_c::operator()(const size_t bit)
+{
+    return adaptive_bit_index_c(this, bit);
+}
+
+/***************************************************************************
+*   Method     : operator[]
+*   Description: Overload of the [] operator.  This method returns the
+*                value of a bit in the array.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : The value of the specified bit.  false if the bit is out
+*                of range.
+***************************************************************************/
+bool adaptive_bit_array_c::operator[](const size_t bit) const
+{
+    size_t i;
+
+    if (m_NumBits <= bit)
+    {
+        return false;
+    }
+
+    switch (m_Rep)
+    {
+        case BIT_REP_DENSE:
+            return (*m_Dense)[bit];
+
+        case BIT_REP_SORTED:
+            i = FindMember(bit);
+            return ((i < m_Count) && (m_Members[i] == bit));
+
+        case BIT_REP_RUNS:
+        default:
+            i = FindRun(bit);
+            return ((i > 0) &&
+                ((bit - m_Runs[i - 1].first) < m_Runs[i - 1].length));
+    }
+}
+
+/***************************************************************************
+*   Method     : NextSet
+*   Description: This method finds the first set bit at or after a given
+*                bit.
+*   Parameters : bit - index of the first bit to examine
+*   Effects    : None
+*   Returned   : Index of the first set bit at or after bit.  Size() if
+*                there isn't one.
+***************************************************************************/
+size_t adaptive_bit_array_c::NextSet(const size_t bit) const
+{
+    bit_run_t run;
+
+    return NextRun(bit, run) ? run.first : m_NumBits;
+}
+
+/***************************************************************************
+*   Method     : NextClear
+*   Description: This method finds the first clear bit at or after a given
+*                bit.  If bit is set, that is the end of the run holding
+*                it.
+*   Parameters : bit - index of the first bit to examine
+*   Effects    : None
+*   Returned   : Index of the first clear bit at or after bit.  Size() if
+*                there isn't one.
+***************************************************************************/
+size_t adaptive_bit_array_c::NextClear(const size_t bit) const
+{
+    bit_run_t run;
+
+    if (m_NumBits <= bit)
+    {
+        return m_NumBits;
+    }
+
+    if (NextRun(bit, run) && (run.first == bit))
+    {
+        return run.first + run.length;
+    }
+
+    return bit;
+}
+
+/***************************************************************************
+*   Method     : Intersects
+*   Description: This method determines if this array and another array
+*                have any set bits in common.  The runs of both arrays are
+*                walked together, advancing whichever run ends first.
+*   Parameters : other - array to compare
+*   Effects    : None
+*   Returned   : True if a bit is set in both arrays.  False if it isn't or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool adaptive_bit_array_c::Intersects(const adaptive_bit_array_c &other)
+    const
+{
+    bit_run_t a, b;
+    bool haveA, haveB;
+
+    if (m_NumBits != other.m_NumBits)
+    {
+        /* unequal sizes */
+        return false;
+    }
+
+    if ((m_Rep == BIT_REP_DENSE) && (other.m_Rep == BIT_REP_DENSE))
+    {
+        return m_Dense->Intersects(*other.m_Dense);
+    }
+
+    haveA = NextRun(0, a);
+    haveB = other.NextRun(0, b);
+
+    while (haveA && haveB)
+    {
+        if ((a.first < (b.first + b.length)) &&
+            (b.first < (a.first + a.length)))
+        {
+            return true;
+        }
+
+        if ((a.first + a.length) < (b.first + b.length))
+        {
+            haveA = NextRun(b.first, a);
+        }
+        else
+        {
+            haveB = other.NextRun(a.first, b);
+        }
+    }
+
+    return false;
+}
+
+/***************************************************************************
+*   Method     : IsDisjoint
+*   Description: This method determines if this array and another array
+*                have no set bits in common.
+*   Parameters : other - array to compare
+*   Effects    : None
+*   Returned   : True if no bit is set in both arrays.  False if one is or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool adaptive_bit_array_c::IsDisjoint(const adaptive_bit_array_c &other)
+    const
+{
+    if (m_NumBits != other.m_NumBits)
+    {
+        /* unequal sizes */
+        return false;
+    }
+
+    return !Intersects(other);
+}
+
+/***************************************************************************
+*   Method     : IsSubsetOf
+*   Description: This method determines if every bit set in this array is
+*                also set in another array, by checking that each of this
+*                array's runs lies inside a run of the other array.
+*   Parameters : other - array to compare
+*   Effects    : None
+*   Returned   : True if this is a subset of other.  False if it isn't or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool adaptive_bit_array_c::IsSubsetOf(const adaptive_bit_array_c &other)
+    const
+{
+    bit_run_t run;
+    size_t bit;
+
+    if (m_NumBits != other.m_NumBits)
+    {
+        /* unequal sizes */
+        return false;
+    }
+
+    if ((m_Rep == BIT_REP_DENSE) && (other.m_Rep == BIT_REP_DENSE))
+    {
+        return m_Dense->IsSubsetOf(*other.m_Dense);
+    }
+
+    if (m_Count > other.m_Count)
+    {
+        return false;
+    }
+
+    bit = 0;
+    while (NextRun(bit, run))
+    {
+        bit = run.first + run.length;
+
+        if (other.NextClear(run.first) < bit)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/***************************************************************************
+*   Method     : IsSupersetOf
+*   Description: This method determines if every bit set in another array
+*                is also set in this array.
+*   Parameters : other - array to compare
+*   Effects    : None
+*   Returned   : True if this is a superset of other.  False if it isn't or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool adaptive_bit_array_c::IsSupersetOf(const adaptive_bit_array_c &other)
+    const
+{
+    return other.IsSubsetOf(*this);
+}
+
+/***************************************************************************
+*   Method     : ContainsAll
+*   Description: This method determines if every bit in a list of bit
+*                indices is set.
+*   Parameters : indices - array of bit indices to test
+*                count - number of indices in the array
+*   Effects    : None
+*   Returned   : True if every listed bit is set.  False if any listed bit
+*                is clear or out of range.
+***************************************************************************/
+bool adaptive_bit_array_c::ContainsAll(const size_t *indices,
+    const size_t count) const
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!(*this)[indices[i]])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/***************************************************************************
+*   Method     : ToIndices
+*   Description: This method writes the index of every set bit into an
+*                array in ascending order.
+*   Parameters : indices - array receiving bit indices
+*                maxCount - number of entries that fit in indices
+*   Effects    : Up to maxCount indices are written to indices.
+*   Returned   : Number of indices written
+***************************************************************************/
+size_t adaptive_bit_array_c::ToIndices(size_t *indices,
+    const size_t maxCount) const
+{
+    size_t written;
+
+    switch (m_Rep)
+    {
+        case BIT_REP_DENSE:
+            return m_Dense->ToIndices(indices, maxCount);
+
+        case BIT_REP_SORTED:
+            written = min(m_Count, maxCount);
+            copy(m_Members, m_Members + written, indices);
+            return written;
+
+        case BIT_REP_RUNS:
+        default:
+            written = 0;
+
+            for (size_t i = 0; i < m_RunCount; i++)
+            {
+                for (size_t j = 0; j < m_Runs[i].length; j++)
+                {
+                    if (written == maxCount)
+                    {
+                        return written;
+                    }
+
+                    indices[written] = m_Runs[i].first + j;
+                    written++;
+                }
+            }
+
+            return written;
+    }
+}
+
+/***************************************************************************
+*   Method     : ToBitArray
+*   Description: This method copies the contents of this array into a
+*                bit_array_c of the same size.
+*   Parameters : dest - bit array receiving the contents
+*   Effects    : dest holds a copy of this array.  Nothing is done if the
+*                sizes differ.
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_array_c::ToBitArray(bit_array_c &dest) const
+{
+    if (dest.Size() != m_NumBits)
+    {
+        /* don't do assignment with different array sizes */
+        return;
+    }
+
+    switch (m_Rep)
+    {
+        case BIT_REP_DENSE:
+            dest = *m_Dense;
+            break;
+
+        case BIT_REP_SORTED:
+            dest.ClearAll();
+            dest.FromIndices(m_Members, m_Count, true);
+            break;
+
+        case BIT_REP_RUNS:
+            dest.ClearAll();
+
+            for (size_t i = 0; i < m_RunCount; i++)
+            {
+                dest.SetRange(m_Runs[i].first, m_Runs[i].length);
+            }
+            break;
+    }
+}
+
+/***************************************************************************
+*   Method     : operator&=
+*   Description: overload of the &= operator.  Performs a bitwise and
+*                between the source array and this array.  Two dense
+*                arrays are anded a word at a time, otherwise the runs of
+*                the arrays are merged.
+*   Parameters : src - Source array
+*   Effects    : Results of bitwise and are stored in this array
+*   Returned   : Reference to this array after and
+***************************************************************************/
+adaptive_bit_array_c& adaptive_bit_array_c::operator&=(
+    const adaptive_bit_array_c &src)
+{
+    if (m_NumBits != src.m_NumBits)
+    {
+        /* don't do assignment with different array sizes */
+        return *this;
+    }
+
+    if ((m_Rep == BIT_REP_DENSE) && (src.m_Rep == BIT_REP_DENSE))
+    {
+        *m_Dense &= *src.m_Dense;
+        Recount();
+        Adapt();
+    }
+    else
+    {
+        Combine(src, RUN_OP_AND);
+    }
+
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : operator^=
+*   Description: overload of the ^= operator.  Performs a bitwise xor
+*                between the source array and this array.  Two dense
+*                arrays are xored a word at a time, otherwise the runs of
+*                the arrays are merged.
+*   Parameters : src - Source array
+*   Effects    : Results of bitwise xor are stored in this array
+*   Returned   : Reference to this array after xor
+***************************************************************************/
+adaptive_bit_array_c& adaptive_bit_array_c::operator^=(
+    const adaptive_bit_array_c &src)
+{
+    if (m_NumBits != src.m_NumBits)
+    {
+        /* don't do assignment with different array sizes */
+        return *this;
+    }
+
+    if ((m_Rep == BIT_REP_DENSE) && (src.m_Rep == BIT_REP_DENSE))
+    {
+        *m_Dense ^= *src.m_Dense;
+        Recount();
+        Adapt();
+    }
+    else
+    {
+        Combine(src, RUN_OP_XOR);
+    }
+
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : operator|=
+*   Description: overload of the |= operator.  Performs a bitwise or
+*                between the source array and this array.  Two dense
+*                arrays are ored a word at a time, otherwise the runs of
+*                the arrays are merged.
+*   Parameters : src - Source array
+*   Effects    : Results of bitwise or are stored in this array
+*   Returned   : Reference to this array after or
+***************************************************************************/
+adaptive_bit_array_c& adaptive_bit_array_c::operator|=(
+    const adaptive_bit_array_c &src)
+{
+    if (m_NumBits != src.m_NumBits)
+    {
+        /* don't do assignment with different array sizes */
+        return *this;
+    }
+
+    if ((m_Rep == BIT_REP_DENSE) && (src.m_Rep == BIT_REP_DENSE))
+    {
+        *m_Dense |= *src.m_Dense;
+        Recount();
+        Adapt();
+    }
+    else
+    {
+        Combine(src, RUN_OP_OR);
+    }
+
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : Not
+*   Description: Negates all bits in the array.  A dense array is negated a
+*                word at a time, otherwise the gaps between runs become the
+*                new runs.
+*   Parameters : None
+*   Effects    : Contents of the array are negated.
+*   Returned   : Reference to this array after not
+***************************************************************************/
+adaptive_bit_array_c& adaptive_bit_array_c::Not(void)
+{
+    if (m_Rep == BIT_REP_DENSE)
+    {
+        m_Dense->Not();
+        Recount();
+        Adapt();
+    }
+    else
+    {
+        Combine(*this, RUN_OP_NOT);
+    }
+
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : operator<<=
+*   Description: overload of the <<= operator.  Performs a left shift on
+*                this array, moving each bit to a lower index like
+*                bit_array_c.  A dense array is shifted a word at a time,
+*                otherwise each run is moved, dropping the bits shifted
+*                off.
+*   Parameters : shifts - number of bit positions to shift
+*   Effects    : Results of the shifts are stored in this array
+*   Returned   : Reference to this array after shift
+***************************************************************************/
+adaptive_bit_array_c& adaptive_bit_array_c::operator<<=(const size_t shifts)
+{
+    adaptive_bit_array_c result(m_NumBits);
+    bit_run_t run;
+    size_t bit;
+
+    if (shifts >= m_NumBits)
+    {
+        /* all bits have been shifted off */
+        ClearAll();
+        return *this;
+    }
+
+    if (m_Rep == BIT_REP_DENSE)
+    {
+        *m_Dense <<= shifts;
+        Recount();
+        Adapt();
+        return *this;
+    }
+
+    bit = shifts;
+    while (NextRun(bit, run))
+    {
+        result.AppendRun(run.first - shifts, run.length);
+        bit = run.first + run.length;
+    }
+
+    result.Convert(result.Smallest());
+    Take(result);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : operator>>=
+*   Description: overload of the >>= operator.  Performs a right shift on
+*                this array, moving each bit to a higher index like
+*                bit_array_c.  A dense array is shifted a word at a time,
+*                otherwise each run is moved, dropping the bits shifted
+*                off.
+*   Parameters : shifts - number of bit positions to shift
+*   Effects    : Results of the shifts are stored in this array
+*   Returned   : Reference to this array after shift
+***************************************************************************/
+adaptive_bit_array_c& adaptive_bit_array_c::operator>>=(const size_t shifts)
+{
+    adaptive_bit_array_c result(m_NumBits);
+    bit_run_t run;
+    size_t bit;
+
+    if (shifts >= m_NumBits)
+    {
+        /* all bits have been shifted off */
+        ClearAll();
+        return *this;
+    }
+
+    if (m_Rep == BIT_REP_DENSE)
+    {
+        *m_Dense >>= shifts;
+        Recount();
+        Adapt();
+        return *this;
+    }
+
+    bit = 0;
+    while (NextRun(bit, run) && (run.first < (m_NumBits - shifts)))
+    {
+        result.AppendRun(run.first + shifts,
+            min(run.length, m_NumBits - shifts - run.first));
+        bit = run.first + run.length;
+    }
+
+    result.Convert(result.Smallest());
+    Take(result);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : adaptive_bit_index_c - constructor
+*   Description: This is the adaptive_bit_index_c constructor.  It stores a
+*                pointer to the adaptive array and the bit index.
+*   Parameters : array - pointer to adaptive array
+*                index - index of bit in array
+*   Effects    : Pointer to adaptive array and bit index are stored.
+*   Returned   : None
+***************************************************************************/
+adaptive_bit_index_c::adaptive_bit_index_c(adaptive_bit_array_c *array,
+    const size_t index):
+    m_BitArray(array),
+    m_Index(index)
+{
+}
+
+/***************************************************************************
+*   Method     : operator=
+*   Description: overload of the = operator.  Sets the array bit to the
+*                value of src.
+*   Parameters : src - bit value
+*   Effects    : Bit pointed to by this object is set to the value of
+*                source.
+*   Returned   : None
+***************************************************************************/
+void adaptive_bit_index_c::operator=(const bool src)
+{
+    if (src)
+    {
+        m_BitArray->SetBit(m_Index);
+    }
+    else
+    {
+        m_BitArray->ClearBit(m_Index);
+    }
+}
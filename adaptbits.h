@@ -0,0 +1,159 @@
+/***************************************************************************
+*                   Adaptive Arrays of Arbitrary Bit Length
+*
+*   File    : adaptbits.h
+*   Purpose : Header file for a class implementing arbitrary length arrays
+*             of bits that switch between dense, sorted list and run
+*             length representations as their contents change.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef ADAPT_BITS_H
+#define ADAPT_BITS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* ways the bits may be stored */
+typedef enum
+{
+    BIT_REP_DENSE,                      /* bit_array_c */
+    BIT_REP_SORTED,                     /* sorted list of set bits */
+    BIT_REP_RUNS                        /* sorted list of runs of set bits */
+} bit_rep_t;
+
+/* a run of consecutive set bits */
+typedef struct
+{
+    size_t first;                       /* first set bit in run */
+    size_t length;                      /* number of set bits in run */
+} bit_run_t;
+
+class adaptive_bit_array_c;
+
+class adaptive_bit_index_c
+{
+    public:
+        adaptive_bit_index_c(adaptive_bit_array_c *array,
+            const size_t index);
+
+        /* assignment */
+        void operator=(const bool src);
+
+    private:
+        adaptive_bit_array_c *m_BitArray;       /* array index applies to */
+        size_t m_Index;                         /* index of bit in array */
+};
+
+class adaptive_bit_array_c
+{
+    public:
+        adaptive_bit_array_c(const size_t numBits);
+        virtual ~adaptive_bit_array_c(void);
+
+        size_t Size() const { return m_NumBits; };
+        size_t Count() const { return m_Count; };
+        size_t Runs() const { return m_RunCount; };
+        bit_rep_t Representation() const { return m_Rep; };
+        size_t StorageSize(void) const;
+
+        /* set/clear functions */
+        void SetAll(void);
+        void ClearAll(void);
+        void SetBit(const size_t bit);
+        void ClearBit(const size_t bit);
+
+        adaptive_bit_index_c operator()(const size_t bit);
+
+        /* boolean operator */
+        bool operator[](const size_t bit) const;
+
+        bool Any(void) const { return (m_Count != 0); };
+        bool None(void) const { return (m_Count == 0); };
+        bool All(void) const { return (m_Count == m_NumBits); };
+
+        size_t NextSet(const size_t bit) const;
+        size_t NextClear(const size_t bit) const;
+
+        /* set relations */
+        bool Intersects(const adaptive_bit_array_c &other) const;
+        bool IsDisjoint(const adaptive_bit_array_c &other) const;
+        bool IsSubsetOf(const adaptive_bit_array_c &other) const;
+        bool IsSupersetOf(const adaptive_bit_array_c &other) const;
+        bool ContainsAll(const size_t *indices, const size_t count) const;
+
+        /* conversions */
+        size_t ToIndices(size_t *indices,
+            const size_t maxCount) const;
+        void ToBitArray(bit_array_c &dest) const;
+
+        /* assignments, lists and runs are merged a run at a time */
+        adaptive_bit_array_c& operator&=(const adaptive_bit_array_c &src);
+        adaptive_bit_array_c& operator^=(const adaptive_bit_array_c &src);
+        adaptive_bit_array_c& operator|=(const adaptive_bit_array_c &src);
+        adaptive_bit_array_c& Not(void);        /* negate (~=) */
+
+        adaptive_bit_array_c& operator<<=(const size_t shifts);
+        adaptive_bit_array_c& operator>>=(const size_t shifts);
+
+    private:
+        /* adaptive arrays can't be copied */
+        adaptive_bit_array_c(const adaptive_bit_array_c &);
+        adaptive_bit_array_c& operator=(const adaptive_bit_array_c &);
+
+        size_t RepSize(const bit_rep_t rep) const;
+        bool Eligible(const bit_rep_t rep) const;
+        bit_rep_t Smallest(void) const;
+        void Adapt(void);
+        void Convert(const bit_rep_t rep);
+        void FreeStorage(void);
+        size_t FindMember(const size_t bit) const;
+        size_t FindRun(const size_t bit) const;
+        void Reserve(const size_t entries);
+
+        bool NextRun(const size_t bit, bit_run_t &run) const;
+        void AppendRun(const size_t first, const size_t length);
+        void Take(adaptive_bit_array_c &src);
+        void Recount(void);
+        void Combine(const adaptive_bit_array_c &src, const int op);
+
+        size_t m_NumBits;               /* number of bits in the array */
+        size_t m_Count;                 /* number of set bits */
+        size_t m_RunCount;              /* number of runs of set bits */
+        bit_rep_t m_Rep;                /* current representation */
+
+        bit_array_c *m_Dense;           /* BIT_REP_DENSE storage */
+        size_t *m_Members;              /* BIT_REP_SORTED storage */
+        bit_run_t *m_Runs;              /* BIT_REP_RUNS storage */
+        size_t m_Capacity;              /* entries allocated in list */
+};
+
+#endif  /* ndef ADAPT_BITS_H */
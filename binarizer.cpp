@@ -0,0 +1,318 @@
+/***************************************************************************
+*                       Random Projection Binarizer
+*
+*   File    : binarizer.cpp
+*   Purpose : Provides a class that encodes float vectors (for example
+*             embeddings) as codes made of the signs of random projections
+*             (Charikar's random hyperplane hash).  Bit j of a vector's
+*             code is 1 if the dot product of the vector with random
+*             Gaussian vector j is positive.  The fraction of bits that
+*             differ in two codes estimates the angle between the
+*             vectors divided by pi, so codes can be searched by Hamming
+*             distance.
+*
+*             Encoding a batch of vectors is the matrix product of the
+*             vectors and the projections followed by a sign test, so it
+*             is written like a blocked SGEMM.  The projections are stored
+*             in panels of 8, one panel per byte of code: panel p holds
+*             projections 8p to 8p + 7 interleaved, so its floats for
+*             input dimension k are the 8 consecutive floats at
+*             (p * inputDims + k) * 8.  The kernel computes one code byte
+*             for ROW_TILE vectors at once, keeping ROW_TILE x 8 sums in
+*             registers; its inner loop multiplies one input float by the
+*             8 floats of a panel row, which compilers vectorize.  Blocks
+*             of ROW_BLOCK vectors and PANEL_BLOCK panels are processed
+*             together so that both stay in cache while they are reused.
+*
+*             The 8 sums of a code byte are turned into the byte by sign
+*             tests and stored directly in the bit array.  Codes must be a
+*             whole number of bytes, so a batch split among threads never
+*             has two threads writing the same byte.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "binarizer.h"
+#include "bitrand.h"
+#include "parallel.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* projections in a panel, one code byte */
+#define PANEL_WIDTH           CHAR_BIT
+
+/* vectors handled by one call to the kernel */
+#define ROW_TILE              4
+
+/* vectors and panels handled together to stay in cache */
+#define ROW_BLOCK             64
+#define PANEL_BLOCK           8
+
+#ifndef M_PI
+#define M_PI                  3.14159265358979323846
+#endif
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : EncodeTile
+*   Description: This function computes one code byte of ROW_TILE vectors
+*                from one panel of projections.
+*   Parameters : rows - array of ROW_TILE pointers to vectors (repeated
+*                    pointers are allowed)
+*                panel - interleaved projections of the panel
+*                inputDims - floats in each vector
+*                bytes - array of ROW_TILE unsigned chars receiving the
+*                    code byte of each vector
+*   Effects    : bytes are written
+*   Returned   : None
+***************************************************************************/
+static void EncodeTile(const float *const *rows, const float *panel,
+    const size_t inputDims, unsigned char *bytes)
+{
+    float sums[ROW_TILE][PANEL_WIDTH];
+
+    for (int r = 0; r < ROW_TILE; r++)
+    {
+        for (int j = 0; j < PANEL_WIDTH; j++)
+        {
+            sums[r][j] = 0.0f;
+        }
+    }
+
+    for (size_t k = 0; k < inputDims; k++)
+    {
+        const float *projections = &panel[k * PANEL_WIDTH];
+
+        for (int r = 0; r < ROW_TILE; r++)
+        {
+            const float x = rows[r][k];
+
+            for (int j = 0; j < PANEL_WIDTH; j++)
+            {
+                sums[r][j] += x * projections[j];
+            }
+        }
+    }
+
+    for (int r = 0; r < ROW_TILE; r++)
+    {
+        unsigned char value = 0;
+
+        for (int j = 0; j < PANEL_WIDTH; j++)
+        {
+            value |= (unsigned char)((sums[r][j] > 0.0f) <<
+                (PANEL_WIDTH - 1 - j));
+        }
+
+        bytes[r] = value;
+    }
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : binarizer_c - constructor
+*   Description: This is the binarizer_c constructor.  It draws the random
+*                projections.  Codes can only be compared if they were
+*                built with the same sizes and seed.
+*   Parameters : inputDims - floats in an input vector
+*                codeBits - bits in a code (a multiple of 8)
+*                seed - seed for the random projections
+*   Effects    : Projections are generated
+*   Returned   : None
+***************************************************************************/
+binarizer_c::binarizer_c(const size_t inputDims, const size_t codeBits,
+    const uint64_t seed):
+    m_InputDims(inputDims),
+    m_CodeBits(codeBits)
+{
+    bit_random_c rng(seed);
+    size_t panels;
+
+    if ((codeBits == 0) || ((codeBits % CHAR_BIT) != 0))
+    {
+        throw invalid_argument(
+            "Error: Binarizer code must be a whole number of bytes.");
+    }
+
+    if (inputDims == 0)
+    {
+        throw invalid_argument(
+            "Error: Binarizer input must have at least 1 dimension.");
+    }
+
+    panels = codeBits / PANEL_WIDTH;
+    m_Panels.resize(panels * inputDims * PANEL_WIDTH);
+
+    /* projection j is row j; draw it one row at a time */
+    for (size_t j = 0; j < codeBits; j++)
+    {
+        float *panel = &m_Panels[(j / PANEL_WIDTH) * inputDims * PANEL_WIDTH];
+
+        for (size_t k = 0; k < inputDims; k++)
+        {
+            double u1, u2;
+
+            /* Box-Muller transform of two uniform values */
+            u1 = 1.0 - rng.NextDouble();        /* (0, 1] */
+            u2 = rng.NextDouble();
+            panel[(k * PANEL_WIDTH) + (j % PANEL_WIDTH)] =
+                (float)(sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2));
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : ~binarizer_c - destructor
+*   Description: This is the binarizer_c destructor.  At this point it's
+*                just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+binarizer_c::~binarizer_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : EncodeRows
+*   Description: This method encodes consecutive vectors into consecutive
+*                codes, a block of vectors and panels at a time.
+*   Parameters : vectors - count rows of m_InputDims floats
+*                count - number of vectors
+*                chars - array receiving count codes of m_CodeBits / 8
+*                    unsigned chars
+*   Effects    : Codes are written to chars
+*   Returned   : None
+***************************************************************************/
+void binarizer_c::EncodeRows(const float *vectors, const size_t count,
+    unsigned char *chars) const
+{
+    const size_t codeChars = m_CodeBits / CHAR_BIT;
+    const float *rows[ROW_TILE];
+    unsigned char bytes[ROW_TILE];
+
+    for (size_t rowBlock = 0; rowBlock < count; rowBlock += ROW_BLOCK)
+    {
+        size_t rowEnd = min(count, rowBlock + ROW_BLOCK);
+
+        for (size_t panelBlock = 0; panelBlock < codeChars;
+            panelBlock += PANEL_BLOCK)
+        {
+            size_t panelEnd = min(codeChars, panelBlock + PANEL_BLOCK);
+
+            for (size_t row = rowBlock; row < rowEnd; row += ROW_TILE)
+            {
+                size_t tileRows = min((size_t)ROW_TILE, rowEnd - row);
+
+                /* a short tile repeats its first vector */
+                for (size_t r = 0; r < ROW_TILE; r++)
+                {
+                    rows[r] = &vectors[(row + ((r < tileRows) ? r : 0)) *
+                        m_InputDims];
+                }
+
+                for (size_t p = panelBlock; p < panelEnd; p++)
+                {
+                    EncodeTile(rows,
+                        &m_Panels[p * m_InputDims * PANEL_WIDTH],
+                        m_InputDims, bytes);
+
+                    for (size_t r = 0; r < tileRows; r++)
+                    {
+                        chars[((row + r) * codeChars) + p] = bytes[r];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : Encode
+*   Description: This method encodes one vector and stores its code in a
+*                bit array.  A code that doesn't fit in the array is not
+*                written.
+*   Parameters : input - m_InputDims floats
+*                codes - array receiving the code
+*                index - position of the code in codes
+*   Effects    : Code index of codes is replaced
+*   Returned   : None
+***************************************************************************/
+void binarizer_c::Encode(const float *input, bit_array_c &codes,
+    const size_t index) const
+{
+    if (codes.Size() / m_CodeBits <= index)
+    {
+        return;         /* code out of range */
+    }
+
+    EncodeRows(input, 1,
+        &codes.Chars()[(index * m_CodeBits) / CHAR_BIT]);
+}
+
+/***************************************************************************
+*   Method     : EncodeBatch
+*   Description: This method encodes a list of vectors, splitting them
+*                among threads.  Codes that don't fit in the array are not
+*                written.
+*   Parameters : vectors - count rows of m_InputDims floats
+*                count - number of vectors
+*                codes - array receiving code i of vector i
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : Codes 0 to count - 1 of codes are replaced
+*   Returned   : None
+***************************************************************************/
+void binarizer_c::EncodeBatch(const float *vectors, const size_t count,
+    bit_array_c &codes, const unsigned int numThreads) const
+{
+    size_t fit;
+
+    fit = min(count, codes.Size() / m_CodeBits);
+
+    ParallelFor(fit, numThreads,
+        [&](size_t begin, size_t end)
+        {
+            EncodeRows(&vectors[begin * m_InputDims], end - begin,
+                &codes.Chars()[(begin * m_CodeBits) / CHAR_BIT]);
+        });
+}
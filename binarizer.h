@@ -0,0 +1,75 @@
+/***************************************************************************
+*                       Random Projection Binarizer
+*
+*   File    : binarizer.h
+*   Purpose : Header file for a class that encodes float vectors as bit
+*             arrays of the signs of random projections.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef BINARIZER_H
+#define BINARIZER_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <vector>
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class binarizer_c
+{
+    public:
+        binarizer_c(const size_t inputDims, const size_t codeBits,
+            const uint64_t seed);
+        virtual ~binarizer_c(void);
+
+        size_t InputDims() const { return m_InputDims; };
+        size_t CodeBits() const { return m_CodeBits; };
+
+        /* code index of an array holds bits [index * CodeBits(),
+         * (index + 1) * CodeBits()) */
+        void Encode(const float *input, bit_array_c &codes,
+            const size_t index) const;
+
+        /* vectors is count rows of InputDims() floats */
+        void EncodeBatch(const float *vectors, const size_t count,
+            bit_array_c &codes, const unsigned int numThreads) const;
+
+    private:
+        void EncodeRows(const float *vectors, const size_t count,
+            unsigned char *chars) const;
+
+        size_t m_InputDims;             /* floats in an input vector */
+        size_t m_CodeBits;              /* bits in a code */
+
+        /* projections in panels of 8, see binarizer.cpp */
+        std::vector<float> m_Panels;
+};
+
+#endif  /* ndef BINARIZER_H */
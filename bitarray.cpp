@@ -83,8 +83,24 @@
 ***************************************************************************/
 #include <iostream>
 #include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include <stdint.h>
 #include "bitarray.h"
+#include "bitrand.h"
+#include "bitwords.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define BIT_ARRAY_USE_MMAP
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
 
 using namespace std;
 
@@ -104,206 +120,2077 @@ using namespace std;
 /* position of bit within character */
 #define BIT_IN_CHAR(bit)      (1 << (CHAR_BIT - 1 - ((bit)  % CHAR_BIT)))
 
-/* number of characters required to contain number of bits */
-#define BITS_TO_CHARS(bits)   ((((bits) - 1) / CHAR_BIT) + 1)
-
 /* most significant bit in a character */
 #define MS_BIT                (1 << (CHAR_BIT - 1))
 
+/* bits of precision used for FillRandom densities */
+#define DENSITY_BITS          16
+
+/* serialized arrays start with a magic number, version and bit count */
+#define SERIAL_MAGIC          "BITA"
+#define SERIAL_VERSION        1
+#define SERIAL_HEADER_CHARS   13
+
+/* arrays at least this many bytes get their own anonymous mapping */
+#define MMAP_BYTES            ((size_t)1 << 22)
+
+/* operands shorter than this many limbs use schoolbook multiplication */
+#define KARATSUBA_LIMBS       32
+
+/* decimal conversions work with DECIMAL_LIMB_DIGITS digits per limb */
+#define DECIMAL_LIMB          1000000000
+#define DECIMAL_LIMB_DIGITS   9
+
+/* values this many limbs or shorter are converted without splitting */
+#define DECIMAL_BASE_LIMBS    32
+
 /***************************************************************************
-*                                 METHODS
+*                            TYPE DEFINITIONS
 ***************************************************************************/
 
+/* 32 bit limbs of an unsigned integer, least significant first */
+typedef vector<uint32_t> bit_limbs_t;
+
+/* operations applied by CombineBits */
+typedef enum
+{
+    BIT_OP_AND,
+    BIT_OP_OR,
+    BIT_OP_XOR
+} bit_op_t;
+
 /***************************************************************************
-*   Method     : bit_array_c - constructor
-*   Description: This is the bit_array_c constructor.  It reserves memory
-*                for the vector storing the array.
-*   Parameters : numBits - number of bits in the array
-*   Effects    : Allocates vectory for array bits
+* Lookup table with the number of set bits in each possible unsigned char
+* value, and the positions (0 is the MSB) of those bits in ascending order.
+* It allows set bits to be decoded a character at a time instead of one
+* bit at a time.
+***************************************************************************/
+class bit_decode_table_c
+{
+    public:
+        bit_decode_table_c(void);
+
+        unsigned char count[UCHAR_MAX + 1];
+        unsigned char position[UCHAR_MAX + 1][CHAR_BIT];
+};
+
+/***************************************************************************
+*                                FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : DecodeTable
+*   Description: This function returns the table used to decode the bits
+*                in an unsigned char.  The table is built the first time
+*                that it is requested.
+*   Parameters : None
+*   Effects    : Builds the decode table on the first call
+*   Returned   : Reference to the decode table
+***************************************************************************/
+static const bit_decode_table_c &DecodeTable(void)
+{
+    static const bit_decode_table_c table;
+    return table;
+}
+
+/***************************************************************************
+*   Function   : LoadBits
+*   Description: This function returns the 64 bits of an array of unsigned
+*                chars that start at a given bit, with the first bit in the
+*                most significant position.  The bits don't need to be
+*                aligned; they are shifted into place on the fly.  Bits
+*                beyond the end of the array are returned as 0.
+*   Parameters : chars - array of unsigned chars
+*                numChars - number of unsigned chars in the array
+*                bit - index of the first bit to load
+*   Effects    : None
+*   Returned   : Word containing 64 bits starting at bit
+***************************************************************************/
+static inline uint64_t LoadBits(const unsigned char *chars,
+    const size_t numChars, const size_t bit)
+{
+    size_t first;
+    int shift;
+    uint64_t word;
+    unsigned char next;
+
+    first = BIT_CHAR(bit);
+    shift = bit % CHAR_BIT;
+
+    if ((first + WORD_CHARS) < numChars)
+    {
+        /* every char that's needed is in the array */
+        word = LoadBigEndian(&chars[first]);
+        next = chars[first + WORD_CHARS];
+    }
+    else
+    {
+        /* near the end of the array, pad with zeros */
+        word = 0;
+        for (size_t i = 0; i < WORD_CHARS; i++)
+        {
+            word <<= CHAR_BIT;
+
+            if ((first + i) < numChars)
+            {
+                word |= chars[first + i];
+            }
+        }
+
+        next = 0;
+    }
+
+    if (shift != 0)
+    {
+        word = (word << shift) | (next >> (CHAR_BIT - shift));
+    }
+
+    return word;
+}
+
+/***************************************************************************
+*   Function   : CombineWord
+*   Description: This function applies a bitwise operation to two words.
+*   Parameters : a - first operand
+*                b - second operand
+*                op - operation to apply
+*   Effects    : None
+*   Returned   : a op b
+***************************************************************************/
+static inline uint64_t CombineWord(const uint64_t a, const uint64_t b,
+    const bit_op_t op)
+{
+    switch (op)
+    {
+        case BIT_OP_AND:
+            return a & b;
+
+        case BIT_OP_OR:
+            return a | b;
+
+        default:
+            return a ^ b;
+    }
+}
+
+/***************************************************************************
+*   Function   : CombineBit
+*   Description: This function applies a bitwise operation between one
+*                destination bit and one source bit.
+*   Parameters : dest - array of unsigned chars receiving the result
+*                destBit - index of the destination bit
+*                src - array of unsigned chars with the source bit
+*                srcBit - index of the source bit
+*                op - operation to apply
+*   Effects    : Bit destBit of dest becomes dest op src
 *   Returned   : None
 ***************************************************************************/
-bit_array_c::bit_array_c(const int numBits):
-    m_NumBits(numBits)
+static inline void CombineBit(unsigned char *dest, const size_t destBit,
+    const unsigned char *src, const size_t srcBit, const bit_op_t op)
 {
-    int numBytes;
+    unsigned char mask, value;
 
-    if (numBits < 1)
+    mask = BIT_IN_CHAR(destBit);
+    value = ((src[BIT_CHAR(srcBit)] & BIT_IN_CHAR(srcBit)) != 0) ? mask : 0;
+    value = (unsigned char)CombineWord(dest[BIT_CHAR(destBit)], value, op);
+    dest[BIT_CHAR(destBit)] = (dest[BIT_CHAR(destBit)] & ~mask) |
+        (value & mask);
+}
+
+/***************************************************************************
+*   Function   : CombineBits
+*   Description: This function applies a bitwise operation between a range
+*                of destination bits and a range of source bits of the same
+*                length, storing the result in the destination.  The ranges
+*                don't need to be aligned with each other; source bits are
+*                shifted into place a word at a time.
+*   Parameters : dest - array of unsigned chars receiving the result
+*                destPos - index of the first destination bit
+*                src - array of unsigned chars with the source bits
+*                srcChars - number of unsigned chars in src
+*                srcPos - index of the first source bit
+*                length - number of bits in each range
+*                op - operation to apply
+*   Effects    : length bits of dest starting at destPos become
+*                dest op src.  Other bits of dest are unchanged.
+*   Returned   : None
+***************************************************************************/
+static void CombineBits(unsigned char *dest, const size_t destPos,
+    const unsigned char *src, const size_t srcChars, const size_t srcPos,
+    const size_t length, const bit_op_t op)
+{
+    size_t done;
+    uint64_t word;
+
+    done = 0;
+
+    /* bits up to a character boundary in dest */
+    while ((done < length) && (((destPos + done) % CHAR_BIT) != 0))
     {
-        throw invalid_argument("Error: Bit Array must have at least 1 bit.");
+        CombineBit(dest, destPos + done, src, srcPos + done, op);
+        done++;
+    }
+
+    /* whole words */
+    while ((length - done) >= (WORD_CHARS * CHAR_BIT))
+    {
+        unsigned char *d = &dest[BIT_CHAR(destPos + done)];
+
+        StoreBigEndian(d, CombineWord(LoadBigEndian(d),
+            LoadBits(src, srcChars, srcPos + done), op));
+        done += WORD_CHARS * CHAR_BIT;
     }
 
-    numBytes = BITS_TO_CHARS(numBits);
+    /* whole characters */
+    while ((length - done) >= CHAR_BIT)
+    {
+        unsigned char *d = &dest[BIT_CHAR(destPos + done)];
 
-    /* allocate space for bit array */
-    m_Array = new unsigned char[numBytes];
+        word = LoadBits(src, srcChars, srcPos + done) >> (64 - CHAR_BIT);
+        *d = (unsigned char)CombineWord(*d, word, op);
+        done += CHAR_BIT;
+    }
 
-    /* set all bits to 0 */
-    fill_n(m_Array, numBytes, 0);
+    /* remaining bits */
+    for (; done < length; done++)
+    {
+        CombineBit(dest, destPos + done, src, srcPos + done, op);
+    }
 }
 
 /***************************************************************************
-*   Method     : bit_array_c - constructor
-*   Description: This is the bit_array_c constructor.  It copies the
-*                for contents of a vector of unsigned char into the
-*                bitarray.
-*   Parameters : vect - vector to be copied
+*   Function   : ClearRange
+*   Description: This function clears a range of bits in an array of
+*                unsigned chars.  Whole characters are cleared with fill_n.
+*   Parameters : array - array of unsigned chars
+*                first - index of the first bit to clear
+*                count - number of bits to clear
+*   Effects    : count bits starting at first are set to 0
+*   Returned   : None
+***************************************************************************/
+static void ClearRange(unsigned char *array, const size_t first,
+    const size_t count)
+{
+    size_t bit, end;
+
+    bit = first;
+    end = first + count;
+
+    while ((bit < end) && ((bit % CHAR_BIT) != 0))
+    {
+        array[BIT_CHAR(bit)] &= ~BIT_IN_CHAR(bit);
+        bit++;
+    }
+
+    if ((end - bit) >= CHAR_BIT)
+    {
+        fill_n(&array[BIT_CHAR(bit)], (end - bit) / CHAR_BIT, 0);
+        bit += ((end - bit) / CHAR_BIT) * CHAR_BIT;
+    }
+
+    for (; bit < end; bit++)
+    {
+        array[BIT_CHAR(bit)] &= ~BIT_IN_CHAR(bit);
+    }
+}
+
+/***************************************************************************
+*   Function   : AnyCommonBits
+*   Description: This function determines if any bit is set in both a and
+*                (b XOR flip), where flip is either all 0s or all 1s.  With
+*                flip = 0 it tests for an intersection, and with flip = ~0
+*                it tests for a bit of a that is missing from b.  Four
+*                words are combined per test so the loop vectorizes, and
+*                the search stops at the first block with a common bit.
+*                Spare bits in the last character are ignored.
+*   Parameters : a - first array of unsigned chars
+*                b - second array of unsigned chars
+*                numBits - number of bits in each array
+*                flip - 0 or ~0, XORed with b
+*   Effects    : None
+*   Returned   : true if a and (b XOR flip) have a bit in common
+***************************************************************************/
+static bool AnyCommonBits(const unsigned char *a, const unsigned char *b,
+    const size_t numBits, const uint64_t flip)
+{
+    size_t i, last;
+    int bits;
+    unsigned char mask;
+
+    last = BIT_CHAR(numBits - 1);           /* may have spare bits */
+
+    for (i = 0; (i + (4 * WORD_CHARS)) <= last; i += (4 * WORD_CHARS))
+    {
+        uint64_t common;
+
+        common = (LoadWord(&a[i]) & (LoadWord(&b[i]) ^ flip)) |
+            (LoadWord(&a[i + WORD_CHARS]) &
+                (LoadWord(&b[i + WORD_CHARS]) ^ flip)) |
+            (LoadWord(&a[i + (2 * WORD_CHARS)]) &
+                (LoadWord(&b[i + (2 * WORD_CHARS)]) ^ flip)) |
+            (LoadWord(&a[i + (3 * WORD_CHARS)]) &
+                (LoadWord(&b[i + (3 * WORD_CHARS)]) ^ flip));
+
+        if (common != 0)
+        {
+            return true;
+        }
+    }
+
+    for (; i < last; i++)
+    {
+        if ((a[i] & (unsigned char)(b[i] ^ flip)) != 0)
+        {
+            return true;
+        }
+    }
+
+    mask = UCHAR_MAX;
+    bits = numBits % CHAR_BIT;
+    if (bits != 0)
+    {
+        mask = UCHAR_MAX << (CHAR_BIT - bits);
+    }
+
+    return ((a[last] & (unsigned char)(b[last] ^ flip) & mask) != 0);
+}
+
+/***************************************************************************
+*   Function   : TrimLimbs
+*   Description: This function removes zero limbs from the most
+*                significant end of a list of limbs, so that every value
+*                has one representation and zero is an empty list.
+*   Parameters : x - list of limbs, least significant first
+*   Effects    : Leading zero limbs are removed from x
+*   Returned   : None
+***************************************************************************/
+static void TrimLimbs(bit_limbs_t &x)
+{
+    while (!x.empty() && (x.back() == 0))
+    {
+        x.pop_back();
+    }
+}
+
+/***************************************************************************
+*   Function   : ToLimbs
+*   Description: This function converts the unsigned integer held in an
+*                array of bits to a list of 32 bit limbs.  As with ++ and
+*                --, the last bit of the array is the least significant.
+*   Parameters : array - array of unsigned chars holding the bits
 *                numBits - number of bits in the array
-*   Effects    : Allocates vectory for array bits
+*                limbs - list receiving the limbs, least significant first
+*   Effects    : limbs holds the trimmed value of the array
 *   Returned   : None
 ***************************************************************************/
-bit_array_c::bit_array_c(unsigned char *array, const int numBits):
-    m_NumBits(numBits),
-    m_Array(array)
+static void ToLimbs(const unsigned char *array, const size_t numBits,
+    bit_limbs_t &limbs)
 {
+    size_t chars;
+    int spare, accBits;
+    uint64_t acc;
+
+    chars = BITS_TO_CHARS(numBits);
+    spare = (chars * CHAR_BIT) - numBits;
+
+    limbs.clear();
+    limbs.reserve((numBits / 32) + 1);
+    acc = array[chars - 1] >> spare;
+    accBits = CHAR_BIT - spare;
+
+    /* work from the least significant end */
+    for (size_t i = chars - 1; i-- > 0;)
+    {
+        acc |= (uint64_t)array[i] << accBits;
+        accBits += CHAR_BIT;
+
+        if (accBits >= 32)
+        {
+            limbs.push_back((uint32_t)acc);
+            acc >>= 32;
+            accBits -= 32;
+        }
+    }
+
+    if (accBits > 0)
+    {
+        limbs.push_back((uint32_t)acc);
+    }
+
+    TrimLimbs(limbs);
 }
 
 /***************************************************************************
-*   Method     : ~bit_array_c - destructor
-*   Description: This is the bit_array_c destructor.  At this point it's
-*                just a place holder.
-*   Parameters : None
+*   Function   : FromLimbs
+*   Description: This function stores a list of 32 bit limbs as the
+*                unsigned integer held in an array of bits.  Values too
+*                large for the array wrap around, as they do with ++.
+*   Parameters : limbs - list of limbs, least significant first
+*                array - array of unsigned chars receiving the bits
+*                numBits - number of bits in the array
+*   Effects    : array holds the value of limbs modulo 2^numBits
+*   Returned   : None
+***************************************************************************/
+static void FromLimbs(const bit_limbs_t &limbs, unsigned char *array,
+    const size_t numBits)
+{
+    size_t chars, next;
+    int spare, bits, accBits;
+    uint64_t acc;
+
+    chars = BITS_TO_CHARS(numBits);
+    spare = (chars * CHAR_BIT) - numBits;
+    acc = 0;
+    accBits = 0;
+    next = 0;
+
+    /* work from the least significant end */
+    for (size_t i = chars; i-- > 0;)
+    {
+        bits = (i == (chars - 1)) ? (CHAR_BIT - spare) : CHAR_BIT;
+
+        if (accBits < bits)
+        {
+            if (next < limbs.size())
+            {
+                acc |= (uint64_t)limbs[next] << accBits;
+                next++;
+            }
+
+            accBits += 32;      /* zeros past the last limb */
+        }
+
+        array[i] = (unsigned char)((acc & ((1 << bits) - 1)) <<
+            (CHAR_BIT - bits));
+        acc >>= bits;
+        accBits -= bits;
+    }
+}
+
+/***************************************************************************
+*   Function   : CompareLimbs
+*   Description: This function compares two trimmed lists of limbs.
+*   Parameters : a - first list of limbs
+*                b - second list of limbs
 *   Effects    : None
+*   Returned   : Negative if a < b, 0 if a == b, and positive if a > b
+***************************************************************************/
+static int CompareLimbs(const bit_limbs_t &a, const bit_limbs_t &b)
+{
+    if (a.size() != b.size())
+    {
+        return (a.size() < b.size()) ? -1 : 1;
+    }
+
+    for (size_t i = a.size(); i-- > 0;)
+    {
+        if (a[i] != b[i])
+        {
+            return (a[i] < b[i]) ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+/***************************************************************************
+*   Function   : AddLimbs
+*   Description: This function adds a list of limbs, shifted left by a
+*                whole number of limbs, to another list of limbs.
+*   Parameters : a - list of limbs receiving the sum
+*                b - list of limbs to add
+*                shift - number of limbs to shift b by
+*   Effects    : a = a + (b * 2^(32 * shift))
 *   Returned   : None
 ***************************************************************************/
-bit_array_c::~bit_array_c(void)
+static void AddLimbs(bit_limbs_t &a, const bit_limbs_t &b,
+    const size_t shift)
+{
+    size_t i;
+    uint64_t carry;
+
+    if (b.empty())
+    {
+        return;
+    }
+
+    if (a.size() < (b.size() + shift))
+    {
+        a.resize(b.size() + shift, 0);
+    }
+
+    carry = 0;
+
+    for (i = 0; i < b.size(); i++)
+    {
+        carry += (uint64_t)a[i + shift] + b[i];
+        a[i + shift] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    for (i += shift; carry != 0; i++)
+    {
+        if (i == a.size())
+        {
+            a.push_back(0);
+        }
+
+        carry += a[i];
+        a[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+}
+
+/***************************************************************************
+*   Function   : SubtractLimbs
+*   Description: This function subtracts a list of limbs from another list
+*                of limbs that is at least as large.
+*   Parameters : a - list of limbs receiving the difference
+*                b - list of limbs to subtract (b <= a)
+*   Effects    : a = a - b
+*   Returned   : None
+***************************************************************************/
+static void SubtractLimbs(bit_limbs_t &a, const bit_limbs_t &b)
 {
-    delete[] m_Array;
+    size_t i;
+    uint64_t borrow, diff;
+
+    borrow = 0;
+
+    for (i = 0; i < b.size(); i++)
+    {
+        diff = (uint64_t)a[i] - b[i] - borrow;
+        a[i] = (uint32_t)diff;
+        borrow = (diff >> 32) & 1;
+    }
+
+    for (; borrow != 0; i++)
+    {
+        diff = (uint64_t)a[i] - borrow;
+        a[i] = (uint32_t)diff;
+        borrow = (diff >> 32) & 1;
+    }
+
+    TrimLimbs(a);
 }
 
 /***************************************************************************
-*   Method     : Dump
-*   Description: This method dumps the conents of a bit array to stdout.
-*                The format of the dump is a series of bytes represented in
-*                hexadecimal.
-*   Parameters : outStream - stream to write to
-*   Effects    : Array contents are dumped to stdout
+*   Function   : MultiplyAddSmall
+*   Description: This function multiplies a list of limbs by a single limb
+*                and adds another single limb.
+*   Parameters : x - list of limbs receiving the result
+*                multiplier - value to multiply x by
+*                addend - value to add to the product
+*   Effects    : x = (x * multiplier) + addend
+*   Returned   : None
+***************************************************************************/
+static void MultiplyAddSmall(bit_limbs_t &x, const uint32_t multiplier,
+    const uint32_t addend)
+{
+    uint64_t carry;
+
+    carry = addend;
+
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        carry += (uint64_t)x[i] * multiplier;
+        x[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    if (carry != 0)
+    {
+        x.push_back((uint32_t)carry);
+    }
+
+    TrimLimbs(x);
+}
+
+/***************************************************************************
+*   Function   : DivideSmallLimbs
+*   Description: This function divides a list of limbs by a single limb
+*                using one pass of short division.
+*   Parameters : x - list of limbs receiving the quotient
+*                divisor - non-zero value to divide x by
+*   Effects    : x = x / divisor
+*   Returned   : x % divisor
+***************************************************************************/
+static uint32_t DivideSmallLimbs(bit_limbs_t &x, const uint32_t divisor)
+{
+    uint64_t rem;
+
+    rem = 0;
+
+    for (size_t i = x.size(); i-- > 0;)
+    {
+        rem = (rem << 32) | x[i];
+        x[i] = (uint32_t)(rem / divisor);
+        rem %= divisor;
+    }
+
+    TrimLimbs(x);
+    return (uint32_t)rem;
+}
+
+/***************************************************************************
+*   Function   : MultiplyLimbs
+*   Description: This function multiplies two lists of limbs.  Short
+*                operands are multiplied with the schoolbook method and
+*                longer ones are split in half and multiplied with
+*                Karatsuba's three half size products.
+*   Parameters : a - first list of limbs
+*                b - second list of limbs
+*                product - list receiving a * b (not a or b)
+*   Effects    : product = a * b
 *   Returned   : None
 ***************************************************************************/
-void bit_array_c::Dump(std::ostream &outStream)
+static void MultiplyLimbs(const bit_limbs_t &a, const bit_limbs_t &b,
+    bit_limbs_t &product)
+{
+    size_t half;
+    bit_limbs_t a0, a1, b0, b1, z0, z1, z2;
+
+    if (min(a.size(), b.size()) < KARATSUBA_LIMBS)
+    {
+        uint64_t carry;
+
+        product.assign(a.size() + b.size(), 0);
+
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            carry = 0;
+
+            for (size_t j = 0; j < b.size(); j++)
+            {
+                carry += ((uint64_t)a[i] * b[j]) + product[i + j];
+                product[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+
+            product[i + b.size()] = (uint32_t)carry;
+        }
+
+        TrimLimbs(product);
+        return;
+    }
+
+    half = max(a.size(), b.size()) / 2;
+
+    if ((a.size() <= half) || (b.size() <= half))
+    {
+        /* unbalanced: split the long operand only */
+        const bit_limbs_t &s = (a.size() <= half) ? a : b;
+        const bit_limbs_t &l = (a.size() <= half) ? b : a;
+
+        b0.assign(l.begin(), l.begin() + half);
+        b1.assign(l.begin() + half, l.end());
+        TrimLimbs(b0);
+        MultiplyLimbs(s, b0, product);
+        MultiplyLimbs(s, b1, z1);
+        AddLimbs(product, z1, half);
+        TrimLimbs(product);
+        return;
+    }
+
+    a0.assign(a.begin(), a.begin() + half);
+    a1.assign(a.begin() + half, a.end());
+    b0.assign(b.begin(), b.begin() + half);
+    b1.assign(b.begin() + half, b.end());
+    TrimLimbs(a0);
+    TrimLimbs(b0);
+
+    MultiplyLimbs(a0, b0, z0);
+    MultiplyLimbs(a1, b1, z2);
+
+    /* z1 = (a0 + a1)(b0 + b1) - z0 - z2 = a0 b1 + a1 b0 */
+    AddLimbs(a0, a1, 0);
+    AddLimbs(b0, b1, 0);
+    MultiplyLimbs(a0, b0, z1);
+    SubtractLimbs(z1, z0);
+    SubtractLimbs(z1, z2);
+
+    product.swap(z0);
+    AddLimbs(product, z1, half);
+    AddLimbs(product, z2, 2 * half);
+    TrimLimbs(product);
+}
+
+/***************************************************************************
+*   Function   : DivideLimbs
+*   Description: This function divides one list of limbs by another using
+*                Knuth's algorithm D.  The operands are normalized so the
+*                divisor's top bit is set, then each quotient limb is
+*                estimated from the top two limbs of the remainder,
+*                corrected, and its multiple of the divisor subtracted.
+*   Parameters : u - dividend
+*                v - non-zero divisor
+*                q - list receiving the quotient
+*                r - list receiving the remainder
+*   Effects    : q = u / v and r = u % v
+*   Returned   : None
+***************************************************************************/
+static void DivideLimbs(const bit_limbs_t &u, const bit_limbs_t &v,
+    bit_limbs_t &q, bit_limbs_t &r)
+{
+    size_t m, n, i;
+    int s;
+    uint64_t num, qhat, rhat, p, carry;
+    int64_t t, borrow;
+    bit_limbs_t un, vn;
+
+    if (CompareLimbs(u, v) < 0)
+    {
+        q.clear();
+        r = u;
+        return;
+    }
+
+    n = v.size();
+
+    if (n == 1)
+    {
+        q = u;
+        r.assign(1, DivideSmallLimbs(q, v[0]));
+        TrimLimbs(r);
+        return;
+    }
+
+    m = u.size() - n;
+
+    /* normalize so the top bit of the divisor is set */
+    for (s = 0; ((v[n - 1] << s) & 0x80000000) == 0; s++);
+
+    vn.resize(n);
+    un.resize(u.size() + 1);
+
+    for (i = n - 1; i > 0; i--)
+    {
+        vn[i] = (v[i] << s) | ((s != 0) ? (v[i - 1] >> (32 - s)) : 0);
+    }
+
+    vn[0] = v[0] << s;
+    un[m + n] = (s != 0) ? (u[m + n - 1] >> (32 - s)) : 0;
+
+    for (i = m + n - 1; i > 0; i--)
+    {
+        un[i] = (u[i] << s) | ((s != 0) ? (u[i - 1] >> (32 - s)) : 0);
+    }
+
+    un[0] = u[0] << s;
+    q.assign(m + 1, 0);
+
+    for (size_t j = m + 1; j-- > 0;)
+    {
+        /* estimate the quotient limb from the top two remainder limbs */
+        num = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+        qhat = num / vn[n - 1];
+        rhat = num % vn[n - 1];
+
+        while (((qhat >> 32) != 0) ||
+            ((qhat * vn[n - 2]) > ((rhat << 32) | un[j + n - 2])))
+        {
+            qhat--;
+            rhat += vn[n - 1];
+
+            if ((rhat >> 32) != 0)
+            {
+                break;
+            }
+        }
+
+        /* subtract qhat times the divisor */
+        borrow = 0;
+
+        for (i = 0; i < n; i++)
+        {
+            p = qhat * vn[i];
+            t = (int64_t)un[i + j] - borrow - (int64_t)(p & 0xFFFFFFFF);
+            un[i + j] = (uint32_t)t;
+            borrow = (int64_t)(p >> 32) - (t >> 32);
+        }
+
+        t = (int64_t)un[j + n] - borrow;
+        un[j + n] = (uint32_t)t;
+        q[j] = (uint32_t)qhat;
+
+        if (t < 0)
+        {
+            /* qhat was one too large, add the divisor back */
+            q[j]--;
+            carry = 0;
+
+            for (i = 0; i < n; i++)
+            {
+                carry += (uint64_t)un[i + j] + vn[i];
+                un[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+
+            un[j + n] += (uint32_t)carry;
+        }
+    }
+
+    /* unnormalize the remainder */
+    r.resize(n);
+
+    for (i = 0; i < n; i++)
+    {
+        r[i] = (un[i] >> s) |
+            ((s != 0) ? (uint32_t)(un[i + 1] << (32 - s)) : 0);
+    }
+
+    TrimLimbs(q);
+    TrimLimbs(r);
+}
+
+/***************************************************************************
+*   Function   : BarrettReduce
+*   Description: This function reduces a list of limbs modulo m using a
+*                precomputed Barrett constant, replacing the division with
+*                two multiplications and at most two subtractions.
+*   Parameters : x - list of limbs to reduce (x < 2^(64k))
+*                m - non-zero modulus of k limbs
+*                mu - floor(2^(64k) / m)
+*   Effects    : x = x % m
+*   Returned   : None
+***************************************************************************/
+static void BarrettReduce(bit_limbs_t &x, const bit_limbs_t &m,
+    const bit_limbs_t &mu)
+{
+    size_t k;
+    bit_limbs_t q, qmu, t;
+
+    if (CompareLimbs(x, m) < 0)
+    {
+        return;
+    }
+
+    k = m.size();
+
+    /* estimate x / m as ((x >> 32(k - 1)) * mu) >> 32(k + 1) */
+    q.assign(x.begin() + (k - 1), x.end());
+    MultiplyLimbs(q, mu, qmu);
+
+    if (qmu.size() > (k + 1))
+    {
+        q.assign(qmu.begin() + (k + 1), qmu.end());
+        MultiplyLimbs(q, m, t);
+        SubtractLimbs(x, t);
+    }
+
+    /* the estimate is at most two too small */
+    while (CompareLimbs(x, m) >= 0)
+    {
+        SubtractLimbs(x, m);
+    }
+}
+
+/***************************************************************************
+*   Function   : LimbsToDecimal
+*   Description: This function appends the decimal digits of a list of
+*                limbs to a string.  Large values are split by dividing by
+*                a precomputed power of ten with about half as many digits,
+*                and each half is converted recursively, so most of the
+*                work is done on short numbers.
+*   Parameters : x - list of limbs to convert (x < powers[level])
+*                powers - powers[i] is 10^(9 * 2^i)
+*                level - index of a power greater than x
+*                width - minimum number of digits, padded with leading
+*                    zeros
+*                out - string receiving the digits
+*   Effects    : Digits of x are appended to out
+*   Returned   : None
+***************************************************************************/
+static void LimbsToDecimal(const bit_limbs_t &x,
+    const vector<bit_limbs_t> &powers, const size_t level,
+    const size_t width, string &out)
+{
+    size_t digitCount;
+    bit_limbs_t q, r;
+
+    if ((level == 0) || (x.size() <= DECIMAL_BASE_LIMBS))
+    {
+        string digits;
+        uint32_t chunk;
+
+        /* short division, DECIMAL_LIMB_DIGITS digits at a time */
+        q = x;
+
+        while (!q.empty())
+        {
+            chunk = DivideSmallLimbs(q, DECIMAL_LIMB);
+
+            for (int i = 0; i < DECIMAL_LIMB_DIGITS; i++)
+            {
+                digits.push_back('0' + (chunk % 10));
+                chunk /= 10;
+            }
+        }
+
+        while (!digits.empty() && (digits[digits.size() - 1] == '0'))
+        {
+            digits.erase(digits.size() - 1);
+        }
+
+        if (digits.size() < width)
+        {
+            digits.append(width - digits.size(), '0');
+        }
+
+        out.append(digits.rbegin(), digits.rend());
+        return;
+    }
+
+    if (CompareLimbs(x, powers[level - 1]) < 0)
+    {
+        LimbsToDecimal(x, powers, level - 1, width, out);
+        return;
+    }
+
+    DivideLimbs(x, powers[level - 1], q, r);
+    digitCount = (size_t)DECIMAL_LIMB_DIGITS << (level - 1);
+    LimbsToDecimal(q, powers, level - 1,
+        (width > digitCount) ? (width - digitCount) : 0, out);
+    LimbsToDecimal(r, powers, level - 1, digitCount, out);
+}
+
+/***************************************************************************
+*   Function   : DecimalToLimbs
+*   Description: This function converts a string of decimal digits to a
+*                list of limbs.  Long strings are split so that the low
+*                part has 9 * 2^i digits, each part is converted
+*                recursively, and the high part is multiplied by the
+*                precomputed 10^(9 * 2^i) and added to the low part.
+*   Parameters : digits - decimal digits, most significant first
+*                length - number of digits
+*                powers - powers[i] is 10^(9 * 2^i)
+*                x - list receiving the limbs
+*   Effects    : x holds the value of the digits
+*   Returned   : None
+***************************************************************************/
+static void DecimalToLimbs(const char *digits, const size_t length,
+    const vector<bit_limbs_t> &powers, bit_limbs_t &x)
+{
+    size_t level, lowDigits;
+    bit_limbs_t high, low;
+
+    if (length <= (DECIMAL_LIMB_DIGITS * DECIMAL_BASE_LIMBS))
+    {
+        size_t i, chunkDigits;
+        uint32_t chunk, scale;
+
+        /* multiply and add, DECIMAL_LIMB_DIGITS digits at a time */
+        x.clear();
+        chunkDigits = length % DECIMAL_LIMB_DIGITS;
+
+        if (chunkDigits == 0)
+        {
+            chunkDigits = DECIMAL_LIMB_DIGITS;
+        }
+
+        for (i = 0; i < length; i += chunkDigits)
+        {
+            if (i != 0)
+            {
+                chunkDigits = DECIMAL_LIMB_DIGITS;
+            }
+
+            chunk = 0;
+            scale = 1;
+
+            for (size_t j = 0; j < chunkDigits; j++)
+            {
+                chunk = (chunk * 10) + (digits[i + j] - '0');
+                scale *= 10;
+            }
+
+            MultiplyAddSmall(x, scale, chunk);
+        }
+
+        return;
+    }
+
+    /* the low part gets the largest power of two chunks that is shorter */
+    for (level = 0;
+        ((size_t)DECIMAL_LIMB_DIGITS << (level + 1)) < length;
+        level++);
+
+    lowDigits = (size_t)DECIMAL_LIMB_DIGITS << level;
+    DecimalToLimbs(digits, length - lowDigits, powers, high);
+    DecimalToLimbs(digits + (length - lowDigits), lowDigits, powers, low);
+    MultiplyLimbs(high, powers[level], x);
+    AddLimbs(x, low, 0);
+    TrimLimbs(x);
+}
+
+/***************************************************************************
+*   Method     : bit_decode_table_c - constructor
+*   Description: This is the bit_decode_table_c constructor.  It fills in
+*                the bit count and bit positions for every unsigned char
+*                value.
+*   Parameters : None
+*   Effects    : Table is filled in
+*   Returned   : None
+***************************************************************************/
+bit_decode_table_c::bit_decode_table_c(void)
+{
+    for (size_t value = 0; value <= UCHAR_MAX; value++)
+    {
+        count[value] = 0;
+
+        for (size_t bit = 0; bit < CHAR_BIT; bit++)
+        {
+            if (value & BIT_IN_CHAR(bit))
+            {
+                position[value][count[value]] = bit;
+                count[value]++;
+            }
+        }
+    }
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : bit_array_c - constructor
+*   Description: This is the bit_array_c constructor.  It reserves memory
+*                for the vector storing the array, with all bits 0.
+*   Parameters : numBits - number of bits in the array
+*   Effects    : Allocates vectory for array bits
+*   Returned   : None
+***************************************************************************/
+bit_array_c::bit_array_c(const size_t numBits):
+    m_NumBits(numBits),
+    m_Array(NULL)
+{
+    if (numBits < 1)
+    {
+        throw invalid_argument("Error: Bit Array must have at least 1 bit.");
+    }
+
+    Allocate();
+}
+
+/***************************************************************************
+*   Method     : bit_array_c - constructor
+*   Description: This is the bit_array_c constructor.  It reads an array
+*                written by Serialize from a binary stream.
+*   Parameters : inStream - stream to read from
+*   Effects    : Allocates vectory for array bits and reads them
+*   Returned   : None
+***************************************************************************/
+bit_array_c::bit_array_c(std::istream &inStream):
+    m_NumBits(0),
+    m_Array(NULL)
+{
+    unsigned char header[SERIAL_HEADER_CHARS];
+    size_t size;
+    int bits;
+
+    inStream.read((char *)header, SERIAL_HEADER_CHARS);
+
+    if (!inStream || (memcmp(header, SERIAL_MAGIC, 4) != 0) ||
+        (header[4] != SERIAL_VERSION))
+    {
+        throw invalid_argument("Error: Invalid Bit Array stream.");
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        m_NumBits |= (size_t)header[5 + i] << (CHAR_BIT * i);
+    }
+
+    if (m_NumBits < 1)
+    {
+        throw invalid_argument("Error: Invalid Bit Array stream.");
+    }
+
+    Allocate();
+    size = BITS_TO_CHARS(m_NumBits);
+    inStream.read((char *)m_Array, size);
+
+    if (!inStream)
+    {
+        Free();
+        throw invalid_argument("Error: Invalid Bit Array stream.");
+    }
+
+    /* zero any spare bits so increment and decrement are consistent */
+    bits = m_NumBits % CHAR_BIT;
+    if (bits != 0)
+    {
+        m_Array[size - 1] &= (unsigned char)(UCHAR_MAX << (CHAR_BIT - bits));
+    }
+}
+
+/***************************************************************************
+*   Method     : bit_array_c - constructor
+*   Description: This is the bit_array_c constructor.  It copies the
+*                for contents of a vector of unsigned char into the
+*                bitarray.
+*   Parameters : vect - vector to be copied
+*                numBits - number of bits in the array
+*   Effects    : Allocates vectory for array bits
+*   Returned   : None
+***************************************************************************/
+bit_array_c::bit_array_c(unsigned char *array, const size_t numBits):
+    m_NumBits(numBits),
+    m_Array(array),
+    m_Alloc(BIT_ALLOC_NEW)
+{
+}
+
+/***************************************************************************
+*   Method     : ~bit_array_c - destructor
+*   Description: This is the bit_array_c destructor.  It frees the vector
+*                storing the array.
+*   Parameters : None
+*   Effects    : Frees vector for array bits
+*   Returned   : None
+***************************************************************************/
+bit_array_c::~bit_array_c(void)
+{
+    Free();
+}
+
+/***************************************************************************
+*   Method     : Allocate
+*   Description: This method allocates the vector storing the array,
+*                already zeroed, so pages of large arrays aren't touched
+*                until they're used: large arrays are mapped anonymously
+*                where mmap is available, and everything else comes from
+*                calloc.
+*   Parameters : None
+*   Effects    : Allocates vector for m_NumBits bits, all 0
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::Allocate(void)
+{
+    size_t numBytes;
+
+    numBytes = BITS_TO_CHARS(m_NumBits);
+
+#ifdef BIT_ARRAY_USE_MMAP
+    if (numBytes >= MMAP_BYTES)
+    {
+        void *map;
+
+        map = mmap(NULL, numBytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (map != MAP_FAILED)
+        {
+            m_Array = (unsigned char *)map;
+            m_Alloc = BIT_ALLOC_MMAP;
+            return;
+        }
+    }
+#endif
+
+    m_Array = (unsigned char *)calloc(numBytes, 1);
+
+    if (m_Array == NULL)
+    {
+        throw bad_alloc();
+    }
+
+    m_Alloc = BIT_ALLOC_CALLOC;
+}
+
+/***************************************************************************
+*   Method     : Free
+*   Description: This method frees the vector storing the array the same
+*                way it was allocated.
+*   Parameters : None
+*   Effects    : Frees vector for array bits
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::Free(void)
+{
+    switch (m_Alloc)
+    {
+        case BIT_ALLOC_NEW:
+            delete[] m_Array;
+            break;
+
+        case BIT_ALLOC_CALLOC:
+            free(m_Array);
+            break;
+
+        case BIT_ALLOC_MMAP:
+#ifdef BIT_ARRAY_USE_MMAP
+            munmap(m_Array, BITS_TO_CHARS(m_NumBits));
+#endif
+            break;
+    }
+
+    m_Array = NULL;
+}
+
+/***************************************************************************
+*   Method     : Dump
+*   Description: This method dumps the conents of a bit array to stdout.
+*                The format of the dump is a series of bytes represented in
+*                hexadecimal.
+*   Parameters : outStream - stream to write to
+*   Effects    : Array contents are dumped to stdout
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::Dump(std::ostream &outStream)
+{
+    size_t size;
+
+    size = BITS_TO_CHARS(m_NumBits);
+
+    outStream.width(2);
+    outStream.fill('0');
+    outStream << uppercase << hex << (int)(m_Array[0]);  /* first byte */
+
+    for (size_t i = 1; i < size; i++)
+    {
+        /* remaining bytes with a leading space */
+        outStream << " ";
+        outStream.width(2);
+        outStream.fill('0');
+        outStream << (int)(m_Array[i]);
+    }
+
+    outStream << dec;
+}
+
+/***************************************************************************
+*   Method     : Serialize
+*   Description: This method writes the array to a binary stream in a form
+*                that can be read back with the stream constructor.  The
+*                format is the 4 characters "BITA", a version byte, the
+*                number of bits as 8 bytes least significant first, then
+*                the characters of the array.
+*   Parameters : outStream - stream to write to
+*   Effects    : Array is written to outStream
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::Serialize(std::ostream &outStream) const
+{
+    unsigned char header[SERIAL_HEADER_CHARS];
+
+    memcpy(header, SERIAL_MAGIC, 4);
+    header[4] = SERIAL_VERSION;
+
+    for (int i = 0; i < 8; i++)
+    {
+        header[5 + i] =
+            (unsigned char)((uint64_t)m_NumBits >> (CHAR_BIT * i));
+    }
+
+    outStream.write((const char *)header, SERIAL_HEADER_CHARS);
+    outStream.write((const char *)m_Array, BITS_TO_CHARS(m_NumBits));
+}
+
+/***************************************************************************
+*   Method     : SetAll
+*   Description: This method sets every bit in the bit array to 1.  This
+*                method uses UCHAR_MAX to determine what it means to set
+*                all bits in an unsigned char, so it is crucial that the
+*                machine implementation of unsigned char utilizes all of
+*                the bits in the memory allocated for an unsigned char.
+*   Parameters : None
+*   Effects    : Each of the bits used in the bit array are set to 1.
+*                Unused (spare) bits are set to 0.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::SetAll(void)
+{
+    int bits;
+    size_t size;
+    unsigned char mask;
+
+    size = BITS_TO_CHARS(m_NumBits);
+
+    /* set bits in all bytes to 1 */
+    fill_n(m_Array, size, UCHAR_MAX);
+
+    /* zero any spare bits so increment and decrement are consistent */
+    bits = m_NumBits % CHAR_BIT;
+    if (bits != 0)
+    {
+        mask = UCHAR_MAX << (CHAR_BIT - bits);
+        m_Array[BIT_CHAR(m_NumBits - 1)] = mask;
+    }
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method sets every bit in the bit array to 0.
+*   Parameters : None
+*   Effects    : Each of the bits in the bit array are set to 0.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::ClearAll(void)
+{
+    size_t size;
+
+    size = BITS_TO_CHARS(m_NumBits);
+
+#if defined(BIT_ARRAY_USE_MMAP) && defined(__linux__)
+    if (m_Alloc == BIT_ALLOC_MMAP)
+    {
+        /* give the pages back; they read as 0 when they're next touched */
+        if (madvise(m_Array, size, MADV_DONTNEED) == 0)
+        {
+            return;
+        }
+    }
+#endif
+
+    /* set bits in all bytes to 0 */
+    fill_n(m_Array, size, 0);
+}
+
+/***************************************************************************
+*   Method     : SetBit
+*   Description: This method sets a bit in the bit array to 1.
+*   Parameters : bit - the number of the bit to set
+*   Effects    : The specified bit will be set to 1.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::SetBit(const size_t bit)
+{
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    m_Array[BIT_CHAR(bit)] |= BIT_IN_CHAR(bit);
+}
+
+/***************************************************************************
+*   Method     : ClearBit
+*   Description: This method sets a bit in the bit array to 0.
+*   Parameters : bit - the number of the bit to clear
+*   Effects    : The specified bit will be set to 0.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::ClearBit(const size_t bit)
+{
+    unsigned char mask;
+
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    /* create a mask to zero out desired bit */
+    mask =  BIT_IN_CHAR(bit);
+    mask = ~mask;
+
+    m_Array[BIT_CHAR(bit)] &= mask;
+}
+
+/***************************************************************************
+*   Method     : SetRange
+*   Description: This method sets a range of bits to 1.  The partial
+*                characters at either end are masked and the characters
+*                between them are filled whole.
+*   Parameters : first - the number of the first bit to set
+*                length - the number of bits to set
+*   Effects    : The bits in the range will be set to 1.  The range is
+*                clipped to the end of the array.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::SetRange(const size_t first, const size_t length)
+{
+    size_t last, firstChar, lastChar;
+    unsigned char headMask, tailMask;
+
+    if ((m_NumBits <= first) || (length == 0))
+    {
+        return;         /* nothing in range */
+    }
+
+    last = first + min(length, m_NumBits - first) - 1;
+    firstChar = BIT_CHAR(first);
+    lastChar = BIT_CHAR(last);
+
+    headMask = UCHAR_MAX >> (first % CHAR_BIT);
+    tailMask =
+        (unsigned char)(UCHAR_MAX << (CHAR_BIT - 1 - (last % CHAR_BIT)));
+
+    if (firstChar == lastChar)
+    {
+        m_Array[firstChar] |= headMask & tailMask;
+        return;
+    }
+
+    m_Array[firstChar] |= headMask;
+    fill_n(m_Array + firstChar + 1, lastChar - firstChar - 1, UCHAR_MAX);
+    m_Array[lastChar] |= tailMask;
+}
+
+/***************************************************************************
+*   Method     : operator()
+*   Description: Overload of the () operator.  This method approximates
+*                array indices used for assignment.  It returns a
+*                bit_array_index_c which includes an = method used to
+*                set bit values.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : bit_array_index_c (pointer to bit)
+***************************************************************************/
+bit_array_index_c bit_array_c::operator()(const size_t bit)
+{
+    bit_array_index_c result(this, bit);
+
+    return result;
+}
+
+/***************************************************************************
+*   Method     : Count
+*   Description: This method counts the number of bits set in the bit
+*                array.  Bits are counted a word at a time.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Number of set bits
+***************************************************************************/
+size_t bit_array_c::Count(void) const
+{
+    size_t size, i, count;
+
+    size = BITS_TO_CHARS(m_NumBits);
+    count = 0;
+
+    for (i = 0; (i + WORD_CHARS) <= size; i += WORD_CHARS)
+    {
+        count += PopCount(LoadWord(&m_Array[i]));
+    }
+
+    for (; i < size; i++)
+    {
+        count += DecodeTable().count[m_Array[i]];
+    }
+
+    return count;
+}
+
+/***************************************************************************
+*   Method     : FromIndices
+*   Description: This method sets every bit in a list of bit indices.  If
+*                the list is sorted in ascending order, bits falling in the
+*                same unsigned char are combined and written once.
+*                Indices that are out of range are ignored.
+*   Parameters : indices - array of bit indices to set
+*                count - number of indices in the array
+*                sorted - true if indices are in ascending order
+*   Effects    : The bits listed in indices will be set to 1.  Other bits
+*                are unchanged.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::FromIndices(const size_t *indices,
+    const size_t count, const bool sorted)
+{
+    size_t i;
+
+    if (!sorted)
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (indices[i] < m_NumBits)
+            {
+                m_Array[BIT_CHAR(indices[i])] |= BIT_IN_CHAR(indices[i]);
+            }
+        }
+
+        return;
+    }
+
+    i = 0;
+    while ((i < count) && (indices[i] < m_NumBits))
+    {
+        size_t charIndex;
+        unsigned char bits;
+
+        /* gather all of the bits that fall in this character */
+        charIndex = BIT_CHAR(indices[i]);
+        bits = 0;
+
+        do
+        {
+            bits |= BIT_IN_CHAR(indices[i]);
+            i++;
+        } while ((i < count) && (indices[i] < m_NumBits) &&
+            (BIT_CHAR(indices[i]) == charIndex));
+
+        m_Array[charIndex] |= bits;
+    }
+}
+
+/***************************************************************************
+*   Method     : ToIndices
+*   Description: This method writes the index of every set bit into an
+*                array in ascending order.  Runs of zero characters are
+*                skipped a word at a time and non-zero characters are
+*                decoded with a lookup table.
+*   Parameters : indices - array receiving bit indices
+*                maxCount - number of entries that fit in indices
+*   Effects    : Up to maxCount indices are written to indices.
+*   Returned   : Number of indices written.  If it equals maxCount there
+*                may have been more set bits than room (see Count).
+***************************************************************************/
+size_t bit_array_c::ToIndices(size_t *indices,
+    const size_t maxCount) const
+{
+    const bit_decode_table_c &table = DecodeTable();
+    size_t size, i, written;
+    unsigned char value;
+    int bits;
+
+    size = BITS_TO_CHARS(m_NumBits);
+    written = 0;
+
+    for (i = 0; i < size; i++)
+    {
+        /* skip words that don't have any bits set */
+        while (((i + WORD_CHARS) <= size) && (LoadWord(&m_Array[i]) == 0))
+        {
+            i += WORD_CHARS;
+        }
+
+        if (i >= size)
+        {
+            break;
+        }
+
+        value = m_Array[i];
+
+        if (i == size - 1)
+        {
+            /* ignore spare bits */
+            bits = m_NumBits % CHAR_BIT;
+            if (bits != 0)
+            {
+                value &= (unsigned char)(UCHAR_MAX << (CHAR_BIT - bits));
+            }
+        }
+
+        for (size_t j = 0; j < table.count[value]; j++)
+        {
+            if (written == maxCount)
+            {
+                return written;
+            }
+
+            indices[written] = (i * CHAR_BIT) + table.position[value][j];
+            written++;
+        }
+    }
+
+    return written;
+}
+
+/***************************************************************************
+*   Method     : ClearTail
+*   Description: This method clears every bit from a given bit to the end
+*                of the array.
+*   Parameters : bit - index of the first bit to clear
+*   Effects    : Bits from bit to the end of the array are set to 0.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::ClearTail(const size_t bit)
+{
+    if (bit < m_NumBits)
+    {
+        ClearRange(m_Array, bit, m_NumBits - bit);
+    }
+}
+
+/***************************************************************************
+*   Method     : Slice
+*   Description: This method returns a read only view of a range of bits in
+*                this array.  No bits are copied; the view refers to this
+*                array, so it must not outlive it.
+*   Parameters : pos - index of the first bit in the view
+*                length - number of bits in the view
+*   Effects    : None
+*   Returned   : View of the bits.  The range is clipped to the array.
+***************************************************************************/
+bit_array_slice_c bit_array_c::Slice(const size_t pos,
+    const size_t length) const
+{
+    return bit_array_slice_c(*this, pos, length);
+}
+
+/***************************************************************************
+*   Method     : CopyRange
+*   Description: This method copies a range of bits from a source array
+*                into this array.  A few bits are copied one at a time to
+*                reach a character boundary in this array, then the source
+*                bits are shifted into place and stored a word at a time,
+*                whether or not they are aligned.
+*   Parameters : src - array to copy bits from (may be this array)
+*                srcPos - index of the first bit to copy from src
+*                length - number of bits to copy
+*                destPos - index in this array that receives the first bit
+*   Effects    : length bits starting at destPos are replaced.  The copy is
+*                clipped to the ends of both arrays.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::CopyRange(const bit_array_c &src, const size_t srcPos,
+    const size_t length, const size_t destPos)
+{
+    size_t count, srcChars, done;
+
+    if ((srcPos >= src.m_NumBits) || (destPos >= m_NumBits))
+    {
+        return;         /* nothing in range */
+    }
+
+    count = min(length, min(src.m_NumBits - srcPos, m_NumBits - destPos));
+
+    if ((&src == this) && (srcPos < (destPos + count)) &&
+        (destPos < (srcPos + count)) && (srcPos != destPos))
+    {
+        /* overlapping ranges of this array go through a temporary */
+        bit_array_c temp(count);
+
+        temp.CopyRange(*this, srcPos, count, 0);
+        CopyRange(temp, 0, count, destPos);
+        return;
+    }
+
+    srcChars = BITS_TO_CHARS(src.m_NumBits);
+    done = 0;
+
+    /* copy bits up to a character boundary in this array */
+    while ((done < count) && (((destPos + done) % CHAR_BIT) != 0))
+    {
+        if (src[srcPos + done])
+        {
+            SetBit(destPos + done);
+        }
+        else
+        {
+            ClearBit(destPos + done);
+        }
+
+        done++;
+    }
+
+    /* whole words */
+    while ((count - done) >= (WORD_CHARS * CHAR_BIT))
+    {
+        StoreBigEndian(&m_Array[BIT_CHAR(destPos + done)],
+            LoadBits(src.m_Array, srcChars, srcPos + done));
+        done += WORD_CHARS * CHAR_BIT;
+    }
+
+    /* whole characters */
+    while ((count - done) >= CHAR_BIT)
+    {
+        m_Array[BIT_CHAR(destPos + done)] = (unsigned char)(LoadBits(
+            src.m_Array, srcChars, srcPos + done) >> (64 - CHAR_BIT));
+        done += CHAR_BIT;
+    }
+
+    /* remaining bits */
+    for (; done < count; done++)
+    {
+        if (src[srcPos + done])
+        {
+            SetBit(destPos + done);
+        }
+        else
+        {
+            ClearBit(destPos + done);
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : Concat
+*   Description: This method fills this array with a list of arrays placed
+*                end to end.  Arrays that don't fit are truncated.  This
+*                array must not be in the list.
+*   Parameters : arrays - array of pointers to the arrays to concatenate
+*                count - number of arrays in the list
+*   Effects    : This array holds the concatenated arrays followed by
+*                cleared bits.
+*   Returned   : Number of bits copied from the list
+***************************************************************************/
+size_t bit_array_c::Concat(const bit_array_c *const *arrays,
+    const size_t count)
+{
+    size_t pos = 0;
+
+    for (size_t i = 0; (i < count) && (pos < m_NumBits); i++)
+    {
+        CopyRange(*arrays[i], 0, arrays[i]->m_NumBits, pos);
+        pos += min(arrays[i]->m_NumBits, m_NumBits - pos);
+    }
+
+    ClearTail(pos);
+    return pos;
+}
+
+/***************************************************************************
+*   Method     : Split
+*   Description: This method copies consecutive ranges of this array into
+*                a list of arrays.  count split positions define count + 1
+*                pieces: [0, positions[0]), [positions[0], positions[1]),
+*                ... [positions[count - 1], Size()).
+*   Parameters : positions - ascending list of split positions
+*                count - number of split positions
+*                pieces - count + 1 pointers to arrays receiving the pieces
+*   Effects    : Each piece holds its range of bits followed by cleared
+*                bits.  Ranges longer than their piece are truncated.
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::Split(const size_t *positions, const size_t count,
+    bit_array_c *const *pieces) const
+{
+    size_t start, end;
+
+    start = 0;
+
+    for (size_t i = 0; i <= count; i++)
+    {
+        end = (i < count) ? min(positions[i], m_NumBits) : m_NumBits;
+        end = max(end, start);
+
+        pieces[i]->CopyRange(*this, start, end - start, 0);
+        pieces[i]->ClearTail(min(end - start, pieces[i]->m_NumBits));
+        start = end;
+    }
+}
+
+/***************************************************************************
+*   Method     : Select
+*   Description: This method finds the bit with a given rank among the set
+*                bits.  Whole words are skipped using their population
+*                count, then characters, and the bit is picked out of its
+*                character with a lookup table.
+*   Parameters : rank - number of set bits that precede the desired bit
+*   Effects    : None
+*   Returned   : Index of the set bit with rank set bits before it.  Size()
+*                if there are not more than rank bits set.
+***************************************************************************/
+size_t bit_array_c::Select(const size_t rank) const
+{
+    const bit_decode_table_c &table = DecodeTable();
+    size_t size, i, remaining, count;
+
+    size = BITS_TO_CHARS(m_NumBits);
+    remaining = rank;
+
+    /* skip whole words */
+    for (i = 0; (i + WORD_CHARS) <= size; i += WORD_CHARS)
+    {
+        count = PopCount(LoadWord(&m_Array[i]));
+
+        if (count > remaining)
+        {
+            break;
+        }
+
+        remaining -= count;
+    }
+
+    /* find the character */
+    for (; i < size; i++)
+    {
+        count = table.count[m_Array[i]];
+
+        if (count > remaining)
+        {
+            size_t bit;
+
+            bit = (i * CHAR_BIT) + table.position[m_Array[i]][remaining];
+            return (bit < m_NumBits) ? bit : m_NumBits;
+        }
+
+        remaining -= count;
+    }
+
+    return m_NumBits;
+}
+
+/***************************************************************************
+*   Method     : NextSet
+*   Description: This method finds the first set bit at or after a given
+*                bit.  The character holding the starting bit is masked,
+*                then zero words and characters are skipped.
+*   Parameters : bit - index of the first bit to examine
+*   Effects    : None
+*   Returned   : Index of the first set bit at or after bit.  Size() if
+*                there isn't one.
+***************************************************************************/
+size_t bit_array_c::NextSet(const size_t bit) const
+{
+    size_t size, i, result;
+    unsigned char value;
+
+    if (bit >= m_NumBits)
+    {
+        return m_NumBits;
+    }
+
+    size = BITS_TO_CHARS(m_NumBits);
+    i = BIT_CHAR(bit);
+
+    /* ignore bits before the starting bit */
+    value = m_Array[i] & (unsigned char)(UCHAR_MAX >> (bit % CHAR_BIT));
+    i++;
+
+    while (value == 0)
+    {
+        /* skip words that don't have any bits set */
+        while (((i + WORD_CHARS) <= size) && (LoadWord(&m_Array[i]) == 0))
+        {
+            i += WORD_CHARS;
+        }
+
+        if (i >= size)
+        {
+            return m_NumBits;
+        }
+
+        value = m_Array[i];
+        i++;
+    }
+
+    result = ((i - 1) * CHAR_BIT) + DecodeTable().position[value][0];
+    return (result < m_NumBits) ? result : m_NumBits;
+}
+
+/***************************************************************************
+*   Method     : NextClear
+*   Description: This method finds the first clear bit at or after a given
+*                bit.  It works like NextSet, skipping words and characters
+*                with every bit set.
+*   Parameters : bit - index of the first bit to examine
+*   Effects    : None
+*   Returned   : Index of the first clear bit at or after bit.  Size() if
+*                there isn't one.
+***************************************************************************/
+size_t bit_array_c::NextClear(const size_t bit) const
 {
-    int size;
+    size_t size, i, result;
+    unsigned char value;
+
+    if (bit >= m_NumBits)
+    {
+        return m_NumBits;
+    }
 
     size = BITS_TO_CHARS(m_NumBits);
+    i = BIT_CHAR(bit);
 
-    outStream.width(2);
-    outStream.fill('0');
-    outStream << uppercase << hex << (int)(m_Array[0]);  /* first byte */
+    /* look for set bits in the complement, ignoring earlier bits */
+    value = (unsigned char)~m_Array[i] &
+        (unsigned char)(UCHAR_MAX >> (bit % CHAR_BIT));
+    i++;
 
-    for (int i = 1; i < size; i++)
+    while (value == 0)
     {
-        /* remaining bytes with a leading space */
-        outStream << " ";
-        outStream.width(2);
-        outStream.fill('0');
-        outStream << (int)(m_Array[i]);
+        /* skip words that have every bit set */
+        while (((i + WORD_CHARS) <= size) &&
+            (LoadWord(&m_Array[i]) == ~(uint64_t)0))
+        {
+            i += WORD_CHARS;
+        }
+
+        if (i >= size)
+        {
+            return m_NumBits;
+        }
+
+        value = (unsigned char)~m_Array[i];
+        i++;
     }
 
-    outStream << dec;
+    /* spare bits look clear, so clamp the result to the array size */
+    result = ((i - 1) * CHAR_BIT) + DecodeTable().position[value][0];
+    return (result < m_NumBits) ? result : m_NumBits;
 }
 
 /***************************************************************************
-*   Method     : SetAll
-*   Description: This method sets every bit in the bit array to 1.  This
-*                method uses UCHAR_MAX to determine what it means to set
-*                all bits in an unsigned char, so it is crucial that the
-*                machine implementation of unsigned char utilizes all of
-*                the bits in the memory allocated for an unsigned char.
-*   Parameters : None
-*   Effects    : Each of the bits used in the bit array are set to 1.
-*                Unused (spare) bits are set to 0.
+*   Method     : FillRandom
+*   Description: This method fills the bit array with random bits, each of
+*                which is set with probability density.  The density is
+*                rounded to DENSITY_BITS binary digits 0.d1d2...dn, and each
+*                word is built from random words starting with the least
+*                significant digit: a 1 digit ORs in a new random word and
+*                a 0 digit ANDs one in.  Every OR moves the density of the
+*                word half way to 1 and every AND moves it half way to 0,
+*                so at most DENSITY_BITS random words are used per word
+*                (one for a density of 0.5).
+*   Parameters : density - probability that any bit is set
+*                rng - random number generator
+*   Effects    : All bits are replaced with random values.  Spare bits are
+*                set to 0.
 *   Returned   : None
 ***************************************************************************/
-void bit_array_c::SetAll(void)
+void bit_array_c::FillRandom(const double density, bit_random_c &rng)
 {
-    int bits, size;
-    unsigned char mask;
+    size_t size, i, digits;
+    unsigned long fraction;
+    uint64_t word;
+    int bits;
+
+    if (density <= 0.0)
+    {
+        ClearAll();
+        return;
+    }
+
+    fraction = (unsigned long)(density * (1UL << DENSITY_BITS) + 0.5);
+
+    if (fraction >= (1UL << DENSITY_BITS))
+    {
+        SetAll();
+        return;
+    }
+
+    if (fraction == 0)
+    {
+        ClearAll();
+        return;
+    }
+
+    /* trailing 0 digits don't affect the density */
+    digits = DENSITY_BITS;
+    while ((fraction & 1) == 0)
+    {
+        fraction >>= 1;
+        digits--;
+    }
 
     size = BITS_TO_CHARS(m_NumBits);
 
-    /* set bits in all bytes to 1 */
-    fill_n(m_Array, size, UCHAR_MAX);
+    for (i = 0; i < size; i += WORD_CHARS)
+    {
+        /* the least significant digit is a 1, so start with a random word */
+        word = rng.Next();
+
+        for (size_t d = 1; d < digits; d++)
+        {
+            if (fraction & (1UL << d))
+            {
+                word |= rng.Next();
+            }
+            else
+            {
+                word &= rng.Next();
+            }
+        }
+
+        if ((i + WORD_CHARS) <= size)
+        {
+            memcpy(&m_Array[i], &word, WORD_CHARS);
+        }
+        else
+        {
+            memcpy(&m_Array[i], &word, size - i);
+        }
+    }
 
     /* zero any spare bits so increment and decrement are consistent */
     bits = m_NumBits % CHAR_BIT;
     if (bits != 0)
     {
-        mask = UCHAR_MAX << (CHAR_BIT - bits);
-        m_Array[BIT_CHAR(m_NumBits - 1)] = mask;
+        m_Array[BIT_CHAR(m_NumBits - 1)] &=
+            (unsigned char)(UCHAR_MAX << (CHAR_BIT - bits));
     }
 }
 
 /***************************************************************************
-*   Method     : ClearAll
-*   Description: This method sets every bit in the bit array to 0.
-*   Parameters : None
-*   Effects    : Each of the bits in the bit array are set to 0.
-*   Returned   : None
+*   Method     : SampleSetBit
+*   Description: This method picks one of the set bits uniformly at random.
+*                A random rank is chosen from the population count and the
+*                bit with that rank is found with Select.
+*   Parameters : rng - random number generator
+*                bit - receives the index of the chosen bit
+*   Effects    : None
+*   Returned   : true if a bit was chosen.  false if no bits are set.
 ***************************************************************************/
-void bit_array_c::ClearAll(void)
+bool bit_array_c::SampleSetBit(bit_random_c &rng, size_t &bit) const
 {
-    int size;
-
-    size = BITS_TO_CHARS(m_NumBits);
+    size_t count;
 
-    /* set bits in all bytes to 0 */
-    fill_n(m_Array, size, 0);
-}
+    count = Count();
 
-/***************************************************************************
-*   Method     : SetBit
-*   Description: This method sets a bit in the bit array to 1.
-*   Parameters : bit - the number of the bit to set
-*   Effects    : The specified bit will be set to 1.
-*   Returned   : None
-***************************************************************************/
-void bit_array_c::SetBit(const unsigned int bit)
-{
-    if (m_NumBits <= bit)
+    if (count == 0)
     {
-        return;         /* bit out of range */
+        return false;
     }
 
-    m_Array[BIT_CHAR(bit)] |= BIT_IN_CHAR(bit);
+    bit = Select((size_t)rng.Below(count));
+    return true;
 }
 
 /***************************************************************************
-*   Method     : ClearBit
-*   Description: This method sets a bit in the bit array to 0.
-*   Parameters : bit - the number of the bit to clear
-*   Effects    : The specified bit will be set to 0.
-*   Returned   : None
+*   Method     : SampleK
+*   Description: This method picks k distinct set bits uniformly at random
+*                using selection sampling (Knuth's algorithm S).  The set
+*                bits are visited in order and each one is chosen with
+*                probability (still needed) / (still unvisited), so the
+*                whole sample takes one pass over the array after the
+*                population count.
+*   Parameters : k - number of bits to pick
+*                bits - array receiving the indices of the chosen bits
+*                rng - random number generator
+*   Effects    : Chosen indices are written to bits in ascending order.
+*   Returned   : Number of indices written.  This is less than k only if
+*                fewer than k bits are set, in which case every set bit is
+*                written.
 ***************************************************************************/
-void bit_array_c::ClearBit(const unsigned int bit)
+size_t bit_array_c::SampleK(const size_t k, size_t *bits,
+    bit_random_c &rng) const
 {
-    unsigned char mask;
+    const bit_decode_table_c &table = DecodeTable();
+    size_t size, i, remaining, needed, written;
+    unsigned char value;
+    int spare;
 
-    if (m_NumBits <= bit)
+    remaining = Count();
+
+    if (k >= remaining)
     {
-        return;         /* bit out of range */
+        return ToIndices(bits, remaining);
     }
 
-    /* create a mask to zero out desired bit */
-    mask =  BIT_IN_CHAR(bit);
-    mask = ~mask;
+    size = BITS_TO_CHARS(m_NumBits);
+    needed = k;
+    written = 0;
 
-    m_Array[BIT_CHAR(bit)] &= mask;
-}
+    for (i = 0; (i < size) && (needed > 0); i++)
+    {
+        value = m_Array[i];
 
-/***************************************************************************
-*   Method     : operator()
-*   Description: Overload of the () operator.  This method approximates
-*                array indices used for assignment.  It returns a
-*                bit_array_index_c which includes an = method used to
-*                set bit values.
-*   Parameters : bit - index of array bit
-*   Effects    : None
-*   Returned   : bit_array_index_c (pointer to bit)
-***************************************************************************/
-bit_array_index_c bit_array_c::operator()(const unsigned int bit)
-{
-    bit_array_index_c result(this, bit);
+        if (i == size - 1)
+        {
+            /* ignore spare bits */
+            spare = m_NumBits % CHAR_BIT;
+            if (spare != 0)
+            {
+                value &= (unsigned char)(UCHAR_MAX << (CHAR_BIT - spare));
+            }
+        }
 
-    return result;
+        for (size_t j = 0; j < table.count[value]; j++)
+        {
+            if (rng.Below(remaining) < needed)
+            {
+                bits[written] = (i * CHAR_BIT) + table.position[value][j];
+                written++;
+                needed--;
+            }
+
+            remaining--;
+        }
+    }
+
+    return written;
 }
 
 /***************************************************************************
@@ -314,7 +2201,7 @@ bit_array_index_c bit_array_c::operator()(const unsigned int bit)
 *   Effects    : None
 *   Returned   : The value of the specified bit.
 ***************************************************************************/
-bool bit_array_c::operator[](const unsigned int bit) const
+bool bit_array_c::operator[](const size_t bit) const
 {
     return((m_Array[BIT_CHAR(bit)] & BIT_IN_CHAR(bit)) != 0);
 }
@@ -414,17 +2301,221 @@ bool bit_array_c::operator>(const bit_array_c &other) const
 *   Description: overload of the >= operator
 *   Parameters : other - bit array to compare
 *   Effects    : None
-*   Returned   : True if this >= other.  Otherwise false.
+*   Returned   : True if this >= other.  Otherwise false.
+***************************************************************************/
+bool bit_array_c::operator>=(const bit_array_c &other) const
+{
+    if (m_NumBits != other.m_NumBits)
+    {
+        /* unequal sizes */
+        return false;
+    }
+
+    return (this->m_Array >= other.m_Array);
+}
+
+/***************************************************************************
+*   Method     : Any
+*   Description: This method determines if any bit in the array is set.
+*                Four words are ORed together per test so the loop
+*                vectorizes, and the search stops at the first block with
+*                a set bit.  Spare bits are ignored.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : True if at least one bit is set.  Otherwise false.
+***************************************************************************/
+bool bit_array_c::Any(void) const
+{
+    size_t i, last;
+    int bits;
+    unsigned char mask;
+
+    last = BIT_CHAR(m_NumBits - 1);         /* may have spare bits */
+
+    for (i = 0; (i + (4 * WORD_CHARS)) <= last; i += (4 * WORD_CHARS))
+    {
+        if ((LoadWord(&m_Array[i]) | LoadWord(&m_Array[i + WORD_CHARS]) |
+            LoadWord(&m_Array[i + (2 * WORD_CHARS)]) |
+            LoadWord(&m_Array[i + (3 * WORD_CHARS)])) != 0)
+        {
+            return true;
+        }
+    }
+
+    for (; i < last; i++)
+    {
+        if (m_Array[i] != 0)
+        {
+            return true;
+        }
+    }
+
+    mask = UCHAR_MAX;
+    bits = m_NumBits % CHAR_BIT;
+    if (bits != 0)
+    {
+        mask = UCHAR_MAX << (CHAR_BIT - bits);
+    }
+
+    return ((m_Array[last] & mask) != 0);
+}
+
+/***************************************************************************
+*   Method     : None
+*   Description: This method determines if no bit in the array is set.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : True if every bit is clear.  Otherwise false.
+***************************************************************************/
+bool bit_array_c::None(void) const
+{
+    return !Any();
+}
+
+/***************************************************************************
+*   Method     : All
+*   Description: This method determines if every bit in the array is set.
+*                Four words are ANDed together per test so the loop
+*                vectorizes, and the search stops at the first block with
+*                a clear bit.  Spare bits are ignored.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : True if every bit is set.  Otherwise false.
+***************************************************************************/
+bool bit_array_c::All(void) const
+{
+    size_t i, last;
+    int bits;
+    unsigned char mask;
+
+    last = BIT_CHAR(m_NumBits - 1);         /* may have spare bits */
+
+    for (i = 0; (i + (4 * WORD_CHARS)) <= last; i += (4 * WORD_CHARS))
+    {
+        if ((LoadWord(&m_Array[i]) & LoadWord(&m_Array[i + WORD_CHARS]) &
+            LoadWord(&m_Array[i + (2 * WORD_CHARS)]) &
+            LoadWord(&m_Array[i + (3 * WORD_CHARS)])) != ~(uint64_t)0)
+        {
+            return false;
+        }
+    }
+
+    for (; i < last; i++)
+    {
+        if (m_Array[i] != UCHAR_MAX)
+        {
+            return false;
+        }
+    }
+
+    mask = UCHAR_MAX;
+    bits = m_NumBits % CHAR_BIT;
+    if (bits != 0)
+    {
+        mask = UCHAR_MAX << (CHAR_BIT - bits);
+    }
+
+    return ((m_Array[last] & mask) == mask);
+}
+
+/***************************************************************************
+*   Method     : Intersects
+*   Description: This method determines if this array and another array
+*                have any set bits in common, without computing this &
+*                other.
+*   Parameters : other - bit array to compare
+*   Effects    : None
+*   Returned   : True if a bit is set in both arrays.  False if it isn't or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool bit_array_c::Intersects(const bit_array_c &other) const
+{
+    if (m_NumBits != other.m_NumBits)
+    {
+        /* unequal sizes */
+        return false;
+    }
+
+    return AnyCommonBits(m_Array, other.m_Array, m_NumBits, 0);
+}
+
+/***************************************************************************
+*   Method     : IsDisjoint
+*   Description: This method determines if this array and another array
+*                have no set bits in common.
+*   Parameters : other - bit array to compare
+*   Effects    : None
+*   Returned   : True if no bit is set in both arrays.  False if one is or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool bit_array_c::IsDisjoint(const bit_array_c &other) const
+{
+    if (m_NumBits != other.m_NumBits)
+    {
+        /* unequal sizes */
+        return false;
+    }
+
+    return !AnyCommonBits(m_Array, other.m_Array, m_NumBits, 0);
+}
+
+/***************************************************************************
+*   Method     : IsSubsetOf
+*   Description: This method determines if every bit set in this array is
+*                also set in another array, by looking for a bit in
+*                this & ~other.
+*   Parameters : other - bit array to compare
+*   Effects    : None
+*   Returned   : True if this is a subset of other.  False if it isn't or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool bit_array_c::IsSubsetOf(const bit_array_c &other) const
+{
+    if (m_NumBits != other.m_NumBits)
+    {
+        /* unequal sizes */
+        return false;
+    }
+
+    return !AnyCommonBits(m_Array, other.m_Array, m_NumBits, ~(uint64_t)0);
+}
+
+/***************************************************************************
+*   Method     : IsSupersetOf
+*   Description: This method determines if every bit set in another array
+*                is also set in this array.
+*   Parameters : other - bit array to compare
+*   Effects    : None
+*   Returned   : True if this is a superset of other.  False if it isn't or
+*                the arrays are of different sizes.
+***************************************************************************/
+bool bit_array_c::IsSupersetOf(const bit_array_c &other) const
+{
+    return other.IsSubsetOf(*this);
+}
+
+/***************************************************************************
+*   Method     : ContainsAll
+*   Description: This method determines if every bit in a list of bit
+*                indices is set.
+*   Parameters : indices - array of bit indices to test
+*                count - number of indices in the array
+*   Effects    : None
+*   Returned   : True if every listed bit is set.  False if any listed bit
+*                is clear or out of range.
 ***************************************************************************/
-bool bit_array_c::operator>=(const bit_array_c &other) const
+bool bit_array_c::ContainsAll(const size_t *indices, const size_t count) const
 {
-    if (m_NumBits != other.m_NumBits)
+    for (size_t i = 0; i < count; i++)
     {
-        /* unequal sizes */
-        return false;
+        if ((indices[i] >= m_NumBits) ||
+            ((m_Array[BIT_CHAR(indices[i])] & BIT_IN_CHAR(indices[i])) == 0))
+        {
+            return false;
+        }
     }
 
-    return (this->m_Array >= other.m_Array);
+    return true;
 }
 
 /***************************************************************************
@@ -504,7 +2595,7 @@ bit_array_c bit_array_c::operator|(const bit_array_c &other) const
 *   Effects    : None
 *   Returned   : result of bitwise left shift
 ***************************************************************************/
-bit_array_c bit_array_c::operator<<(const unsigned int count) const
+bit_array_c bit_array_c::operator<<(const size_t count) const
 {
     bit_array_c result(this->m_NumBits);
     result = *this;
@@ -521,7 +2612,7 @@ bit_array_c bit_array_c::operator<<(const unsigned int count) const
 *   Effects    : None
 *   Returned   : result of bitwise right shift
 ***************************************************************************/
-bit_array_c bit_array_c::operator>>(const unsigned int count) const
+bit_array_c bit_array_c::operator>>(const size_t count) const
 {
     bit_array_c result(this->m_NumBits);
     result = *this;
@@ -540,7 +2631,8 @@ bit_array_c bit_array_c::operator>>(const unsigned int count) const
 ***************************************************************************/
 bit_array_c& bit_array_c::operator++(void)
 {
-    int i;
+    size_t i;
+    int bits;
     unsigned char maxValue;     /* maximum value for current char */
     unsigned char one;          /* least significant bit in current char */
 
@@ -550,11 +2642,11 @@ bit_array_c& bit_array_c::operator++(void)
     }
 
     /* handle arrays that don't use every bit in the last character */
-    i = (m_NumBits % CHAR_BIT);
-    if (i != 0)
+    bits = (m_NumBits % CHAR_BIT);
+    if (bits != 0)
     {
-        maxValue = UCHAR_MAX << (CHAR_BIT - i);
-        one = 1 << (CHAR_BIT - i);
+        maxValue = UCHAR_MAX << (CHAR_BIT - bits);
+        one = 1 << (CHAR_BIT - bits);
     }
     else
     {
@@ -562,21 +2654,29 @@ bit_array_c& bit_array_c::operator++(void)
         one = 1;
     }
 
-    for (i = BIT_CHAR(m_NumBits - 1); i >= 0; i--)
+    for (i = BITS_TO_CHARS(m_NumBits); i > 0; i--)
     {
-        if (m_Array[i] != maxValue)
+        if (m_Array[i - 1] != maxValue)
         {
-            m_Array[i] = m_Array[i] + one;
+            m_Array[i - 1] = m_Array[i - 1] + one;
             return *this;
         }
         else
         {
             /* need to carry to next byte */
-            m_Array[i] = 0;
+            m_Array[i - 1] = 0;
 
             /* remaining characters must use all bits */
             maxValue = UCHAR_MAX;
             one = 1;
+
+            /* carry through whole words of ones at once */
+            while ((i > WORD_CHARS) &&
+                (LoadWord(&m_Array[i - 1 - WORD_CHARS]) == ~(uint64_t)0))
+            {
+                fill_n(&m_Array[i - 1 - WORD_CHARS], WORD_CHARS, 0);
+                i -= WORD_CHARS;
+            }
         }
     }
 
@@ -607,7 +2707,8 @@ bit_array_c& bit_array_c::operator++(int)
 ***************************************************************************/
 bit_array_c& bit_array_c::operator--(void)
 {
-    int i;
+    size_t i;
+    int bits;
     unsigned char maxValue;     /* maximum value for current char */
     unsigned char one;          /* least significant bit in current char */
 
@@ -617,11 +2718,11 @@ bit_array_c& bit_array_c::operator--(void)
     }
 
     /* handle arrays that don't use every bit in the last character */
-    i = (m_NumBits % CHAR_BIT);
-    if (i != 0)
+    bits = (m_NumBits % CHAR_BIT);
+    if (bits != 0)
     {
-        maxValue = UCHAR_MAX << (CHAR_BIT - i);
-        one = 1 << (CHAR_BIT - i);
+        maxValue = UCHAR_MAX << (CHAR_BIT - bits);
+        one = 1 << (CHAR_BIT - bits);
     }
     else
     {
@@ -629,21 +2730,29 @@ bit_array_c& bit_array_c::operator--(void)
         one = 1;
     }
 
-    for (i = BIT_CHAR(m_NumBits - 1); i >= 0; i--)
+    for (i = BITS_TO_CHARS(m_NumBits); i > 0; i--)
     {
-        if (m_Array[i] >= one)
+        if (m_Array[i - 1] >= one)
         {
-            m_Array[i] = m_Array[i] - one;
+            m_Array[i - 1] = m_Array[i - 1] - one;
             return *this;
         }
         else
         {
             /* need to borrow from the next byte */
-            m_Array[i] = maxValue;
+            m_Array[i - 1] = maxValue;
 
             /* remaining characters must use all bits */
             maxValue = UCHAR_MAX;
             one = 1;
+
+            /* borrow through whole words of zeros at once */
+            while ((i > WORD_CHARS) &&
+                (LoadWord(&m_Array[i - 1 - WORD_CHARS]) == 0))
+            {
+                fill_n(&m_Array[i - 1 - WORD_CHARS], WORD_CHARS, UCHAR_MAX);
+                i -= WORD_CHARS;
+            }
         }
     }
 
@@ -693,7 +2802,7 @@ bit_array_c& bit_array_c::operator=(const bit_array_c &src)
     }
 
     /* copy bits from source */
-    int size;
+    size_t size;
     size = BITS_TO_CHARS(m_NumBits);
 
     copy(src.m_Array, &src.m_Array[size], this->m_Array);
@@ -711,7 +2820,7 @@ bit_array_c& bit_array_c::operator=(const bit_array_c &src)
 ***************************************************************************/
 bit_array_c& bit_array_c::operator&=(const bit_array_c &src)
 {
-    int size;
+    size_t size;
 
     size = BITS_TO_CHARS(m_NumBits);
 
@@ -722,7 +2831,7 @@ bit_array_c& bit_array_c::operator&=(const bit_array_c &src)
     }
 
     /* AND array one unsigned char at a time */
-    for(int i = 0; i < size; i++)
+    for(size_t i = 0; i < size; i++)
     {
         m_Array[i] = m_Array[i] & src.m_Array[i];
     }
@@ -741,7 +2850,7 @@ bit_array_c& bit_array_c::operator&=(const bit_array_c &src)
 ***************************************************************************/
 bit_array_c& bit_array_c::operator^=(const bit_array_c &src)
 {
-    int size;
+    size_t size;
 
     size = BITS_TO_CHARS(m_NumBits);
 
@@ -752,7 +2861,7 @@ bit_array_c& bit_array_c::operator^=(const bit_array_c &src)
     }
 
     /* XOR array one unsigned char at a time */
-    for(int i = 0; i < size; i++)
+    for(size_t i = 0; i < size; i++)
     {
         m_Array[i] = m_Array[i] ^ src.m_Array[i];
     }
@@ -771,7 +2880,7 @@ bit_array_c& bit_array_c::operator^=(const bit_array_c &src)
 ***************************************************************************/
 bit_array_c& bit_array_c::operator|=(const bit_array_c &src)
 {
-    int size;
+    size_t size;
 
     size = BITS_TO_CHARS(m_NumBits);
 
@@ -782,7 +2891,7 @@ bit_array_c& bit_array_c::operator|=(const bit_array_c &src)
     }
 
     /* OR array one unsigned char at a time */
-    for(int i = 0; i < size; i++)
+    for(size_t i = 0; i < size; i++)
     {
         m_Array[i] = m_Array[i] | src.m_Array[i];
     }
@@ -790,6 +2899,115 @@ bit_array_c& bit_array_c::operator|=(const bit_array_c &src)
     return *this;
 }
 
+/***************************************************************************
+*   Method     : MixedOp
+*   Description: This method applies a bitwise operation between this
+*                array and a source array that may be a different size.
+*                The policy decides how the bits of the arrays line up and
+*                what happens to bits of this array without a source bit.
+*                Only the overlapping bits are combined, and for and the
+*                rest are cleared in bulk.
+*   Parameters : src - Source bit array
+*                policy - how arrays of different sizes are matched
+*                op - operation to apply
+*   Effects    : Results are stored in this array, which keeps its size
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::MixedOp(const bit_array_c &src,
+    const bit_size_policy_t policy, const int op)
+{
+    size_t length, destPos, srcPos;
+
+    length = min(m_NumBits, src.m_NumBits);
+    destPos = 0;
+    srcPos = 0;
+
+    if (policy == BIT_SIZE_ALIGN_RIGHT)
+    {
+        /* the last bits, which are the least significant, line up */
+        if (src.m_NumBits < m_NumBits)
+        {
+            destPos = m_NumBits - src.m_NumBits;
+        }
+        else
+        {
+            srcPos = src.m_NumBits - m_NumBits;
+        }
+    }
+
+    CombineBits(m_Array, destPos, src.m_Array, BITS_TO_CHARS(src.m_NumBits),
+        srcPos, length, (bit_op_t)op);
+
+    if ((op == BIT_OP_AND) && (policy != BIT_SIZE_TRUNCATE))
+    {
+        /* bits of this array with no source bit were anded with 0 */
+        if (destPos != 0)
+        {
+            ClearRange(m_Array, 0, destPos);
+        }
+        else
+        {
+            ClearTail(length);
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : And
+*   Description: This method performs a bitwise and between this array and
+*                a source array that may be a different size.
+*   Parameters : src - Source bit array
+*                policy - how arrays of different sizes are matched
+*                    BIT_SIZE_ZERO_EXTEND: bits line up by index and
+*                        missing source bits are 0
+*                    BIT_SIZE_TRUNCATE: bits line up by index and bits
+*                        without a source bit are unchanged
+*                    BIT_SIZE_ALIGN_RIGHT: arrays line up at their last
+*                        bits, like integers of different widths
+*   Effects    : Results of bitwise and are stored in this array
+*   Returned   : Reference to this array after and
+***************************************************************************/
+bit_array_c& bit_array_c::And(const bit_array_c &src,
+    const bit_size_policy_t policy)
+{
+    MixedOp(src, policy, BIT_OP_AND);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : Or
+*   Description: This method performs a bitwise or between this array and
+*                a source array that may be a different size.
+*   Parameters : src - Source bit array
+*                policy - how arrays of different sizes are matched (see
+*                    And)
+*   Effects    : Results of bitwise or are stored in this array
+*   Returned   : Reference to this array after or
+***************************************************************************/
+bit_array_c& bit_array_c::Or(const bit_array_c &src,
+    const bit_size_policy_t policy)
+{
+    MixedOp(src, policy, BIT_OP_OR);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : Xor
+*   Description: This method performs a bitwise xor between this array and
+*                a source array that may be a different size.
+*   Parameters : src - Source bit array
+*                policy - how arrays of different sizes are matched (see
+*                    And)
+*   Effects    : Results of bitwise xor are stored in this array
+*   Returned   : Reference to this array after xor
+***************************************************************************/
+bit_array_c& bit_array_c::Xor(const bit_array_c &src,
+    const bit_size_policy_t policy)
+{
+    MixedOp(src, policy, BIT_OP_XOR);
+    return *this;
+}
+
 /***************************************************************************
 *   Method     : Not
 *   Description: Negates all non-spare bits in bit array.
@@ -802,7 +3020,7 @@ bit_array_c& bit_array_c::Not(void)
 {
     int bits;
     unsigned char mask;
-    int size;
+    size_t size;
 
     size = BITS_TO_CHARS(m_NumBits);
 
@@ -813,7 +3031,7 @@ bit_array_c& bit_array_c::Not(void)
     }
 
     /* NOT array one unsigned char at a time */
-    for(int i = 0; i < size; i++)
+    for(size_t i = 0; i < size; i++)
     {
         m_Array[i] = ~m_Array[i];
     }
@@ -833,14 +3051,17 @@ bit_array_c& bit_array_c::Not(void)
 *   Method     : operator<<=
 *   Description: overload of the <<= operator.  Performs a left shift on
 *                this bit array.  This bit array will contain the result.
+*                Whole character and partial character shifts are combined
+*                so the array is only passed over once.
 *   Parameters : shifts - number of bit positions to shift
 *   Effects    : Results of the shifts are stored in this array
 *   Returned   : Reference to this array after shift
 ***************************************************************************/
-bit_array_c& bit_array_c::operator<<=(const unsigned int shifts)
+bit_array_c& bit_array_c::operator<<=(const size_t shifts)
 {
-    int i;
-    int chars = shifts / CHAR_BIT; /* number of whole byte shifts */
+    size_t i, size;
+    size_t chars = shifts / CHAR_BIT;   /* number of whole byte shifts */
+    int bits = shifts % CHAR_BIT;       /* remaining bit shifts */
 
     if (shifts >= m_NumBits)
     {
@@ -849,42 +3070,36 @@ bit_array_c& bit_array_c::operator<<=(const unsigned int shifts)
         return *this;
     }
 
-    /* first handle big jumps of bytes */
-    if (chars > 0)
-    {
-        int size;
-
-        size = BITS_TO_CHARS(m_NumBits);
-
-        for (i = 0; (i + chars) < size; i++)
-        {
-            m_Array[i] = m_Array[i + chars];
-        }
+    size = BITS_TO_CHARS(m_NumBits);
 
-        /* now zero out new bytes on the right */
-        for (i = size; chars > 0; chars--)
-        {
-            m_Array[i - chars] = 0;
-        }
+    if (bits == 0)
+    {
+        memmove(m_Array, &m_Array[chars], size - chars);
     }
-
-    /* now we have at most CHAR_BIT - 1 bit shifts across the whole array */
-    for (i = 0; i < (int)(shifts % CHAR_BIT); i++)
+    else
     {
-        for (unsigned int j = 0; j < BIT_CHAR(m_NumBits - 1); j++)
+        /* each word is made from the word and byte it straddles */
+        for (i = 0; (i + chars + WORD_CHARS) < size; i += WORD_CHARS)
         {
-            m_Array[j] <<= 1;
+            StoreBigEndian(&m_Array[i],
+                (LoadBigEndian(&m_Array[i + chars]) << bits) |
+                (m_Array[i + chars + WORD_CHARS] >> (CHAR_BIT - bits)));
+        }
 
-            /* handle shifts across byte bounds */
-            if (m_Array[j + 1] & MS_BIT)
-            {
-                m_Array[j] |= 0x01;
-            }
+        /* each remaining byte is made from the two bytes it straddles */
+        for (; (i + chars + 1) < size; i++)
+        {
+            m_Array[i] = (unsigned char)(m_Array[i + chars] << bits) |
+                (m_Array[i + chars + 1] >> (CHAR_BIT - bits));
         }
 
-        m_Array[BIT_CHAR(m_NumBits - 1)] <<= 1;
+        m_Array[size - chars - 1] =
+            (unsigned char)(m_Array[size - 1] << bits);
     }
 
+    /* now zero out new bytes on the right */
+    fill_n(&m_Array[size - chars], chars, 0);
+
     return *this;
 }
 
@@ -892,15 +3107,18 @@ bit_array_c& bit_array_c::operator<<=(const unsigned int shifts)
 *   Method     : operator>>=
 *   Description: overload of the >>= operator.  Performs a right shift on
 *                this bit array.  This bit array will contain the result.
+*                Whole character and partial character shifts are combined
+*                so the array is only passed over once.
 *   Parameters : shifts - number of bit positions to shift
 *   Effects    : Results of the shifts are stored in this array
 *   Returned   : Reference to this array after shift
 ***************************************************************************/
-bit_array_c& bit_array_c::operator>>=(const unsigned int shifts)
+bit_array_c& bit_array_c::operator>>=(const size_t shifts)
 {
-    int i;
-    char mask;
-    int chars = shifts / CHAR_BIT;  /* number of whole byte shifts */
+    size_t i, size;
+    unsigned char mask;
+    size_t chars = shifts / CHAR_BIT;   /* number of whole byte shifts */
+    int bits = shifts % CHAR_BIT;       /* remaining bit shifts */
 
     if (shifts >= m_NumBits)
     {
@@ -909,52 +3127,413 @@ bit_array_c& bit_array_c::operator>>=(const unsigned int shifts)
         return *this;
     }
 
-    /* first handle big jumps of bytes */
-    if (chars > 0)
-    {
-        for (i = BIT_CHAR(m_NumBits - 1); (i - chars) >= 0; i--)
-        {
-            m_Array[i] = m_Array[i - chars];
-        }
+    size = BITS_TO_CHARS(m_NumBits);
 
-        /* now zero out new bytes on the right */
-        for (; chars > 0; chars--)
-        {
-            m_Array[chars - 1] = 0;
-        }
+    if (bits == 0)
+    {
+        memmove(&m_Array[chars], m_Array, size - chars);
     }
-
-    /* now we have at most CHAR_BIT - 1 bit shifts across the whole array */
-    for (i = 0; i < (int)(shifts % CHAR_BIT); i++)
+    else
     {
-        for (unsigned int j = BIT_CHAR(m_NumBits - 1); j > 0; j--)
+        /* each word is made from the word and byte it straddles */
+        for (i = size; i > (chars + WORD_CHARS); i -= WORD_CHARS)
         {
-            m_Array[j] >>= 1;
+            StoreBigEndian(&m_Array[i - WORD_CHARS],
+                (LoadBigEndian(&m_Array[i - WORD_CHARS - chars]) >> bits) |
+                ((uint64_t)m_Array[i - WORD_CHARS - chars - 1] <<
+                (64 - bits)));
+        }
 
-            /* handle shifts across byte bounds */
-            if (m_Array[j - 1] & 0x01)
-            {
-                m_Array[j] |= MS_BIT;
-            }
+        /* each remaining byte is made from the two bytes it straddles */
+        for (i = i - 1; i > chars; i--)
+        {
+            m_Array[i] = (m_Array[i - chars] >> bits) |
+                (unsigned char)(m_Array[i - chars - 1] << (CHAR_BIT - bits));
         }
 
-        m_Array[0] >>= 1;
+        m_Array[chars] = m_Array[0] >> bits;
     }
 
+    /* now zero out new bytes on the left */
+    fill_n(m_Array, chars, 0);
+
     /***********************************************************************
     * zero any spare bits that are shifted beyond the end of the bit array
     * so that increment and decrement are consistent.
     ***********************************************************************/
-    i = m_NumBits % CHAR_BIT;
-    if (i != 0)
+    bits = m_NumBits % CHAR_BIT;
+    if (bits != 0)
     {
-        mask = UCHAR_MAX << (CHAR_BIT - i);
+        mask = UCHAR_MAX << (CHAR_BIT - bits);
         m_Array[BIT_CHAR(m_NumBits - 1)] &= mask;
     }
 
     return *this;
 }
 
+/***************************************************************************
+*   Method     : operator/=
+*   Description: overload of the /= operator.  Treats this array and the
+*                divisor as unsigned integers, with the last bit the least
+*                significant as it is for ++ and --, and performs long
+*                division a 32 bit limb at a time.  The arrays may be
+*                different sizes.
+*   Parameters : divisor - bit array holding the divisor
+*   Effects    : This array holds the quotient
+*   Returned   : Reference to this array after division
+***************************************************************************/
+bit_array_c& bit_array_c::operator/=(const bit_array_c &divisor)
+{
+    bit_limbs_t u, v, q, r;
+
+    ToLimbs(divisor.m_Array, divisor.m_NumBits, v);
+
+    if (v.empty())
+    {
+        throw domain_error("Error: Bit Array division by zero.");
+    }
+
+    ToLimbs(m_Array, m_NumBits, u);
+    DivideLimbs(u, v, q, r);
+    FromLimbs(q, m_Array, m_NumBits);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : operator%=
+*   Description: overload of the %= operator.  Treats this array and the
+*                divisor as unsigned integers and replaces this array with
+*                the remainder of long division.  The arrays may be
+*                different sizes.  Use bit_barrett_c when the same divisor
+*                is used repeatedly.
+*   Parameters : divisor - bit array holding the divisor
+*   Effects    : This array holds the remainder
+*   Returned   : Reference to this array after modulo
+***************************************************************************/
+bit_array_c& bit_array_c::operator%=(const bit_array_c &divisor)
+{
+    bit_limbs_t u, v, q, r;
+
+    ToLimbs(divisor.m_Array, divisor.m_NumBits, v);
+
+    if (v.empty())
+    {
+        throw domain_error("Error: Bit Array division by zero.");
+    }
+
+    ToLimbs(m_Array, m_NumBits, u);
+    DivideLimbs(u, v, q, r);
+    FromLimbs(r, m_Array, m_NumBits);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : DivideSmall
+*   Description: This method divides the unsigned integer held in this
+*                array by a divisor that fits in 32 bits, using a single
+*                pass of short division.
+*   Parameters : divisor - value to divide by
+*   Effects    : This array holds the quotient
+*   Returned   : Remainder of the division
+***************************************************************************/
+uint32_t bit_array_c::DivideSmall(const uint32_t divisor)
+{
+    bit_limbs_t x;
+    uint32_t rem;
+
+    if (divisor == 0)
+    {
+        throw domain_error("Error: Bit Array division by zero.");
+    }
+
+    ToLimbs(m_Array, m_NumBits, x);
+    rem = DivideSmallLimbs(x, divisor);
+    FromLimbs(x, m_Array, m_NumBits);
+    return rem;
+}
+
+/***************************************************************************
+*   Method     : ModSmall
+*   Description: This method computes the remainder of dividing the
+*                unsigned integer held in this array by a divisor that
+*                fits in 32 bits.  The array isn't changed.
+*   Parameters : divisor - value to divide by
+*   Effects    : None
+*   Returned   : Remainder of the division
+***************************************************************************/
+uint32_t bit_array_c::ModSmall(const uint32_t divisor) const
+{
+    bit_limbs_t x;
+    uint64_t rem;
+
+    if (divisor == 0)
+    {
+        throw domain_error("Error: Bit Array division by zero.");
+    }
+
+    ToLimbs(m_Array, m_NumBits, x);
+    rem = 0;
+
+    for (size_t i = x.size(); i-- > 0;)
+    {
+        rem = ((rem << 32) | x[i]) % divisor;
+    }
+
+    return (uint32_t)rem;
+}
+
+/***************************************************************************
+*   Method     : ToDecimalString
+*   Description: This method returns the unsigned integer held in this
+*                array as a string of decimal digits.  The value is split
+*                recursively by powers of ten, so most of the division is
+*                done on short numbers.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Decimal digits of the value, without leading zeros
+***************************************************************************/
+string bit_array_c::ToDecimalString(void) const
+{
+    bit_limbs_t x;
+    vector<bit_limbs_t> powers;
+    string out;
+
+    ToLimbs(m_Array, m_NumBits, x);
+
+    if (x.empty())
+    {
+        return string("0");
+    }
+
+    /* powers[i] = 10^(9 * 2^i), up to the first one larger than x */
+    powers.push_back(bit_limbs_t(1, DECIMAL_LIMB));
+
+    while (CompareLimbs(powers.back(), x) <= 0)
+    {
+        bit_limbs_t square;
+
+        MultiplyLimbs(powers.back(), powers.back(), square);
+        powers.push_back(square);
+    }
+
+    LimbsToDecimal(x, powers, powers.size() - 1, 0, out);
+    return out;
+}
+
+/***************************************************************************
+*   Method     : FromDecimalString
+*   Description: This method sets this array to the unsigned integer
+*                written as a string of decimal digits.  The string is
+*                split recursively, and the halves are joined with a
+*                multiplication by a power of ten.  Values too large for
+*                the array wrap around, as they do with ++.
+*   Parameters : str - decimal digits, most significant first
+*   Effects    : This array holds the value modulo 2^Size()
+*   Returned   : None
+***************************************************************************/
+void bit_array_c::FromDecimalString(const string &str)
+{
+    bit_limbs_t x;
+    vector<bit_limbs_t> powers;
+
+    if (str.empty() ||
+        (str.find_first_not_of("0123456789") != string::npos))
+    {
+        throw invalid_argument("Error: Invalid decimal string.");
+    }
+
+    /* powers[i] = 10^(9 * 2^i), up to the split of the whole string */
+    powers.push_back(bit_limbs_t(1, DECIMAL_LIMB));
+
+    while (((size_t)DECIMAL_LIMB_DIGITS << powers.size()) < str.size())
+    {
+        bit_limbs_t square;
+
+        MultiplyLimbs(powers.back(), powers.back(), square);
+        powers.push_back(square);
+    }
+
+    DecimalToLimbs(str.data(), str.size(), powers, x);
+    FromLimbs(x, m_Array, m_NumBits);
+}
+
+/***************************************************************************
+*   Method     : bit_array_slice_c - constructor
+*   Description: This is the bit_array_slice_c constructor.  It stores a
+*                pointer to the bit array and the range of bits viewed,
+*                clipped to the end of the array.
+*   Parameters : array - bit array being viewed
+*                pos - index of the first bit in the view
+*                length - number of bits in the view
+*   Effects    : Pointer to bit array and range are stored.
+*   Returned   : None
+***************************************************************************/
+bit_array_slice_c::bit_array_slice_c(const bit_array_c &array,
+    const size_t pos, const size_t length):
+    m_BitArray(&array),
+    m_Pos(min(pos, array.Size())),
+    m_Length(min(length, array.Size() - m_Pos))
+{
+}
+
+/***************************************************************************
+*   Method     : Count
+*   Description: This method counts the set bits in the view.  The viewed
+*                bits are shifted into words on the fly and counted a word
+*                at a time.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Number of set bits in the view
+***************************************************************************/
+size_t bit_array_slice_c::Count(void) const
+{
+    size_t chars, done, count;
+    uint64_t word;
+
+    chars = BITS_TO_CHARS(m_BitArray->Size());
+    count = 0;
+
+    for (done = 0; done < m_Length; done += (WORD_CHARS * CHAR_BIT))
+    {
+        word = LoadBits(m_BitArray->Chars(), chars, m_Pos + done);
+
+        if ((m_Length - done) < (WORD_CHARS * CHAR_BIT))
+        {
+            /* ignore bits past the end of the view */
+            word &= ~(~(uint64_t)0 >> (m_Length - done));
+        }
+
+        count += PopCount(word);
+    }
+
+    return count;
+}
+
+/***************************************************************************
+*   Method     : operator[]
+*   Description: Overload of the [] operator.  This method returns the
+*                value of a bit in the view.
+*   Parameters : bit - index of bit in the view
+*   Effects    : None
+*   Returned   : The value of the specified bit.  false if the bit is out
+*                of range.
+***************************************************************************/
+bool bit_array_slice_c::operator[](const size_t bit) const
+{
+    if (bit >= m_Length)
+    {
+        return false;
+    }
+
+    return (*m_BitArray)[m_Pos + bit];
+}
+
+/***************************************************************************
+*   Method     : CopyTo
+*   Description: This method copies the viewed bits into a bit array at
+*                word speed.
+*   Parameters : dest - array receiving the bits
+*                destPos - index in dest that receives the first bit
+*   Effects    : Bits of dest starting at destPos are replaced.  The copy
+*                is clipped to the end of dest.
+*   Returned   : None
+***************************************************************************/
+void bit_array_slice_c::CopyTo(bit_array_c &dest, const size_t destPos) const
+{
+    dest.CopyRange(*m_BitArray, m_Pos, m_Length, destPos);
+}
+
+/***************************************************************************
+*   Method     : bit_barrett_c - constructor
+*   Description: This is the bit_barrett_c constructor.  It stores the
+*                divisor and precomputes the Barrett constant
+*                floor(2^(64k) / divisor), where the divisor has k limbs.
+*   Parameters : divisor - bit array holding the divisor
+*   Effects    : Divisor and constant are stored.
+*   Returned   : None
+***************************************************************************/
+bit_barrett_c::bit_barrett_c(const bit_array_c &divisor):
+    m_Divisor(NULL),
+    m_Mu(NULL)
+{
+    bit_limbs_t m, u, mu, r;
+
+    ToLimbs(divisor.Chars(), divisor.Size(), m);
+
+    if (m.empty())
+    {
+        throw domain_error("Error: Bit Array division by zero.");
+    }
+
+    u.assign((2 * m.size()) + 1, 0);
+    u.back() = 1;
+    DivideLimbs(u, m, mu, r);
+
+    m_DivisorLimbs = m.size();
+    m_MuLimbs = mu.size();
+    m_Divisor = new uint32_t[m_DivisorLimbs];
+    m_Mu = new uint32_t[m_MuLimbs];
+    copy(m.begin(), m.end(), m_Divisor);
+    copy(mu.begin(), mu.end(), m_Mu);
+}
+
+/***************************************************************************
+*   Method     : ~bit_barrett_c - destructor
+*   Description: This is the bit_barrett_c destructor.  It frees the
+*                stored divisor and Barrett constant.
+*   Parameters : None
+*   Effects    : Divisor and constant are freed
+*   Returned   : None
+***************************************************************************/
+bit_barrett_c::~bit_barrett_c(void)
+{
+    delete[] m_Divisor;
+    delete[] m_Mu;
+}
+
+/***************************************************************************
+*   Method     : Reduce
+*   Description: This method replaces the unsigned integer held in a bit
+*                array with its remainder modulo the divisor.  Values with
+*                more than twice the divisor's limbs are reduced one
+*                divisor sized chunk at a time, from the most significant
+*                end.
+*   Parameters : value - bit array holding the value to reduce
+*   Effects    : value holds value % divisor
+*   Returned   : None
+***************************************************************************/
+void bit_barrett_c::Reduce(bit_array_c &value) const
+{
+    size_t k, start, end;
+    bit_limbs_t m, mu, x, r;
+
+    m.assign(m_Divisor, m_Divisor + m_DivisorLimbs);
+    mu.assign(m_Mu, m_Mu + m_MuLimbs);
+    k = m_DivisorLimbs;
+
+    ToLimbs(value.Chars(), value.Size(), x);
+
+    if (CompareLimbs(x, m) < 0)
+    {
+        return;
+    }
+
+    /* r = (r * 2^(32k)) + next chunk, which stays below 2^(64k) */
+    end = x.size();
+    start = end - (((end - 1) % k) + 1);
+
+    while (end > 0)
+    {
+        r.insert(r.begin(), x.begin() + start, x.begin() + end);
+        TrimLimbs(r);
+        BarrettReduce(r, m, mu);
+        end = start;
+        start -= min(start, k);
+    }
+
+    FromLimbs(r, value.Chars(), value.Size());
+}
+
 /***************************************************************************
 *   Method     : bit_array_index_c - constructor
 *   Description: This is the bit_array_index_c constructor.  It stores a
@@ -965,7 +3544,7 @@ bit_array_c& bit_array_c::operator>>=(const unsigned int shifts)
 *   Returned   : None
 ***************************************************************************/
 bit_array_index_c::bit_array_index_c(bit_array_c *array,
-    const unsigned int index)
+    const size_t index)
 {
     m_BitArray = array;
     m_Index = index;
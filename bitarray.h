@@ -67,48 +67,100 @@
 /***************************************************************************
 *                             INCLUDED FILES
 ***************************************************************************/
+#include <cstddef>
+#include <istream>
 #include <ostream>
+#include <string>
+#include <stdint.h>
 
 /***************************************************************************
 *                            TYPE DEFINITIONS
 ***************************************************************************/
 class bit_array_c;
+class bit_array_slice_c;
+
+/* how the vector storing a bit array was allocated */
+typedef enum
+{
+    BIT_ALLOC_NEW,              /* new[], passed in by the caller */
+    BIT_ALLOC_CALLOC,           /* calloc */
+    BIT_ALLOC_MMAP              /* anonymous mmap */
+} bit_alloc_t;
+
+/* how bits line up in operations on arrays of different sizes */
+typedef enum
+{
+    BIT_SIZE_ZERO_EXTEND,       /* by index, missing bits are 0 */
+    BIT_SIZE_TRUNCATE,          /* by index, only overlapping bits change */
+    BIT_SIZE_ALIGN_RIGHT        /* last bits line up, like integers */
+} bit_size_policy_t;
+
+class bit_random_c;
 
 class bit_array_index_c
 {
     public:
-        bit_array_index_c(bit_array_c *array, const unsigned int index);
+        bit_array_index_c(bit_array_c *array, const size_t index);
 
         /* assignment */
         void operator=(const bool src);
 
     private:
         bit_array_c *m_BitArray;        /* array index applies to */
-        unsigned int m_Index;           /* index of bit in array */
+        size_t m_Index;                 /* index of bit in array */
 };
 
 class bit_array_c
 {
     public:
-        bit_array_c(const int numBits);
-        bit_array_c(unsigned char *array, const int numBits);
+        bit_array_c(const size_t numBits);
+        bit_array_c(unsigned char *array, const size_t numBits);
+        bit_array_c(std::istream &inStream);   /* from Serialize */
 
         virtual ~bit_array_c(void);
 
         void Dump(std::ostream &outStream);
+        void Serialize(std::ostream &outStream) const;
+
+        size_t Size() const { return m_NumBits; };
+        size_t Count(void) const;       /* number of set bits */
 
-        unsigned int Size() const { return m_NumBits; };
+        /* packed bits, MSB first; spare bits of the last char must stay 0 */
+        const unsigned char *Chars(void) const { return m_Array; };
+        unsigned char *Chars(void) { return m_Array; };
 
         /* set/clear functions */
         void SetAll(void);
         void ClearAll(void);
-        void SetBit(const unsigned int bit);
-        void ClearBit(const unsigned int bit);
+        void SetBit(const size_t bit);
+        void ClearBit(const size_t bit);
+        void SetRange(const size_t first, const size_t length);
+
+        bit_array_index_c operator()(const size_t bit);
+
+        /* sub-ranges, concatenation and splitting */
+        bit_array_slice_c Slice(const size_t pos, const size_t length) const;
+        void CopyRange(const bit_array_c &src, const size_t srcPos,
+            const size_t length, const size_t destPos);
+        size_t Concat(const bit_array_c *const *arrays, const size_t count);
+        void Split(const size_t *positions, const size_t count,
+            bit_array_c *const *pieces) const;
 
-        bit_array_index_c operator()(const unsigned int bit);
+        /* conversion to/from lists of bit indices */
+        void FromIndices(const size_t *indices, const size_t count,
+            const bool sorted);
+        size_t ToIndices(size_t *indices, const size_t maxCount) const;
+        size_t Select(const size_t rank) const;
+        size_t NextSet(const size_t bit) const;
+        size_t NextClear(const size_t bit) const;
+
+        /* random fill and sampling */
+        void FillRandom(const double density, bit_random_c &rng);
+        bool SampleSetBit(bit_random_c &rng, size_t &bit) const;
+        size_t SampleK(const size_t k, size_t *bits, bit_random_c &rng) const;
 
         /* boolean operator */
-        bool operator[](const unsigned int bit) const;
+        bool operator[](const size_t bit) const;
         bool operator==(const bit_array_c &other) const;
         bool operator!=(const bit_array_c &other) const;
         bool operator<(const bit_array_c &other) const;
@@ -116,14 +168,25 @@ class bit_array_c
         bool operator>(const bit_array_c &other) const;
         bool operator>=(const bit_array_c &other) const;
 
+        bool Any(void) const;                   /* any bit set */
+        bool None(void) const;                  /* no bits set */
+        bool All(void) const;                   /* every bit set */
+
+        /* set relations (no temporaries, stop at the deciding word) */
+        bool Intersects(const bit_array_c &other) const;
+        bool IsDisjoint(const bit_array_c &other) const;
+        bool IsSubsetOf(const bit_array_c &other) const;
+        bool IsSupersetOf(const bit_array_c &other) const;
+        bool ContainsAll(const size_t *indices, const size_t count) const;
+
         /* bitwise operators */
         bit_array_c operator&(const bit_array_c &other) const;
         bit_array_c operator^(const bit_array_c &other) const;
         bit_array_c operator|(const bit_array_c &other) const;
         bit_array_c operator~(void) const;
 
-        bit_array_c operator<<(const unsigned int count) const;
-        bit_array_c operator>>(const unsigned int count) const;
+        bit_array_c operator<<(const size_t count) const;
+        bit_array_c operator>>(const size_t count) const;
 
         /* increment/decrement */
         bit_array_c& operator++(void);          /* prefix */
@@ -131,6 +194,16 @@ class bit_array_c
         bit_array_c& operator--(void);          /* prefix */
         bit_array_c& operator--(int);           /* postfix */
 
+        /* unsigned integer division, the last bit is least significant */
+        bit_array_c& operator/=(const bit_array_c &divisor);
+        bit_array_c& operator%=(const bit_array_c &divisor);
+        uint32_t DivideSmall(const uint32_t divisor);   /* returns rem */
+        uint32_t ModSmall(const uint32_t divisor) const;
+
+        /* conversion to/from decimal strings */
+        std::string ToDecimalString(void) const;
+        void FromDecimalString(const std::string &str);
+
         /* assignments */
         bit_array_c& operator=(const bit_array_c &src);
 
@@ -139,12 +212,66 @@ class bit_array_c
         bit_array_c& operator|=(const bit_array_c &src);
         bit_array_c& Not(void);                 /* negate (~=) */
 
-        bit_array_c& operator<<=(unsigned const int shifts);
-        bit_array_c& operator>>=(unsigned const int shifts);
+        /* bitwise operations with arrays of different sizes */
+        bit_array_c& And(const bit_array_c &src,
+            const bit_size_policy_t policy);
+        bit_array_c& Or(const bit_array_c &src,
+            const bit_size_policy_t policy);
+        bit_array_c& Xor(const bit_array_c &src,
+            const bit_size_policy_t policy);
+
+        bit_array_c& operator<<=(const size_t shifts);
+        bit_array_c& operator>>=(const size_t shifts);
 
     protected:
-        unsigned int m_NumBits;                 /* number of bits in the array */
+        void Allocate(void);
+        void Free(void);
+        void ClearTail(const size_t bit);
+        void MixedOp(const bit_array_c &src, const bit_size_policy_t policy,
+            const int op);
+
+        size_t m_NumBits;               /* number of bits in the array */
         unsigned char *m_Array;                 /* vector of characters */
+        bit_alloc_t m_Alloc;                    /* how m_Array was allocated */
+};
+
+/* read only view of a range of bits in a bit_array_c */
+class bit_array_slice_c
+{
+    public:
+        bit_array_slice_c(const bit_array_c &array, const size_t pos,
+            const size_t length);
+
+        size_t Size() const { return m_Length; };
+        size_t Count(void) const;
+
+        bool operator[](const size_t bit) const;
+        void CopyTo(bit_array_c &dest, const size_t destPos) const;
+
+    private:
+        const bit_array_c *m_BitArray;  /* array the view is of */
+        size_t m_Pos;                   /* first bit of the view */
+        size_t m_Length;                /* number of bits in the view */
+};
+
+/* remainders modulo a fixed divisor using Barrett reduction */
+class bit_barrett_c
+{
+    public:
+        bit_barrett_c(const bit_array_c &divisor);
+        virtual ~bit_barrett_c(void);
+
+        void Reduce(bit_array_c &value) const;  /* value %= divisor */
+
+    private:
+        /* reducers can't be copied */
+        bit_barrett_c(const bit_barrett_c &);
+        bit_barrett_c& operator=(const bit_barrett_c &);
+
+        uint32_t *m_Divisor;            /* divisor limbs, low limb first */
+        size_t m_DivisorLimbs;          /* number of divisor limbs */
+        uint32_t *m_Mu;                 /* Barrett constant limbs */
+        size_t m_MuLimbs;               /* number of constant limbs */
 };
 
 #endif  /* ndef BIT_ARRAY_H */
@@ -0,0 +1,538 @@
+/***************************************************************************
+*                              Bit Matrix
+*
+*   File    : bitmatrix.cpp
+*   Purpose : Provides a matrix of bits.  Each row starts on a 64 bit
+*             word boundary of a bit array and its unused bits stay 0, so
+*             rows can be processed a word at a time.
+*
+*             XnorMultiply is the matrix product used by binarized neural
+*             networks.  Bits stand for +1 (1) and -1 (0), so the dot
+*             product of two rows of n bits is the number of equal bits
+*             minus the number of unequal bits, n - 2 * popcount(a ^ b),
+*             that is popcount(XNOR) scaled to [-n, n].  The second matrix
+*             holds the columns of the right hand operand as rows (for a
+*             layer, one row of weights per output), so both operands are
+*             read along rows.
+*
+*             The product is blocked like a GEMM.  The kernel computes a
+*             TILE_A x TILE_B tile of products, loading each word of the
+*             TILE_A + TILE_B rows once and reusing it for TILE_B or
+*             TILE_A of the tile's popcounts.  Rows of the second matrix
+*             are processed a block of about BLOCK_BYTES at a time so the
+*             block stays in cache while every row of the first matrix is
+*             multiplied by it, and the rows of the first matrix are split
+*             among threads.
+*
+*             NearestRows uses the same kernel and blocking, through the
+*             shared WalkTiles loop, to find the closest row of another
+*             matrix for every row, keeping the best row found so far
+*             instead of storing every product.
+*
+*             When PopCount isn't a single instruction (see bitwords.h),
+*             the kernel uses a carry-save adder (the first step of the
+*             Harley-Seal popcount) to combine two words of each product
+*             into one word of carries before counting, halving the
+*             number of software popcounts.  Build with -mpopcnt or
+*             -march=native to use the instruction.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "bitmatrix.h"
+#include "bitwords.h"
+#include "parallel.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* bits in the words rows are padded to */
+#define WORD_BITS             64
+
+/* rows of each matrix handled by one call to the kernel */
+#define TILE_A                2
+#define TILE_B                4
+
+/* bytes of the second matrix processed together to stay in cache */
+#define BLOCK_BYTES           32768
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : XnorTile
+*   Description: This function computes a TILE_A x TILE_B tile of XNOR
+*                dot products.
+*   Parameters : a - array of TILE_A pointers to rows of the first matrix
+*                b - array of TILE_B pointers to rows of the second matrix
+*                    (repeated pointers are allowed in both)
+*                words - 64 bit words in a row
+*                differ - TILE_A x TILE_B array receiving the number of
+*                    bits that differ in each pair of rows
+*   Effects    : differ is written
+*   Returned   : None
+***************************************************************************/
+static void XnorTile(const unsigned char *const *a,
+    const unsigned char *const *b, const size_t words,
+    size_t differ[TILE_A][TILE_B])
+{
+    size_t k;
+
+    for (int i = 0; i < TILE_A; i++)
+    {
+        for (int j = 0; j < TILE_B; j++)
+        {
+            differ[i][j] = 0;
+        }
+    }
+
+    k = 0;
+
+#if !HARDWARE_POPCOUNT
+    {
+        uint64_t ones[TILE_A][TILE_B];
+
+        for (int i = 0; i < TILE_A; i++)
+        {
+            for (int j = 0; j < TILE_B; j++)
+            {
+                ones[i][j] = 0;
+            }
+        }
+
+        for (; (k + 2) <= words; k += 2)
+        {
+            uint64_t a0[TILE_A], a1[TILE_A];
+
+            for (int i = 0; i < TILE_A; i++)
+            {
+                a0[i] = LoadWord(&a[i][k * sizeof(uint64_t)]);
+                a1[i] = LoadWord(&a[i][(k + 1) * sizeof(uint64_t)]);
+            }
+
+            for (int j = 0; j < TILE_B; j++)
+            {
+                uint64_t b0, b1;
+
+                b0 = LoadWord(&b[j][k * sizeof(uint64_t)]);
+                b1 = LoadWord(&b[j][(k + 1) * sizeof(uint64_t)]);
+
+                for (int i = 0; i < TILE_A; i++)
+                {
+                    uint64_t x0, x1, sum, twos;
+
+                    /* ones + x0 + x1 = 2 * twos + new ones */
+                    x0 = a0[i] ^ b0;
+                    x1 = a1[i] ^ b1;
+                    sum = ones[i][j] ^ x0;
+                    twos = (ones[i][j] & x0) | (sum & x1);
+                    ones[i][j] = sum ^ x1;
+                    differ[i][j] += 2 * PopCount(twos);
+                }
+            }
+        }
+
+        for (int i = 0; i < TILE_A; i++)
+        {
+            for (int j = 0; j < TILE_B; j++)
+            {
+                differ[i][j] += PopCount(ones[i][j]);
+            }
+        }
+    }
+#endif
+
+    for (; k < words; k++)
+    {
+        uint64_t aWord[TILE_A];
+
+        for (int i = 0; i < TILE_A; i++)
+        {
+            aWord[i] = LoadWord(&a[i][k * sizeof(uint64_t)]);
+        }
+
+        for (int j = 0; j < TILE_B; j++)
+        {
+            uint64_t bWord = LoadWord(&b[j][k * sizeof(uint64_t)]);
+
+            for (int i = 0; i < TILE_A; i++)
+            {
+                differ[i][j] += PopCount(aWord[i] ^ bWord);
+            }
+        }
+    }
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : bit_matrix_c - constructor
+*   Description: This is the bit_matrix_c constructor.  It allocates a
+*                matrix with every bit 0.
+*   Parameters : rows - number of rows
+*                cols - number of columns
+*   Effects    : Allocates the matrix
+*   Returned   : None
+***************************************************************************/
+bit_matrix_c::bit_matrix_c(const size_t rows, const size_t cols):
+    m_Bits(rows * (((cols + WORD_BITS - 1) / WORD_BITS) * WORD_BITS)),
+    m_Rows(rows),
+    m_Cols(cols),
+    m_RowWords((cols + WORD_BITS - 1) / WORD_BITS)
+{
+}
+
+/***************************************************************************
+*   Method     : ~bit_matrix_c - destructor
+*   Description: This is the bit_matrix_c destructor.  At this point it's
+*                just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+bit_matrix_c::~bit_matrix_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : RowChars
+*   Description: These methods return the unsigned chars of a row.
+*   Parameters : row - row number
+*   Effects    : None
+*   Returned   : Pointer to the first unsigned char of the row
+***************************************************************************/
+const unsigned char *bit_matrix_c::RowChars(const size_t row) const
+{
+    return &m_Bits.Chars()[row * m_RowWords * sizeof(uint64_t)];
+}
+
+unsigned char *bit_matrix_c::RowChars(const size_t row)
+{
+    return &m_Bits.Chars()[row * m_RowWords * sizeof(uint64_t)];
+}
+
+/***************************************************************************
+*   Method     : BlockRows
+*   Description: This method returns the number of rows, a multiple of
+*                TILE_B, in a block of about BLOCK_BYTES.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Rows in a cache block
+***************************************************************************/
+size_t bit_matrix_c::BlockRows(void) const
+{
+    size_t rows;
+
+    rows = BLOCK_BYTES / (m_RowWords * sizeof(uint64_t));
+    return max((size_t)TILE_B, rows - (rows % TILE_B));
+}
+
+/***************************************************************************
+*   Method     : WalkTiles
+*   Description: This method computes the differing bits of rows begin
+*                through end - 1 of this matrix and every row of another
+*                matrix, a tile at a time.  Rows of the other matrix are
+*                taken a cache block at a time, and short tiles at the
+*                ends repeat their first row so the kernel always sees
+*                full tiles.
+*   Parameters : other - second matrix, with the same number of columns
+*                begin - first row of this matrix
+*                end - one past the last row of this matrix
+*                visit - called as visit(i, tileA, j, tileB, differ) for
+*                    each tile, where differ[r][c] is the number of bits
+*                    that differ in rows i + r of this matrix and j + c of
+*                    other, for r < tileA and c < tileB
+*   Effects    : visit is called for every tile
+*   Returned   : None
+***************************************************************************/
+template <typename visit_t>
+void bit_matrix_c::WalkTiles(const bit_matrix_c &other, const size_t begin,
+    const size_t end, visit_t visit) const
+{
+    const unsigned char *a[TILE_A], *b[TILE_B];
+    size_t differ[TILE_A][TILE_B];
+    size_t blockRows;
+
+    blockRows = other.BlockRows();
+
+    for (size_t block = 0; block < other.m_Rows; block += blockRows)
+    {
+        size_t blockEnd = min(other.m_Rows, block + blockRows);
+
+        for (size_t i = begin; i < end; i += TILE_A)
+        {
+            size_t tileA = min((size_t)TILE_A, end - i);
+
+            /* short tiles repeat their first row */
+            for (size_t r = 0; r < TILE_A; r++)
+            {
+                a[r] = RowChars(i + ((r < tileA) ? r : 0));
+            }
+
+            for (size_t j = block; j < blockEnd; j += TILE_B)
+            {
+                size_t tileB = min((size_t)TILE_B, blockEnd - j);
+
+                for (size_t r = 0; r < TILE_B; r++)
+                {
+                    b[r] = other.RowChars(j + ((r < tileB) ? r : 0));
+                }
+
+                XnorTile(a, b, m_RowWords, differ);
+                visit(i, tileA, j, tileB, differ);
+            }
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method sets every bit in the matrix to 0.
+*   Parameters : None
+*   Effects    : All bits are cleared
+*   Returned   : None
+***************************************************************************/
+void bit_matrix_c::ClearAll(void)
+{
+    m_Bits.ClearAll();
+}
+
+/***************************************************************************
+*   Method     : SetBit
+*   Description: This method sets a bit of the matrix to 1.  Bits outside
+*                the matrix are ignored.
+*   Parameters : row - row of the bit
+*                col - column of the bit
+*   Effects    : The bit is set
+*   Returned   : None
+***************************************************************************/
+void bit_matrix_c::SetBit(const size_t row, const size_t col)
+{
+    if ((row < m_Rows) && (col < m_Cols))
+    {
+        m_Bits.SetBit((row * m_RowWords * WORD_BITS) + col);
+    }
+}
+
+/***************************************************************************
+*   Method     : ClearBit
+*   Description: This method sets a bit of the matrix to 0.  Bits outside
+*                the matrix are ignored.
+*   Parameters : row - row of the bit
+*                col - column of the bit
+*   Effects    : The bit is cleared
+*   Returned   : None
+***************************************************************************/
+void bit_matrix_c::ClearBit(const size_t row, const size_t col)
+{
+    if ((row < m_Rows) && (col < m_Cols))
+    {
+        m_Bits.ClearBit((row * m_RowWords * WORD_BITS) + col);
+    }
+}
+
+/***************************************************************************
+*   Method     : Get
+*   Description: This method returns the value of a bit of the matrix.
+*   Parameters : row - row of the bit
+*                col - column of the bit
+*   Effects    : None
+*   Returned   : The bit's value, false for bits outside the matrix
+***************************************************************************/
+bool bit_matrix_c::Get(const size_t row, const size_t col) const
+{
+    if ((row >= m_Rows) || (col >= m_Cols))
+    {
+        return false;
+    }
+
+    return m_Bits[(row * m_RowWords * WORD_BITS) + col];
+}
+
+/***************************************************************************
+*   Method     : SetRow
+*   Description: This method copies the first Cols() bits of a bit array
+*                into a row.  Rows outside the matrix are ignored.
+*   Parameters : row - row number
+*                src - bit array of at least Cols() bits
+*   Effects    : The row is replaced
+*   Returned   : None
+***************************************************************************/
+void bit_matrix_c::SetRow(const size_t row, const bit_array_c &src)
+{
+    if (row < m_Rows)
+    {
+        m_Bits.CopyRange(src, 0, min(m_Cols, src.Size()),
+            row * m_RowWords * WORD_BITS);
+    }
+}
+
+/***************************************************************************
+*   Method     : GetRow
+*   Description: This method copies a row into the first Cols() bits of a
+*                bit array.  Rows outside the matrix are ignored.
+*   Parameters : row - row number
+*                dest - bit array of at least Cols() bits
+*   Effects    : The first Cols() bits of dest are replaced
+*   Returned   : None
+***************************************************************************/
+void bit_matrix_c::GetRow(const size_t row, bit_array_c &dest) const
+{
+    if (row < m_Rows)
+    {
+        dest.CopyRange(m_Bits, row * m_RowWords * WORD_BITS,
+            min(m_Cols, dest.Size()), 0);
+    }
+}
+
+/***************************************************************************
+*   Method     : XnorMultiply
+*   Description: This method computes the +/-1 dot product of every row of
+*                this matrix with every row of another matrix with the
+*                same number of columns.
+*   Parameters : other - second matrix
+*                products - array of Rows() x other.Rows() values,
+*                    receiving the products row by row
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : products are written
+*   Returned   : None
+***************************************************************************/
+void bit_matrix_c::XnorMultiply(const bit_matrix_c &other, int32_t *products,
+    const unsigned int numThreads) const
+{
+    if (m_Cols != other.m_Cols)
+    {
+        throw invalid_argument(
+            "Error: Matrices must have the same number of columns.");
+    }
+
+    ParallelFor(m_Rows, numThreads,
+        [&](size_t begin, size_t end)
+        {
+            WalkTiles(other, begin, end,
+                [&](size_t i, size_t tileA, size_t j, size_t tileB,
+                    const size_t differ[TILE_A][TILE_B])
+                {
+                    for (size_t r = 0; r < tileA; r++)
+                    {
+                        for (size_t c = 0; c < tileB; c++)
+                        {
+                            products[((i + r) * other.m_Rows) + j + c] =
+                                (int32_t)m_Cols -
+                                (int32_t)(2 * differ[r][c]);
+                        }
+                    }
+                });
+        });
+}
+
+/***************************************************************************
+*   Method     : NearestRows
+*   Description: This method finds, for every row of this matrix, the row
+*                of another matrix with the same number of columns that
+*                has the fewest differing bits.  Ties go to the lowest
+*                numbered row.
+*   Parameters : other - matrix of candidate rows (at most 2^32 - 1)
+*                nearest - array of Rows() values; on entry the previous
+*                    nearest rows (any values), on exit the nearest rows
+*                distances - array of Rows() values receiving the
+*                    distance to each nearest row, may be NULL
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : nearest and distances are written
+*   Returned   : Number of rows whose entry in nearest changed
+***************************************************************************/
+size_t bit_matrix_c::NearestRows(const bit_matrix_c &other,
+    uint32_t *nearest, uint32_t *distances,
+    const unsigned int numThreads) const
+{
+    mutex changesLock;
+    size_t changed;
+
+    if (m_Cols != other.m_Cols)
+    {
+        throw invalid_argument(
+            "Error: Matrices must have the same number of columns.");
+    }
+
+    changed = 0;
+
+    ParallelFor(m_Rows, numThreads,
+        [&](size_t begin, size_t end)
+        {
+            vector<uint32_t> best(end - begin), bestRow(end - begin);
+            size_t pieceChanged = 0;
+
+            WalkTiles(other, begin, end,
+                [&](size_t i, size_t tileA, size_t j, size_t tileB,
+                    const size_t differ[TILE_A][TILE_B])
+                {
+                    for (size_t r = 0; r < tileA; r++)
+                    {
+                        size_t k = i + r - begin;
+
+                        for (size_t c = 0; c < tileB; c++)
+                        {
+                            if ((j + c == 0) || (differ[r][c] < best[k]))
+                            {
+                                best[k] = (uint32_t)differ[r][c];
+                                bestRow[k] = (uint32_t)(j + c);
+                            }
+                        }
+                    }
+                });
+
+            for (size_t i = begin; i < end; i++)
+            {
+                pieceChanged += (nearest[i] != bestRow[i - begin]) ? 1 : 0;
+                nearest[i] = bestRow[i - begin];
+
+                if (distances != NULL)
+                {
+                    distances[i] = best[i - begin];
+                }
+            }
+
+            lock_guard<mutex> guard(changesLock);
+            changed += pieceChanged;
+        });
+
+    return changed;
+}
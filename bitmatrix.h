@@ -0,0 +1,94 @@
+/***************************************************************************
+*                              Bit Matrix
+*
+*   File    : bitmatrix.h
+*   Purpose : Header file for a matrix of bits stored one padded row after
+*             another, with a binary (XNOR-popcount) matrix multiply.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class bit_matrix_c
+{
+    public:
+        bit_matrix_c(const size_t rows, const size_t cols);
+        virtual ~bit_matrix_c(void);
+
+        size_t Rows() const { return m_Rows; };
+        size_t Cols() const { return m_Cols; };
+
+        /* set/clear functions */
+        void ClearAll(void);
+        void SetBit(const size_t row, const size_t col);
+        void ClearBit(const size_t row, const size_t col);
+        bool Get(const size_t row, const size_t col) const;
+
+        /* whole rows to/from bit arrays of at least Cols() bits */
+        void SetRow(const size_t row, const bit_array_c &src);
+        void GetRow(const size_t row, bit_array_c &dest) const;
+
+        /* products[i * other.Rows() + j] = sum over k of +/-1 values
+         * row i of this * row j of other (1 bits are +1, 0 bits -1) */
+        void XnorMultiply(const bit_matrix_c &other, int32_t *products,
+            const unsigned int numThreads) const;
+
+        /* nearest[i] = row of other closest to row i in Hamming distance,
+         * returns the number of entries of nearest that changed */
+        size_t NearestRows(const bit_matrix_c &other, uint32_t *nearest,
+            uint32_t *distances, const unsigned int numThreads) const;
+
+    private:
+        /* matrices can't be copied */
+        bit_matrix_c(const bit_matrix_c &);
+        bit_matrix_c& operator=(const bit_matrix_c &);
+
+        friend class kmajority_c;
+
+        const unsigned char *RowChars(const size_t row) const;
+        unsigned char *RowChars(const size_t row);
+        size_t BlockRows(void) const;
+
+        template <typename visit_t>
+        void WalkTiles(const bit_matrix_c &other, const size_t begin,
+            const size_t end, visit_t visit) const;
+
+        bit_array_c m_Bits;             /* rows padded to 64 bit words */
+        size_t m_Rows;                  /* number of rows */
+        size_t m_Cols;                  /* number of columns */
+        size_t m_RowWords;              /* 64 bit words in a padded row */
+};
+
+#endif  /* ndef BIT_MATRIX_H */
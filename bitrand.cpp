@@ -0,0 +1,173 @@
+/***************************************************************************
+*                  Pseudo Random Numbers for Arrays of Bits
+*
+*   File    : bitrand.cpp
+*   Purpose : Provides a small, fast pseudo random number generator used to
+*             fill and sample arbitrary length arrays of bits.
+*
+*             The generator is xoshiro256** by David Blackman and Sebastiano
+*             Vigna.  It produces a full 64 bit word per call, which is
+*             what word at a time bit array fills want, and its state is
+*             seeded from a single 64 bit value using splitmix64.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include "bitrand.h"
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* rotate a 64 bit word left */
+#define ROTL64(x, k)          (((x) << (k)) | ((x) >> (64 - (k))))
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : bit_random_c - constructor
+*   Description: This is the bit_random_c constructor.  It seeds the
+*                generator.
+*   Parameters : seed - value used to seed the generator
+*   Effects    : Generator state is initialized
+*   Returned   : None
+***************************************************************************/
+bit_random_c::bit_random_c(const uint64_t seed)
+{
+    Seed(seed);
+}
+
+/***************************************************************************
+*   Method     : Seed
+*   Description: This method sets the generator state from a 64 bit seed
+*                by running splitmix64 over it.  splitmix64 never produces
+*                an all zero state, which xoshiro can't recover from.
+*   Parameters : seed - value used to seed the generator
+*   Effects    : Generator state is replaced
+*   Returned   : None
+***************************************************************************/
+void bit_random_c::Seed(const uint64_t seed)
+{
+    uint64_t x = seed;
+
+    for (int i = 0; i < 4; i++)
+    {
+        m_State[i] = Hash(x);
+        x += 0x9E3779B97F4A7C15ULL;
+    }
+}
+
+/***************************************************************************
+*   Method     : Hash
+*   Description: This method scrambles a 64 bit value with one step of
+*                splitmix64.  Every input bit affects every output bit, so
+*                it's suitable for hashing integer keys, and it's a
+*                bijection, so distinct keys never collide.
+*   Parameters : key - value to hash
+*   Effects    : None
+*   Returned   : 64 bit hash of key
+***************************************************************************/
+uint64_t bit_random_c::Hash(const uint64_t key)
+{
+    uint64_t z;
+
+    z = key + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/***************************************************************************
+*   Method     : Next
+*   Description: This method returns the next 64 bits from the generator.
+*   Parameters : None
+*   Effects    : Generator state is advanced
+*   Returned   : 64 pseudo random bits
+***************************************************************************/
+uint64_t bit_random_c::Next(void)
+{
+    uint64_t result, t;
+
+    result = ROTL64(m_State[1] * 5, 7) * 9;
+    t = m_State[1] << 17;
+
+    m_State[2] ^= m_State[0];
+    m_State[3] ^= m_State[1];
+    m_State[1] ^= m_State[2];
+    m_State[0] ^= m_State[3];
+
+    m_State[2] ^= t;
+    m_State[3] = ROTL64(m_State[3], 45);
+
+    return result;
+}
+
+/***************************************************************************
+*   Method     : Below
+*   Description: This method returns a uniformly distributed value that is
+*                less than limit.  Values from the biased top end of the
+*                generator's range are rejected.
+*   Parameters : limit - one more than the largest value to return
+*   Effects    : Generator state is advanced
+*   Returned   : Value in the range [0, limit).  0 if limit is 0.
+***************************************************************************/
+uint64_t bit_random_c::Below(const uint64_t limit)
+{
+    uint64_t value, threshold;
+
+    if (limit == 0)
+    {
+        return 0;
+    }
+
+    /* (2^64 - limit) % limit without overflowing */
+    threshold = (0 - limit) % limit;
+
+    do
+    {
+        value = Next();
+    } while (value < threshold);
+
+    return value % limit;
+}
+
+/***************************************************************************
+*   Method     : NextDouble
+*   Description: This method returns a uniformly distributed double using
+*                the top 53 bits of the next generator output.
+*   Parameters : None
+*   Effects    : Generator state is advanced
+*   Returned   : Value in the range [0, 1)
+***************************************************************************/
+double bit_random_c::NextDouble(void)
+{
+    return (double)(Next() >> 11) * (1.0 / 9007199254740992.0);
+}
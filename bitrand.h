@@ -0,0 +1,62 @@
+/***************************************************************************
+*                  Pseudo Random Numbers for Arrays of Bits
+*
+*   File    : bitrand.h
+*   Purpose : Header file for a small, fast pseudo random number generator
+*             used to fill and sample arbitrary length arrays of bits.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef BIT_RAND_H
+#define BIT_RAND_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <stdint.h>
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* xoshiro256** generator producing 64 random bits per call */
+class bit_random_c
+{
+    public:
+        bit_random_c(const uint64_t seed);
+
+        void Seed(const uint64_t seed);
+
+        uint64_t Next(void);                    /* 64 random bits */
+        uint64_t Below(const uint64_t limit);   /* uniform in [0, limit) */
+        double NextDouble(void);                /* uniform in [0, 1) */
+
+        static uint64_t Hash(const uint64_t key);   /* splitmix64 mix */
+
+    private:
+        uint64_t m_State[4];                    /* generator state */
+};
+
+#endif  /* ndef BIT_RAND_H */
@@ -0,0 +1,150 @@
+/***************************************************************************
+*                          Bit Array Word Helpers
+*
+*   File    : bitwords.h
+*   Purpose : Inline functions for counting the bits in 64 bit words and
+*             moving words in and out of arrays of unsigned chars.  They
+*             are shared by the bit array library's modules.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2004, 2006-2007, 2010 by
+*       Michael Dipperstein (mdipperstein@gmail.com)
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef BIT_WORDS_H
+#define BIT_WORDS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* number of characters required to contain number of bits */
+#define BITS_TO_CHARS(bits)   ((((bits) - 1) / CHAR_BIT) + 1)
+
+/* number of characters handled at once by word at a time loops */
+#define WORD_CHARS            (sizeof(uint64_t))
+
+/* true if PopCount is a single instruction */
+#if defined(__POPCNT__) || defined(__ARM_NEON)
+#define HARDWARE_POPCOUNT     1
+#else
+#define HARDWARE_POPCOUNT     0
+#endif
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : PopCount
+*   Description: This function counts the set bits in a 64 bit word.  It
+*                uses the processor's population count instruction when
+*                the compiler is targeting one (e.g. -mpopcnt or
+*                -march=native with gcc or clang), otherwise it uses the
+*                parallel (SWAR) bit count algorithm.
+*   Parameters : word - word to count bits in
+*   Effects    : None
+*   Returned   : Number of bits set in word
+***************************************************************************/
+static inline size_t PopCount(uint64_t word)
+{
+#if HARDWARE_POPCOUNT
+    return (size_t)__builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) +
+        ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (size_t)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/***************************************************************************
+*   Function   : LoadWord
+*   Description: This function copies WORD_CHARS unsigned chars into a 64
+*                bit word.  The byte order of the word is whatever the
+*                machine uses, so the result is only suitable for tests
+*                and counts that don't depend on bit positions.
+*   Parameters : chars - pointer to the first unsigned char to load
+*   Effects    : None
+*   Returned   : Word containing the unsigned chars
+***************************************************************************/
+static inline uint64_t LoadWord(const unsigned char *chars)
+{
+    uint64_t word;
+
+    memcpy(&word, chars, sizeof(word));
+    return word;
+}
+
+/***************************************************************************
+*   Function   : LoadBigEndian
+*   Description: This function builds a 64 bit word from 8 bit
+*                unsigned chars with the first char in the most significant
+*                position, so bit 0 of the chars is the word's MSB.
+*   Parameters : chars - pointer to the first unsigned char to load
+*   Effects    : None
+*   Returned   : Word containing the unsigned chars
+***************************************************************************/
+static inline uint64_t LoadBigEndian(const unsigned char *chars)
+{
+    /* written out so compilers recognize it as a load and byte swap */
+    return ((uint64_t)chars[0] << 56) | ((uint64_t)chars[1] << 48) |
+        ((uint64_t)chars[2] << 40) | ((uint64_t)chars[3] << 32) |
+        ((uint64_t)chars[4] << 24) | ((uint64_t)chars[5] << 16) |
+        ((uint64_t)chars[6] << 8) | (uint64_t)chars[7];
+}
+
+/***************************************************************************
+*   Function   : StoreBigEndian
+*   Description: This function is the inverse of LoadBigEndian.  It writes
+*                a 64 bit word to 8 bit unsigned chars, most significant
+*                char first.
+*   Parameters : chars - pointer to the first unsigned char to store
+*                word - word to store
+*   Effects    : 8 unsigned chars are written
+*   Returned   : None
+***************************************************************************/
+static inline void StoreBigEndian(unsigned char *chars, uint64_t word)
+{
+    /* written out so compilers recognize it as a byte swap and store */
+    chars[0] = (unsigned char)(word >> 56);
+    chars[1] = (unsigned char)(word >> 48);
+    chars[2] = (unsigned char)(word >> 40);
+    chars[3] = (unsigned char)(word >> 32);
+    chars[4] = (unsigned char)(word >> 24);
+    chars[5] = (unsigned char)(word >> 16);
+    chars[6] = (unsigned char)(word >> 8);
+    chars[7] = (unsigned char)word;
+}
+
+#endif  /* ndef BIT_WORDS_H */
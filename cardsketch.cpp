@@ -0,0 +1,409 @@
+/***************************************************************************
+*                     Bitmap Cardinality Sketches
+*
+*   File    : cardsketch.cpp
+*   Purpose : Provides two sketches that estimate the number of distinct
+*             keys in a stream from a bit array of hashed positions.
+*
+*             linear_counter_c is a linear counting bitmap (Whang, Vander-
+*             Zanden and Taylor).  Each hashed key sets one of m bits.  If
+*             z bits are still clear, about m * ln(m / z) distinct keys
+*             were inserted.  It is accurate while the number of keys is
+*             no more than a few times m.
+*
+*             mr_bitmap_c is a multi-resolution bitmap (Estan, Varghese
+*             and Fisk).  It has c components of b bits.  Component i
+*             receives the keys whose hash has exactly i leading zero bits,
+*             1 / 2^(i + 1) of them, and the last component receives the
+*             rest.  The estimate skips the components that are too full
+*             to count accurately and scales the linear counting estimate
+*             of the remaining ones by the fraction of keys they receive,
+*             so c components of b bits cover about 2^c times the range of
+*             a single b bit linear counter.
+*
+*             Set bits are counted with bit_array_c::Count, so an estimate
+*             takes a popcount per word rather than a test per bit.  Two
+*             sketches of the same shape built from different streams can
+*             be merged with |=, which gives the sketch of the combined
+*             stream.
+*
+*             Batch insertion computes the positions of a block of keys
+*             and sorts them before setting any bits, so the bits are set
+*             in one pass through the array rather than in random order.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "cardsketch.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* number of keys sorted at a time by batch insertion */
+#define BATCH_KEYS            4096
+
+/* a component with more than this fraction of bits set is too full */
+#define MAX_FILL              0.7
+
+/* most components a multi-resolution bitmap may have */
+#define MAX_COMPONENTS        32
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : LinearEstimate
+*   Description: This function computes the linear counting estimate of
+*                the number of keys hashed into a bitmap.  A full bitmap
+*                is treated as if it had one clear bit.
+*   Parameters : numBits - number of bits in the bitmap
+*                numSet - number of bits set
+*   Effects    : None
+*   Returned   : Estimated number of distinct keys
+***************************************************************************/
+static double LinearEstimate(const size_t numBits, const size_t numSet)
+{
+    size_t numClear;
+
+    numClear = max((size_t)1, numBits - numSet);
+    return (double)numBits * log((double)numBits / (double)numClear);
+}
+
+/***************************************************************************
+*   Function   : SetSorted
+*   Description: This function sorts a list of bit positions and sets them
+*                in order.
+*   Parameters : bits - array to set bits in
+*                positions - bits to set
+*                count - number of positions
+*   Effects    : positions is sorted and its bits are set in bits
+*   Returned   : None
+***************************************************************************/
+static void SetSorted(bit_array_c &bits, size_t *positions,
+    const size_t count)
+{
+    sort(positions, positions + count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        bits.SetBit(positions[i]);
+    }
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : linear_counter_c - constructor
+*   Description: This is the linear_counter_c constructor.  It allocates
+*                the bitmap.
+*   Parameters : numBits - number of bits in the bitmap
+*   Effects    : Allocates an empty sketch
+*   Returned   : None
+***************************************************************************/
+linear_counter_c::linear_counter_c(const size_t numBits):
+    m_Bits(numBits)
+{
+}
+
+/***************************************************************************
+*   Method     : ~linear_counter_c - destructor
+*   Description: This is the linear_counter_c destructor.  At this point
+*                it's just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+linear_counter_c::~linear_counter_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method empties the sketch.
+*   Parameters : None
+*   Effects    : All bits are cleared
+*   Returned   : None
+***************************************************************************/
+void linear_counter_c::ClearAll(void)
+{
+    m_Bits.ClearAll();
+}
+
+/***************************************************************************
+*   Method     : Insert
+*   Description: This method inserts a hashed key by setting its bit.
+*   Parameters : hash - 64 bit hash of the key
+*   Effects    : Bit at hash mod Size() is set
+*   Returned   : None
+***************************************************************************/
+void linear_counter_c::Insert(const uint64_t hash)
+{
+    m_Bits.SetBit((size_t)(hash % m_Bits.Size()));
+}
+
+/***************************************************************************
+*   Method     : InsertBatch
+*   Description: This method inserts a list of hashed keys.  A block of
+*                positions is computed and sorted before any bits are set.
+*   Parameters : hashes - array of 64 bit hashes of keys
+*                count - number of hashes
+*   Effects    : Bit of every hash is set
+*   Returned   : None
+***************************************************************************/
+void linear_counter_c::InsertBatch(const uint64_t *hashes,
+    const size_t count)
+{
+    vector<size_t> positions(min((size_t)BATCH_KEYS, count));
+
+    for (size_t start = 0; start < count; start += BATCH_KEYS)
+    {
+        size_t n = min((size_t)BATCH_KEYS, count - start);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            positions[i] = (size_t)(hashes[start + i] % m_Bits.Size());
+        }
+
+        SetSorted(m_Bits, &positions[0], n);
+    }
+}
+
+/***************************************************************************
+*   Method     : Estimate
+*   Description: This method estimates the number of distinct keys
+*                inserted from the number of clear bits.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Estimated number of distinct keys
+***************************************************************************/
+double linear_counter_c::Estimate(void) const
+{
+    return LinearEstimate(m_Bits.Size(), m_Bits.Count());
+}
+
+/***************************************************************************
+*   Method     : operator|=
+*   Description: This method merges another sketch of the same size into
+*                this one.
+*   Parameters : src - sketch to merge
+*   Effects    : This sketch counts the keys inserted into either sketch
+*   Returned   : Reference to this sketch
+***************************************************************************/
+linear_counter_c& linear_counter_c::operator|=(const linear_counter_c &src)
+{
+    if (m_Bits.Size() != src.m_Bits.Size())
+    {
+        throw invalid_argument("Error: Sketches must be the same size.");
+    }
+
+    m_Bits |= src.m_Bits;
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : mr_bitmap_c - constructor
+*   Description: This is the mr_bitmap_c constructor.  It allocates the
+*                components.
+*   Parameters : componentBits - number of bits in each component
+*                numComponents - number of components (1 to 32)
+*   Effects    : Allocates an empty sketch
+*   Returned   : None
+***************************************************************************/
+mr_bitmap_c::mr_bitmap_c(const size_t componentBits,
+    const size_t numComponents):
+    m_Bits(componentBits * numComponents),
+    m_ComponentBits(componentBits),
+    m_NumComponents(numComponents)
+{
+    if ((numComponents < 1) || (numComponents > MAX_COMPONENTS))
+    {
+        throw invalid_argument(
+            "Error: Sketch must have 1 to 32 components.");
+    }
+}
+
+/***************************************************************************
+*   Method     : ~mr_bitmap_c - destructor
+*   Description: This is the mr_bitmap_c destructor.  At this point it's
+*                just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+mr_bitmap_c::~mr_bitmap_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method empties the sketch.
+*   Parameters : None
+*   Effects    : All bits are cleared
+*   Returned   : None
+***************************************************************************/
+void mr_bitmap_c::ClearAll(void)
+{
+    m_Bits.ClearAll();
+}
+
+/***************************************************************************
+*   Method     : Position
+*   Description: This method computes the bit of a hashed key.  The
+*                leading zeros of the upper 32 bits of the hash select the
+*                component and the lower 32 bits select the bit in it.
+*   Parameters : hash - 64 bit hash of the key
+*   Effects    : None
+*   Returned   : Index of the key's bit in m_Bits
+***************************************************************************/
+size_t mr_bitmap_c::Position(const uint64_t hash) const
+{
+    size_t component;
+
+    component = 0;
+
+    while ((component < (m_NumComponents - 1)) &&
+        ((hash & ((uint64_t)1 << (63 - component))) == 0))
+    {
+        component++;
+    }
+
+    return (component * m_ComponentBits) +
+        (size_t)((hash & 0xFFFFFFFF) % m_ComponentBits);
+}
+
+/***************************************************************************
+*   Method     : Insert
+*   Description: This method inserts a hashed key by setting its bit.
+*   Parameters : hash - 64 bit hash of the key
+*   Effects    : Bit of hash is set
+*   Returned   : None
+***************************************************************************/
+void mr_bitmap_c::Insert(const uint64_t hash)
+{
+    m_Bits.SetBit(Position(hash));
+}
+
+/***************************************************************************
+*   Method     : InsertBatch
+*   Description: This method inserts a list of hashed keys.  A block of
+*                positions is computed and sorted before any bits are set.
+*   Parameters : hashes - array of 64 bit hashes of keys
+*                count - number of hashes
+*   Effects    : Bit of every hash is set
+*   Returned   : None
+***************************************************************************/
+void mr_bitmap_c::InsertBatch(const uint64_t *hashes, const size_t count)
+{
+    vector<size_t> positions(min((size_t)BATCH_KEYS, count));
+
+    for (size_t start = 0; start < count; start += BATCH_KEYS)
+    {
+        size_t n = min((size_t)BATCH_KEYS, count - start);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            positions[i] = Position(hashes[start + i]);
+        }
+
+        SetSorted(m_Bits, &positions[0], n);
+    }
+}
+
+/***************************************************************************
+*   Method     : Estimate
+*   Description: This method estimates the number of distinct keys
+*                inserted.  The base is the first component that is no
+*                more than MAX_FILL full.  Components from the base on
+*                receive 1 / 2^base of the keys, so the sum of their
+*                linear counting estimates is scaled by 2^base.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Estimated number of distinct keys
+***************************************************************************/
+double mr_bitmap_c::Estimate(void) const
+{
+    vector<size_t> numSet(m_NumComponents);
+    size_t base;
+    double estimate;
+
+    base = m_NumComponents - 1;
+
+    for (size_t i = 0; i < m_NumComponents; i++)
+    {
+        numSet[i] = m_Bits.Slice(i * m_ComponentBits,
+            m_ComponentBits).Count();
+    }
+
+    for (size_t i = 0; i < (m_NumComponents - 1); i++)
+    {
+        if (numSet[i] <= (MAX_FILL * m_ComponentBits))
+        {
+            base = i;
+            break;
+        }
+    }
+
+    estimate = 0;
+
+    for (size_t i = base; i < m_NumComponents; i++)
+    {
+        estimate += LinearEstimate(m_ComponentBits, numSet[i]);
+    }
+
+    return ldexp(estimate, (int)base);
+}
+
+/***************************************************************************
+*   Method     : operator|=
+*   Description: This method merges another sketch of the same shape into
+*                this one.
+*   Parameters : src - sketch to merge
+*   Effects    : This sketch counts the keys inserted into either sketch
+*   Returned   : Reference to this sketch
+***************************************************************************/
+mr_bitmap_c& mr_bitmap_c::operator|=(const mr_bitmap_c &src)
+{
+    if ((m_ComponentBits != src.m_ComponentBits) ||
+        (m_NumComponents != src.m_NumComponents))
+    {
+        throw invalid_argument("Error: Sketches must be the same size.");
+    }
+
+    m_Bits |= src.m_Bits;
+    return *this;
+}
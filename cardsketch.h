@@ -0,0 +1,107 @@
+/***************************************************************************
+*                     Bitmap Cardinality Sketches
+*
+*   File    : cardsketch.h
+*   Purpose : Header file for linear counting and multi-resolution bitmap
+*             sketches that estimate the number of distinct keys.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef CARD_SKETCH_H
+#define CARD_SKETCH_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* one bit per position, good up to a few times its size in keys */
+class linear_counter_c
+{
+    public:
+        linear_counter_c(const size_t numBits);
+        virtual ~linear_counter_c(void);
+
+        size_t Size() const { return m_Bits.Size(); };
+
+        void ClearAll(void);
+
+        /* keys must already be hashed (e.g. with bit_random_c::Hash) */
+        void Insert(const uint64_t hash);
+        void InsertBatch(const uint64_t *hashes, const size_t count);
+
+        double Estimate(void) const;    /* distinct keys inserted */
+
+        /* merge: estimate becomes that of the union */
+        linear_counter_c& operator|=(const linear_counter_c &src);
+
+    private:
+        /* sketches can't be copied */
+        linear_counter_c(const linear_counter_c &);
+        linear_counter_c& operator=(const linear_counter_c &);
+
+        bit_array_c m_Bits;             /* bit of every hashed position */
+};
+
+/* linear counters sampling 1/2, 1/4, ... of the keys, for large counts */
+class mr_bitmap_c
+{
+    public:
+        mr_bitmap_c(const size_t componentBits, const size_t numComponents);
+        virtual ~mr_bitmap_c(void);
+
+        size_t Size() const { return m_Bits.Size(); };
+        size_t ComponentBits() const { return m_ComponentBits; };
+        size_t Components() const { return m_NumComponents; };
+
+        void ClearAll(void);
+
+        /* keys must already be hashed (e.g. with bit_random_c::Hash) */
+        void Insert(const uint64_t hash);
+        void InsertBatch(const uint64_t *hashes, const size_t count);
+
+        double Estimate(void) const;    /* distinct keys inserted */
+
+        /* merge: estimate becomes that of the union */
+        mr_bitmap_c& operator|=(const mr_bitmap_c &src);
+
+    private:
+        /* sketches can't be copied */
+        mr_bitmap_c(const mr_bitmap_c &);
+        mr_bitmap_c& operator=(const mr_bitmap_c &);
+
+        size_t Position(const uint64_t hash) const;
+
+        bit_array_c m_Bits;             /* components, one after another */
+        size_t m_ComponentBits;         /* bits in each component */
+        size_t m_NumComponents;         /* number of components */
+};
+
+#endif  /* ndef CARD_SKETCH_H */
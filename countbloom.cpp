@@ -0,0 +1,446 @@
+/***************************************************************************
+*                          Counting Bloom Filter
+*
+*   File    : countbloom.cpp
+*   Purpose : Provides a Bloom filter that supports removal.  Each position
+*             has a 4 bit counter (see nibbles.h) instead of a bit, so an
+*             array of n positions takes n / 2 bytes.
+*
+*             Inserting a key increments the counters at its k positions
+*             and removing it decrements them.  Counters saturate at
+*             NIBBLE_MAX; a saturated counter may have lost count, so it
+*             is never decremented again.  That can only cause false
+*             positives, never false negatives.
+*
+*             Positions come from double hashing: the key is hashed to 64
+*             bits with bit_random_c::Hash, the halves give h1 and h2, and
+*             position i is (h1 + i * h2) mod n.  h2 is kept between 1
+*             and n - 1, so the positions never all land on one counter.
+*
+*             Single key operations step through the positions as they
+*             go, so they allocate nothing and a lookup stops at the
+*             first 0 counter.  Batch operations hash a block of keys
+*             before touching any counters, so the hashing is a tight
+*             arithmetic loop and the counter accesses for different keys
+*             are independent and can overlap their cache misses.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <stdexcept>
+#include <vector>
+#include "countbloom.h"
+#include "bitrand.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* number of keys hashed at a time by batch operations */
+#define BATCH_KEYS            64
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : NextPosition
+*   Description: This function steps from one position of a key to the
+*                next, wrapping around the end of the counters.
+*   Parameters : pos - current position (less than size)
+*                stride - distance between positions (less than size)
+*                size - number of counters
+*   Effects    : None
+*   Returned   : (pos + stride) mod size
+***************************************************************************/
+static inline size_t NextPosition(const size_t pos, const size_t stride,
+    const size_t size)
+{
+    return (pos >= (size - stride)) ? pos - (size - stride) : pos + stride;
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : counting_bloom_c - constructor
+*   Description: This is the counting_bloom_c constructor.  It allocates
+*                the counters.
+*   Parameters : numCounters - number of counters (positions) in the filter
+*                numHashes - number of positions for each key
+*   Effects    : Allocates the filter with all counters 0
+*   Returned   : None
+***************************************************************************/
+counting_bloom_c::counting_bloom_c(const size_t numCounters,
+    const size_t numHashes):
+    m_Counters(numCounters),
+    m_NumHashes(numHashes)
+{
+    if (numHashes < 1)
+    {
+        throw invalid_argument(
+            "Error: Bloom filter must use at least 1 hash.");
+    }
+}
+
+/***************************************************************************
+*   Method     : ~counting_bloom_c - destructor
+*   Description: This is the counting_bloom_c destructor.  At this point
+*                it's just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+counting_bloom_c::~counting_bloom_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : Probe
+*   Description: This method computes the first position of a key and the
+*                stride between its positions for double hashing.
+*   Parameters : key - key to locate
+*                first - set to the first position
+*                stride - set to the distance between positions, between
+*                    1 and Size() - 1 (0 if there's only one counter)
+*   Effects    : first and stride are set
+*   Returned   : None
+***************************************************************************/
+void counting_bloom_c::Probe(const uint64_t key, size_t &first,
+    size_t &stride) const
+{
+    uint64_t hash, size;
+
+    hash = bit_random_c::Hash(key);
+    size = m_Counters.Size();
+    first = (size_t)((hash >> 32) % size);
+
+    /* stride in [1, size - 1], so it's never 0 mod size */
+    stride = (size == 1) ? 0 :
+        (size_t)(1 + ((hash & 0xFFFFFFFF) % (size - 1)));
+}
+
+/***************************************************************************
+*   Method     : Positions
+*   Description: This method computes the positions of a key by double
+*                hashing.
+*   Parameters : key - key to locate
+*                positions - array of m_NumHashes receiving the positions
+*   Effects    : positions holds the positions of key
+*   Returned   : None
+***************************************************************************/
+void counting_bloom_c::Positions(const uint64_t key, size_t *positions) const
+{
+    size_t pos, stride;
+
+    Probe(key, pos, stride);
+
+    for (size_t i = 0; i < m_NumHashes; i++)
+    {
+        positions[i] = pos;
+        pos = NextPosition(pos, stride, Size());
+    }
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method removes every key from the filter.
+*   Parameters : None
+*   Effects    : All counters are set to 0
+*   Returned   : None
+***************************************************************************/
+void counting_bloom_c::ClearAll(void)
+{
+    m_Counters.ClearAll();
+}
+
+/***************************************************************************
+*   Method     : Insert
+*   Description: This method inserts a key by incrementing the counters at
+*                its positions.
+*   Parameters : key - key to insert
+*   Effects    : Counters of key are incremented
+*   Returned   : None
+***************************************************************************/
+void counting_bloom_c::Insert(const uint64_t key)
+{
+    size_t pos, stride;
+
+    Probe(key, pos, stride);
+
+    for (size_t i = 0; i < m_NumHashes; i++)
+    {
+        m_Counters.Increment(pos);
+        pos = NextPosition(pos, stride, Size());
+    }
+}
+
+/***************************************************************************
+*   Method     : Remove
+*   Description: This method removes a key by decrementing the counters at
+*                its positions.  A key that isn't in the filter (some
+*                counter is 0) is left alone, and saturated counters are
+*                never decremented.
+*   Parameters : key - key to remove
+*   Effects    : Counters of key are decremented
+*   Returned   : true if the key was in the filter
+***************************************************************************/
+bool counting_bloom_c::Remove(const uint64_t key)
+{
+    size_t pos, stride;
+
+    if (!Contains(key))
+    {
+        return false;       /* only remove keys that are present */
+    }
+
+    Probe(key, pos, stride);
+
+    for (size_t i = 0; i < m_NumHashes; i++)
+    {
+        if (m_Counters.Get(pos) < NIBBLE_MAX)
+        {
+            m_Counters.Decrement(pos);
+        }
+
+        pos = NextPosition(pos, stride, Size());
+    }
+
+    return true;
+}
+
+/***************************************************************************
+*   Method     : Contains
+*   Description: This method tests whether a key may be in the filter.
+*   Parameters : key - key to look for
+*   Effects    : None
+*   Returned   : false if the key is definitely not in the filter, true if
+*                it probably is
+***************************************************************************/
+bool counting_bloom_c::Contains(const uint64_t key) const
+{
+    size_t pos, stride;
+
+    Probe(key, pos, stride);
+
+    for (size_t i = 0; i < m_NumHashes; i++)
+    {
+        if (m_Counters.Get(pos) == 0)
+        {
+            return false;
+        }
+
+        pos = NextPosition(pos, stride, Size());
+    }
+
+    return true;
+}
+
+/***************************************************************************
+*   Method     : InsertBatch
+*   Description: This method inserts a list of keys.  Keys are hashed a
+*                block at a time before any counters are updated.
+*   Parameters : keys - array of keys to insert
+*                count - number of keys
+*   Effects    : Counters of every key are incremented
+*   Returned   : None
+***************************************************************************/
+void counting_bloom_c::InsertBatch(const uint64_t *keys, const size_t count)
+{
+    vector<size_t> positions(min(count, (size_t)BATCH_KEYS) * m_NumHashes);
+
+    for (size_t start = 0; start < count; start += BATCH_KEYS)
+    {
+        size_t n = min((size_t)BATCH_KEYS, count - start);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            Positions(keys[start + i], &positions[i * m_NumHashes]);
+        }
+
+        for (size_t i = 0; i < (n * m_NumHashes); i++)
+        {
+            m_Counters.Increment(positions[i]);
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : RemoveBatch
+*   Description: This method removes a list of keys.  Keys are hashed a
+*                block at a time before any counters are updated.  Keys
+*                that aren't in the filter are skipped.
+*   Parameters : keys - array of keys to remove
+*                count - number of keys
+*   Effects    : Counters of every key in the filter are decremented
+*   Returned   : Number of keys removed
+***************************************************************************/
+size_t counting_bloom_c::RemoveBatch(const uint64_t *keys, const size_t count)
+{
+    vector<size_t> positions(min(count, (size_t)BATCH_KEYS) * m_NumHashes);
+    size_t removed = 0;
+
+    for (size_t start = 0; start < count; start += BATCH_KEYS)
+    {
+        size_t n = min((size_t)BATCH_KEYS, count - start);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            Positions(keys[start + i], &positions[i * m_NumHashes]);
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            const size_t *p = &positions[i * m_NumHashes];
+            size_t j;
+
+            /* only remove keys that are present */
+            for (j = 0; j < m_NumHashes; j++)
+            {
+                if (m_Counters.Get(p[j]) == 0)
+                {
+                    break;
+                }
+            }
+
+            if (j < m_NumHashes)
+            {
+                continue;
+            }
+
+            for (j = 0; j < m_NumHashes; j++)
+            {
+                if (m_Counters.Get(p[j]) < NIBBLE_MAX)
+                {
+                    m_Counters.Decrement(p[j]);
+                }
+            }
+
+            removed++;
+        }
+    }
+
+    return removed;
+}
+
+/***************************************************************************
+*   Method     : ContainsBatch
+*   Description: This method tests a list of keys.  Keys are hashed a block
+*                at a time before any counters are read.
+*   Parameters : keys - array of keys to look for
+*                count - number of keys
+*                results - array receiving true for each key that is
+*                    probably in the filter
+*   Effects    : None
+*   Returned   : Number of keys that are probably in the filter
+***************************************************************************/
+size_t counting_bloom_c::ContainsBatch(const uint64_t *keys,
+    const size_t count, bool *results) const
+{
+    vector<size_t> positions(min(count, (size_t)BATCH_KEYS) * m_NumHashes);
+    size_t found = 0;
+
+    for (size_t start = 0; start < count; start += BATCH_KEYS)
+    {
+        size_t n = min((size_t)BATCH_KEYS, count - start);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            Positions(keys[start + i], &positions[i * m_NumHashes]);
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            const size_t *p = &positions[i * m_NumHashes];
+            bool present = true;
+
+            for (size_t j = 0; present && (j < m_NumHashes); j++)
+            {
+                present = (m_Counters.Get(p[j]) != 0);
+            }
+
+            results[start + i] = present;
+            found += present ? 1 : 0;
+        }
+    }
+
+    return found;
+}
+
+/***************************************************************************
+*   Method     : ToBloom
+*   Description: This method builds a plain Bloom filter with one bit per
+*                counter, set where the counter isn't 0.  Test keys against
+*                it with Contains(filter, key).
+*   Parameters : filter - bit array with one bit per counter
+*   Effects    : filter holds the plain Bloom filter.  It's unchanged if
+*                its size doesn't match.
+*   Returned   : None
+***************************************************************************/
+void counting_bloom_c::ToBloom(bit_array_c &filter) const
+{
+    m_Counters.NonZero(filter);
+}
+
+/***************************************************************************
+*   Method     : Contains
+*   Description: This method tests whether a key may be in a plain Bloom
+*                filter built by ToBloom.
+*   Parameters : filter - plain Bloom filter
+*                key - key to look for
+*   Effects    : None
+*   Returned   : false if the key is definitely not in the filter, true if
+*                it probably is
+***************************************************************************/
+bool counting_bloom_c::Contains(const bit_array_c &filter,
+    const uint64_t key) const
+{
+    size_t pos, stride;
+
+    if (filter.Size() != Size())
+    {
+        return false;
+    }
+
+    Probe(key, pos, stride);
+
+    for (size_t i = 0; i < m_NumHashes; i++)
+    {
+        if (!filter[pos])
+        {
+            return false;
+        }
+
+        pos = NextPosition(pos, stride, Size());
+    }
+
+    return true;
+}
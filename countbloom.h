@@ -0,0 +1,83 @@
+/***************************************************************************
+*                          Counting Bloom Filter
+*
+*   File    : countbloom.h
+*   Purpose : Header file for a Bloom filter with 4 bit counters, which
+*             allows keys to be removed as well as inserted.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef COUNT_BLOOM_H
+#define COUNT_BLOOM_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <stdint.h>
+#include "bitarray.h"
+#include "nibbles.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class counting_bloom_c
+{
+    public:
+        counting_bloom_c(const size_t numCounters, const size_t numHashes);
+        virtual ~counting_bloom_c(void);
+
+        size_t Size() const { return m_Counters.Size(); };
+        size_t Hashes() const { return m_NumHashes; };
+
+        void ClearAll(void);
+
+        /* single keys */
+        void Insert(const uint64_t key);
+        bool Remove(const uint64_t key);
+        bool Contains(const uint64_t key) const;
+
+        /* batches of keys */
+        void InsertBatch(const uint64_t *keys, const size_t count);
+        size_t RemoveBatch(const uint64_t *keys, const size_t count);
+        size_t ContainsBatch(const uint64_t *keys, const size_t count,
+            bool *results) const;
+
+        /* plain Bloom filter with the same hashes */
+        void ToBloom(bit_array_c &filter) const;
+        bool Contains(const bit_array_c &filter, const uint64_t key) const;
+
+    private:
+        /* filters can't be copied */
+        counting_bloom_c(const counting_bloom_c &);
+        counting_bloom_c& operator=(const counting_bloom_c &);
+
+        void Probe(const uint64_t key, size_t &first, size_t &stride) const;
+        void Positions(const uint64_t key, size_t *positions) const;
+
+        nibble_array_c m_Counters;      /* one counter per position */
+        size_t m_NumHashes;             /* positions per key */
+};
+
+#endif  /* ndef COUNT_BLOOM_H */
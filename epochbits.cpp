@@ -0,0 +1,298 @@
+/***************************************************************************
+*             Epoch Stamped Arrays of Arbitrary Bit Length
+*
+*   File    : epochbits.cpp
+*   Purpose : Provides a bit array that can be cleared in constant time,
+*             for workloads that clear and refill the same array many
+*             times.
+*
+*             The bits are kept in 64 bit words, and each word has an
+*             epoch tag recording the epoch in which it was last written.
+*             A word whose tag isn't the current epoch is stale and reads
+*             as all 0s; the first write to a stale word zeros it and
+*             stamps it with the current epoch.  ClearAll just advances
+*             the epoch, making every word stale.
+*
+*             Tags are a single unsigned char, so every UCHAR_MAX + 1
+*             clears the epoch wraps around.  A stale tag could then match
+*             the current epoch again, so on a wrap the words and tags are
+*             cleared for real.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include "epochbits.h"
+#include "bitwords.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* number of bits in a word */
+#define WORD_BITS             64
+
+/* index of the word containing bit */
+#define BIT_WORD(bit)         ((bit) / WORD_BITS)
+
+/* position of bit within its word, the first bit is most significant */
+#define BIT_IN_WORD(bit)      \
+    ((uint64_t)1 << (WORD_BITS - 1 - ((bit) % WORD_BITS)))
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : epoch_bit_array_c - constructor
+*   Description: This is the epoch_bit_array_c constructor.  It allocates
+*                the words and their tags, all current and all 0s.
+*   Parameters : numBits - number of bits in the array
+*   Effects    : Allocates the array with all bits cleared
+*   Returned   : None
+***************************************************************************/
+epoch_bit_array_c::epoch_bit_array_c(const size_t numBits):
+    m_NumBits(numBits),
+    m_Epoch(0)
+{
+    if (numBits < 1)
+    {
+        throw invalid_argument("Error: Bit Array must have at least 1 bit.");
+    }
+
+    m_NumWords = BIT_WORD(numBits - 1) + 1;
+    m_Words = new uint64_t[m_NumWords]();
+    m_Tags = new unsigned char[m_NumWords]();
+}
+
+/***************************************************************************
+*   Method     : ~epoch_bit_array_c - destructor
+*   Description: This is the epoch_bit_array_c destructor.  It frees the
+*                words and their tags.
+*   Parameters : None
+*   Effects    : Words and tags are freed
+*   Returned   : None
+***************************************************************************/
+epoch_bit_array_c::~epoch_bit_array_c(void)
+{
+    delete[] m_Words;
+    delete[] m_Tags;
+}
+
+/***************************************************************************
+*   Method     : Count
+*   Description: This method counts the set bits in the current words.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Number of set bits in the array
+***************************************************************************/
+size_t epoch_bit_array_c::Count(void) const
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < m_NumWords; i++)
+    {
+        if (m_Tags[i] == m_Epoch)
+        {
+            count += PopCount(m_Words[i]);
+        }
+    }
+
+    return count;
+}
+
+/***************************************************************************
+*   Method     : SetAll
+*   Description: This method sets every bit in the array, stamping every
+*                word with the current epoch.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 1.
+*   Returned   : None
+***************************************************************************/
+void epoch_bit_array_c::SetAll(void)
+{
+    size_t bits;
+
+    for (size_t i = 0; i < m_NumWords; i++)
+    {
+        m_Words[i] = ~(uint64_t)0;
+        m_Tags[i] = m_Epoch;
+    }
+
+    /* zero any spare bits in the last word */
+    bits = m_NumBits % WORD_BITS;
+    if (bits != 0)
+    {
+        m_Words[m_NumWords - 1] = ~(~(uint64_t)0 >> bits);
+    }
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method clears every bit in the array by advancing
+*                the epoch, which makes every word stale.  When the epoch
+*                wraps around the words and tags are cleared for real.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 0.
+*   Returned   : None
+***************************************************************************/
+void epoch_bit_array_c::ClearAll(void)
+{
+    m_Epoch++;
+
+    if (m_Epoch == 0)
+    {
+        /* old tags may match the new epoch */
+        fill_n(m_Words, m_NumWords, 0);
+        fill_n(m_Tags, m_NumWords, 0);
+    }
+}
+
+/***************************************************************************
+*   Method     : SetBit
+*   Description: This method sets a bit in the array.  A stale word is
+*                zeroed and stamped with the current epoch first.
+*   Parameters : bit - the bit to set
+*   Effects    : The specified bit will be set to 1.
+*   Returned   : None
+***************************************************************************/
+void epoch_bit_array_c::SetBit(const size_t bit)
+{
+    size_t word;
+
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    word = BIT_WORD(bit);
+
+    if (m_Tags[word] != m_Epoch)
+    {
+        m_Words[word] = 0;
+        m_Tags[word] = m_Epoch;
+    }
+
+    m_Words[word] |= BIT_IN_WORD(bit);
+}
+
+/***************************************************************************
+*   Method     : ClearBit
+*   Description: This method clears a bit in the array.  Bits in stale
+*                words are already 0.
+*   Parameters : bit - the bit to clear
+*   Effects    : The specified bit will be set to 0.
+*   Returned   : None
+***************************************************************************/
+void epoch_bit_array_c::ClearBit(const size_t bit)
+{
+    size_t word;
+
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    word = BIT_WORD(bit);
+
+    if (m_Tags[word] == m_Epoch)
+    {
+        m_Words[word] &= ~BIT_IN_WORD(bit);
+    }
+}
+
+/***************************************************************************
+*   Method     : operator[]
+*   Description: Overload of the [] operator.  This method returns the
+*                value of a bit in the array.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : The value of the specified bit.  Bits in stale words are
+*                0.
+***************************************************************************/
+bool epoch_bit_array_c::operator[](const size_t bit) const
+{
+    size_t word;
+
+    if (m_NumBits <= bit)
+    {
+        return false;   /* bit out of range */
+    }
+
+    word = BIT_WORD(bit);
+    return ((m_Tags[word] == m_Epoch) &&
+        ((m_Words[word] & BIT_IN_WORD(bit)) != 0));
+}
+
+/***************************************************************************
+*   Method     : ToBitArray
+*   Description: This method copies the bits into a bit_array_c of the same
+*                size, a word at a time.
+*   Parameters : dest - bit array receiving the bits
+*   Effects    : dest holds a copy of the bits.  dest is unchanged if its
+*                size doesn't match.
+*   Returned   : None
+***************************************************************************/
+void epoch_bit_array_c::ToBitArray(bit_array_c &dest) const
+{
+    unsigned char *chars;
+    size_t numChars, first;
+    uint64_t word;
+
+    if (dest.Size() != m_NumBits)
+    {
+        return;
+    }
+
+    chars = dest.Chars();
+    numChars = BITS_TO_CHARS(m_NumBits);
+
+    /* words are MSB first like bit_array_c, spare bits are already 0 */
+    for (size_t i = 0; i < m_NumWords; i++)
+    {
+        word = (m_Tags[i] == m_Epoch) ? m_Words[i] : 0;
+        first = i * WORD_CHARS;
+
+        if ((numChars - first) >= WORD_CHARS)
+        {
+            StoreBigEndian(&chars[first], word);
+        }
+        else
+        {
+            for (size_t j = 0; j < (numChars - first); j++)
+            {
+                chars[first + j] =
+                    (unsigned char)(word >> (56 - (CHAR_BIT * j)));
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/***************************************************************************
+*             Epoch Stamped Arrays of Arbitrary Bit Length
+*
+*   File    : epochbits.h
+*   Purpose : Header file for a bit array whose words carry an epoch tag,
+*             so that the whole array can be cleared in constant time.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef EPOCH_BITS_H
+#define EPOCH_BITS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class epoch_bit_array_c
+{
+    public:
+        epoch_bit_array_c(const size_t numBits);
+        virtual ~epoch_bit_array_c(void);
+
+        size_t Size() const { return m_NumBits; };
+        size_t Count(void) const;
+
+        /* set/clear functions */
+        void SetAll(void);
+        void ClearAll(void);                    /* O(1) except on wrap */
+        void SetBit(const size_t bit);
+        void ClearBit(const size_t bit);
+
+        /* boolean operator */
+        bool operator[](const size_t bit) const;
+
+        /* conversion */
+        void ToBitArray(bit_array_c &dest) const;
+
+    private:
+        /* epoch arrays can't be copied */
+        epoch_bit_array_c(const epoch_bit_array_c &);
+        epoch_bit_array_c& operator=(const epoch_bit_array_c &);
+
+        size_t m_NumBits;               /* number of bits in the array */
+        size_t m_NumWords;              /* number of 64 bit words */
+        uint64_t *m_Words;              /* bits, valid if tag is current */
+        unsigned char *m_Tags;          /* epoch each word was written in */
+        unsigned char m_Epoch;          /* current epoch */
+};
+
+#endif  /* ndef EPOCH_BITS_H */
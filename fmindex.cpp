@@ -0,0 +1,682 @@
+/***************************************************************************
+*                             FM-Index
+*
+*   File    : fmindex.cpp
+*   Purpose : Provides an FM-index (Ferragina and Manzini, "Opportunistic
+*             Data Structures with Applications").  The rows of the index
+*             are the suffixes of the text, plus an empty suffix that
+*             sorts first, in sorted order.  Only the byte before each
+*             row's suffix is kept, the Burrows-Wheeler transform (BWT),
+*             in a Huffman shaped wavelet tree (see wavelet.h).  The rows
+*             starting with a pattern are a contiguous range, which is
+*             found by backward search: one pair of wavelet rank queries
+*             per pattern byte, independent of the text length.
+*
+*             To locate an occurrence, its row is walked back through the
+*             text with the LF mapping until it reaches a row whose text
+*             position was sampled.  A position is sampled when it is a
+*             multiple of the sample rate, so a locate takes at most
+*             sampleRate steps and the samples take (n / sampleRate) *
+*             log2(n / sampleRate) bits.
+*
+*             The suffix array is built with SA-IS (Nong, Zhang and Chan,
+*             "Two Efficient Algorithms for Linear Time Suffix Array
+*             Construction") in 32 bit indices when the text allows,
+*             and is overwritten with the BWT once it has been sampled,
+*             then packed into bytes in place.  Building takes about 6n
+*             bytes of memory for texts under 4 GB (10n above that).  A
+*             Huffman code takes less than H0 + 1 bits per byte, where H0
+*             is the zero order entropy of the text in bits per byte, so
+*             the index takes less than (H0 + 2) * 1.125 + log2(n /
+*             sampleRate) / sampleRate bits per text byte, which is
+*             smaller than the text unless the text is close to random.
+*             The end of the text is never stored; its BWT entry is
+*             stored as a 0 and corrected for in rank.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "fmindex.h"
+#include "bitwords.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* symbols in the text alphabet */
+#define TEXT_SYMBOLS          (UCHAR_MAX + 1)
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : IsSType
+*   Description: This function tests a suffix's type in an SA-IS type
+*                array.  A suffix is S-type if it is smaller than the
+*                suffix after it and L-type if it is larger.
+*   Parameters : types - type bits, 1 for S-type, most significant first
+*                i - suffix to test
+*   Effects    : None
+*   Returned   : true if suffix i is S-type
+***************************************************************************/
+static inline bool IsSType(const unsigned char *types, const size_t i)
+{
+    return (types[i / CHAR_BIT] >> (CHAR_BIT - 1 - (i % CHAR_BIT))) & 1;
+}
+
+/***************************************************************************
+*   Function   : IsLms
+*   Description: This function tests if a suffix is leftmost S-type (LMS),
+*                an S-type suffix following an L-type one.
+*   Parameters : types - type bits, 1 for S-type, most significant first
+*                i - suffix to test
+*   Effects    : None
+*   Returned   : true if suffix i is LMS
+***************************************************************************/
+static inline bool IsLms(const unsigned char *types, const size_t i)
+{
+    return (i > 0) && IsSType(types, i) && !IsSType(types, i - 1);
+}
+
+/***************************************************************************
+*   Function   : Buckets
+*   Description: This function finds the start or end of each symbol's
+*                bucket, the part of the suffix array holding suffixes
+*                that start with that symbol.
+*   Parameters : s - string
+*                n - length of s
+*                k - number of symbols in the alphabet of s
+*                buckets - array of k receiving the bucket positions
+*                ends - true for one past the end of each bucket, false
+*                    for the start
+*   Effects    : buckets is written
+*   Returned   : None
+***************************************************************************/
+template <typename symbol_t, typename index_t>
+static void Buckets(const symbol_t *s, const index_t n, const index_t k,
+    index_t *buckets, const bool ends)
+{
+    index_t sum = 0;
+
+    fill(buckets, buckets + k, 0);
+
+    for (index_t i = 0; i < n; i++)
+    {
+        buckets[s[i]]++;
+    }
+
+    for (index_t c = 0; c < k; c++)
+    {
+        sum += buckets[c];
+        buckets[c] = ends ? sum : (sum - buckets[c]);
+    }
+}
+
+/***************************************************************************
+*   Function   : InduceSort
+*   Description: This function induces the order of the L-type suffixes
+*                from the LMS suffixes already in the suffix array, then
+*                the order of the S-type suffixes from the L-type ones.
+*                The string ends with an implicit sentinel smaller than
+*                every symbol, so suffix n - 1 is L-type and is induced
+*                first.
+*   Parameters : s - string
+*                sa - suffix array holding LMS suffixes at bucket ends
+*                n - length of s
+*                k - number of symbols in the alphabet of s
+*                types - type bits of s
+*                buckets - array of k for bucket positions
+*   Effects    : sa holds the suffixes in sorted order, if the LMS suffixes
+*                were in sorted order
+*   Returned   : None
+***************************************************************************/
+template <typename symbol_t, typename index_t>
+static void InduceSort(const symbol_t *s, index_t *sa, const index_t n,
+    const index_t k, const unsigned char *types, index_t *buckets)
+{
+    const index_t empty = ~(index_t)0;
+
+    Buckets(s, n, k, buckets, false);
+    sa[buckets[s[n - 1]]++] = n - 1;
+
+    for (index_t i = 0; i < n; i++)
+    {
+        index_t j = sa[i];
+
+        if ((j != empty) && (j > 0) && !IsSType(types, j - 1))
+        {
+            sa[buckets[s[j - 1]]++] = j - 1;
+        }
+    }
+
+    Buckets(s, n, k, buckets, true);
+
+    for (index_t i = n; i-- > 0;)
+    {
+        index_t j = sa[i];
+
+        if ((j != empty) && (j > 0) && IsSType(types, j - 1))
+        {
+            sa[--buckets[s[j - 1]]] = j - 1;
+        }
+    }
+}
+
+/***************************************************************************
+*   Function   : SuffixSort
+*   Description: This function builds a suffix array with SA-IS.  The LMS
+*                substrings are sorted by induced sorting and named, and if
+*                any names repeat the string of names is sorted
+*                recursively.  The sorted LMS suffixes then induce the
+*                order of all of the suffixes.
+*   Parameters : s - string (at least 1 symbol)
+*                sa - array of n receiving the suffix array
+*                n - length of s
+*                k - number of symbols in the alphabet of s
+*   Effects    : sa is written
+*   Returned   : None
+***************************************************************************/
+template <typename symbol_t, typename index_t>
+static void SuffixSort(const symbol_t *s, index_t *sa, const index_t n,
+    const index_t k)
+{
+    const index_t empty = ~(index_t)0;
+    vector<unsigned char> types((n + CHAR_BIT - 1) / CHAR_BIT, 0);
+    vector<index_t> buckets(k);
+    index_t numLms, names, previous;
+    index_t *reduced;
+
+    /* classify suffixes, the last is L-type before the sentinel */
+    for (index_t i = n - 1; i-- > 0;)
+    {
+        if ((s[i] < s[i + 1]) ||
+            ((s[i] == s[i + 1]) && IsSType(&types[0], i + 1)))
+        {
+            types[i / CHAR_BIT] |= 1 << (CHAR_BIT - 1 - (i % CHAR_BIT));
+        }
+    }
+
+    /* sort the LMS substrings */
+    fill(sa, sa + n, empty);
+    Buckets(s, n, k, &buckets[0], true);
+
+    for (index_t i = 1; i < n; i++)
+    {
+        if (IsLms(&types[0], i))
+        {
+            sa[--buckets[s[i]]] = i;
+        }
+    }
+
+    InduceSort(s, sa, n, k, &types[0], &buckets[0]);
+
+    /* name them in order, equal substrings get equal names */
+    numLms = 0;
+
+    for (index_t i = 0; i < n; i++)
+    {
+        if (IsLms(&types[0], sa[i]))
+        {
+            sa[numLms++] = sa[i];
+        }
+    }
+
+    fill(sa + numLms, sa + n, empty);
+    names = 0;
+    previous = empty;
+
+    for (index_t i = 0; i < numLms; i++)
+    {
+        index_t pos = sa[i];
+        bool differ = false;
+
+        for (index_t d = 0; ; d++)
+        {
+            if ((previous == empty) || (pos + d == n) ||
+                (previous + d == n) || (s[pos + d] != s[previous + d]) ||
+                (IsSType(&types[0], pos + d) !=
+                IsSType(&types[0], previous + d)))
+            {
+                differ = true;
+                break;
+            }
+            else if ((d > 0) && (IsLms(&types[0], pos + d) ||
+                IsLms(&types[0], previous + d)))
+            {
+                break;
+            }
+        }
+
+        if (differ)
+        {
+            names++;
+            previous = pos;
+        }
+
+        /* LMS suffixes are at least 2 apart, so pos / 2 is unique */
+        sa[numLms + (pos / 2)] = names - 1;
+    }
+
+    /* gather the names at the end of sa in text order */
+    for (index_t i = n, j = n; i-- > numLms;)
+    {
+        if (sa[i] != empty)
+        {
+            sa[--j] = sa[i];
+        }
+    }
+
+    /* sort the LMS suffixes by sorting the string of names */
+    reduced = sa + n - numLms;
+
+    if (names < numLms)
+    {
+        SuffixSort(reduced, sa, numLms, names);
+    }
+    else
+    {
+        for (index_t i = 0; i < numLms; i++)
+        {
+            sa[reduced[i]] = i;
+        }
+    }
+
+    /* put the sorted LMS suffixes at their bucket ends and induce */
+    for (index_t i = 1, j = 0; i < n; i++)
+    {
+        if (IsLms(&types[0], i))
+        {
+            reduced[j++] = i;
+        }
+    }
+
+    for (index_t i = 0; i < numLms; i++)
+    {
+        sa[i] = reduced[sa[i]];
+    }
+
+    fill(sa + numLms, sa + n, empty);
+    Buckets(s, n, k, &buckets[0], true);
+
+    for (index_t i = numLms; i-- > 0;)
+    {
+        index_t j = sa[i];
+
+        sa[i] = empty;
+        sa[--buckets[s[j]]] = j;
+    }
+
+    InduceSort(s, sa, n, k, &types[0], &buckets[0]);
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : fm_index_c - constructor
+*   Description: This is the fm_index_c constructor.  It builds the index
+*                of a text.
+*   Parameters : text - text to index
+*                length - number of bytes in text
+*                sampleRate - distance between sampled text positions
+*                    (at least 1), trading locate speed for space
+*                numThreads - maximum number of threads for building the
+*                    wavelet tree, 0 for one per hardware thread
+*   Effects    : The index is built
+*   Returned   : None
+***************************************************************************/
+fm_index_c::fm_index_c(const unsigned char *text, const size_t length,
+    const unsigned int sampleRate, const unsigned int numThreads):
+    m_Length(length),
+    m_Primary(0),
+    m_SampleRate(sampleRate),
+    m_SampleBits(1),
+    m_Bwt(NULL),
+    m_Sampled(NULL),
+    m_SampledRanks(NULL),
+    m_Samples(NULL)
+{
+    if (sampleRate == 0)
+    {
+        throw invalid_argument(
+            "Error: FM-index sample rate must be at least 1.");
+    }
+
+    try
+    {
+        if (length < UINT32_MAX)
+        {
+            Build<uint32_t>(text, numThreads);
+        }
+        else
+        {
+            Build<uint64_t>(text, numThreads);
+        }
+    }
+    catch (...)
+    {
+        delete m_SampledRanks;
+        delete m_Sampled;
+        delete m_Samples;
+        delete m_Bwt;
+        throw;
+    }
+}
+
+/***************************************************************************
+*   Method     : ~fm_index_c - destructor
+*   Description: This is the fm_index_c destructor.  It frees the index.
+*   Parameters : None
+*   Effects    : The index is freed
+*   Returned   : None
+***************************************************************************/
+fm_index_c::~fm_index_c(void)
+{
+    delete m_SampledRanks;
+    delete m_Sampled;
+    delete m_Samples;
+    delete m_Bwt;
+}
+
+/***************************************************************************
+*   Method     : Build
+*   Description: This method builds the suffix array, samples it, turns it
+*                into the BWT in place and builds the wavelet tree.
+*                Row 0 is the empty suffix and row r + 1 is suffix sa[r].
+*   Parameters : text - text to index
+*                numThreads - maximum number of threads for building the
+*                    wavelet tree
+*   Effects    : All of the index's structures are built
+*   Returned   : None
+***************************************************************************/
+template <typename index_t>
+void fm_index_c::Build(const unsigned char *text,
+    const unsigned int numThreads)
+{
+    const size_t rows = m_Length + 1;
+    vector<index_t> sa(rows);
+    unsigned char *bwt;
+    size_t numSamples, sample;
+
+    if (m_Length > 0)
+    {
+        SuffixSort(text, &sa[0], (index_t)m_Length, (index_t)TEXT_SYMBOLS);
+    }
+
+    /* rows before each byte's: the empty suffix and smaller bytes */
+    memset(m_Before, 0, sizeof(m_Before));
+
+    for (size_t i = 0; i < m_Length; i++)
+    {
+        m_Before[text[i] + 1]++;
+    }
+
+    m_Before[0] = 1;
+
+    for (size_t c = 1; c <= TEXT_SYMBOLS; c++)
+    {
+        m_Before[c] += m_Before[c - 1];
+    }
+
+    /* rows at multiples of the sample rate are sampled */
+    numSamples = (m_Length / m_SampleRate) + 1;
+
+    while ((m_SampleBits < 64) &&
+        (((m_Length / m_SampleRate) >> m_SampleBits) != 0))
+    {
+        m_SampleBits++;
+    }
+
+    m_Sampled = new bit_array_c(rows);
+    m_Sampled->ClearAll();
+
+    /* extra word so samples can be read a word at a time */
+    m_Samples = new bit_array_c((numSamples * m_SampleBits) + 64);
+    m_Samples->ClearAll();
+
+    /* sample the suffix array and overwrite it with the BWT in one pass
+     * from the last row back, so sa[row - 1] is read before it's written */
+    sample = numSamples;
+
+    for (size_t row = rows; row-- > 0;)
+    {
+        index_t pos = (row == 0) ? (index_t)m_Length : sa[row - 1];
+
+        if ((pos % m_SampleRate) == 0)
+        {
+            size_t bit = --sample * m_SampleBits;
+            uint64_t value = (uint64_t)(pos / m_SampleRate) <<
+                (64 - m_SampleBits - (bit % CHAR_BIT));
+
+            m_Sampled->SetBit(row);
+
+            for (size_t i = 0; i < sizeof(uint64_t); i++)
+            {
+                m_Samples->Chars()[(bit / CHAR_BIT) + i] |=
+                    (unsigned char)(value >> (56 - (CHAR_BIT * i)));
+            }
+        }
+
+        if (pos == 0)
+        {
+            m_Primary = row;
+            sa[row] = 0;
+        }
+        else
+        {
+            sa[row] = text[pos - 1];
+        }
+    }
+
+    /* pack the BWT into bytes in place, byte row is never past sa[row] */
+    bwt = (unsigned char *)&sa[0];
+
+    for (size_t row = 0; row < rows; row++)
+    {
+        bwt[row] = (unsigned char)sa[row];
+    }
+
+    m_SampledRanks = new rank_select_c(*m_Sampled);
+    m_Bwt = new huffman_wavelet_c(bwt, rows, numThreads);
+}
+
+/***************************************************************************
+*   Method     : Bytes
+*   Description: This method estimates the memory used by the index, not
+*                counting select samples in the rank directories.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Approximate bytes used by the index
+***************************************************************************/
+size_t fm_index_c::Bytes() const
+{
+    const size_t rows = m_Length + 1;
+    size_t bits;
+
+    /* each bit array and its rank directory of 64 bits per 512 */
+    bits = m_Bwt->Bits() + rows;
+    bits += (bits / 8) + m_Samples->Size();
+
+    return (bits / CHAR_BIT) + sizeof(*this);
+}
+
+/***************************************************************************
+*   Method     : Occurrences
+*   Description: This method counts a byte in the BWT before a row,
+*                excluding the end of text, which is stored as a 0.
+*   Parameters : c - byte to count
+*                row - row to count before
+*   Effects    : None
+*   Returned   : Occurrences of c in BWT rows [0, row)
+***************************************************************************/
+size_t fm_index_c::Occurrences(const unsigned char c, const size_t row) const
+{
+    size_t count = m_Bwt->Rank(c, row);
+
+    if ((c == 0) && (m_Primary < row))
+    {
+        count--;
+    }
+
+    return count;
+}
+
+/***************************************************************************
+*   Method     : Rows
+*   Description: This method finds the rows starting with a pattern by
+*                backward search, narrowing the range one pattern byte at
+*                a time from the last.
+*   Parameters : pattern - pattern to search for
+*                length - number of bytes in pattern
+*                begin - set to the first row of the range
+*                end - set to one past the last row of the range
+*   Effects    : begin and end are set
+*   Returned   : true if the range isn't empty
+***************************************************************************/
+bool fm_index_c::Rows(const unsigned char *pattern, const size_t length,
+    size_t &begin, size_t &end) const
+{
+    begin = 0;
+    end = m_Length + 1;
+
+    if (length == 0)
+    {
+        return false;
+    }
+
+    for (size_t i = length; i-- > 0;)
+    {
+        unsigned char c = pattern[i];
+
+        begin = m_Before[c] + Occurrences(c, begin);
+        end = m_Before[c] + Occurrences(c, end);
+
+        if (begin >= end)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/***************************************************************************
+*   Method     : Position
+*   Description: This method finds the text position of a row by following
+*                the LF mapping back through the text to a sampled row.
+*                The row of position 0 is always sampled, so the walk
+*                never reaches the end of text entry.
+*   Parameters : row - row to find
+*   Effects    : None
+*   Returned   : Text position of row's suffix
+***************************************************************************/
+size_t fm_index_c::Position(size_t row) const
+{
+    size_t steps, sample, bit, rank;
+
+    for (steps = 0; !(*m_Sampled)[row]; steps++)
+    {
+        unsigned char c = m_Bwt->Access(row, rank);
+
+        if ((c == 0) && (m_Primary < row))
+        {
+            rank--;
+        }
+
+        row = m_Before[c] + rank;
+    }
+
+    bit = m_SampledRanks->Rank1(row) * m_SampleBits;
+    sample = (LoadBigEndian(&m_Samples->Chars()[bit / CHAR_BIT]) <<
+        (bit % CHAR_BIT)) >> (64 - m_SampleBits);
+
+    return (sample * m_SampleRate) + steps;
+}
+
+/***************************************************************************
+*   Method     : Count
+*   Description: This method counts the occurrences of a pattern in the
+*                text.
+*   Parameters : pattern - pattern to search for
+*                length - number of bytes in pattern
+*   Effects    : None
+*   Returned   : Number of occurrences, 0 for an empty pattern
+***************************************************************************/
+size_t fm_index_c::Count(const unsigned char *pattern,
+    const size_t length) const
+{
+    size_t begin, end;
+
+    if (!Rows(pattern, length, begin, end))
+    {
+        return 0;
+    }
+
+    return end - begin;
+}
+
+/***************************************************************************
+*   Method     : Locate
+*   Description: This method finds the text positions of occurrences of a
+*                pattern.  Positions come out in suffix order, not text
+*                order.
+*   Parameters : pattern - pattern to search for
+*                length - number of bytes in pattern
+*                positions - array receiving positions
+*                maxCount - number of entries that fit in positions
+*   Effects    : Up to maxCount positions are written to positions
+*   Returned   : Number of positions written.  If it equals maxCount there
+*                may have been more occurrences than room (see Count).
+***************************************************************************/
+size_t fm_index_c::Locate(const unsigned char *pattern, const size_t length,
+    size_t *positions, const size_t maxCount) const
+{
+    size_t begin, end, written;
+
+    if (!Rows(pattern, length, begin, end))
+    {
+        return 0;
+    }
+
+    written = 0;
+
+    for (size_t row = begin; (row < end) && (written < maxCount); row++)
+    {
+        positions[written++] = Position(row);
+    }
+
+    return written;
+}
@@ -0,0 +1,90 @@
+/***************************************************************************
+*                             FM-Index
+*
+*   File    : fmindex.h
+*   Purpose : Header file for an FM-index, a compressed full-text index
+*             of a byte string that counts and locates the occurrences
+*             of substrings.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef FMINDEX_H
+#define FMINDEX_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <stdint.h>
+#include "bitarray.h"
+#include "rankbits.h"
+#include "wavelet.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class fm_index_c
+{
+    public:
+        fm_index_c(const unsigned char *text, const size_t length,
+            const unsigned int sampleRate, const unsigned int numThreads);
+        virtual ~fm_index_c(void);
+
+        size_t Length() const { return m_Length; };
+        size_t Bytes() const;       /* approximate size of the index */
+
+        /* occurrences of a pattern of at least 1 byte */
+        size_t Count(const unsigned char *pattern,
+            const size_t length) const;
+
+        /* text positions of up to maxCount occurrences, in no order */
+        size_t Locate(const unsigned char *pattern, const size_t length,
+            size_t *positions, const size_t maxCount) const;
+
+    private:
+        /* indices can't be copied */
+        fm_index_c(const fm_index_c &);
+        fm_index_c& operator=(const fm_index_c &);
+
+        template <typename index_t>
+        void Build(const unsigned char *text, const unsigned int numThreads);
+
+        bool Rows(const unsigned char *pattern, const size_t length,
+            size_t &begin, size_t &end) const;
+        size_t Occurrences(const unsigned char c, const size_t row) const;
+        size_t Position(size_t row) const;
+
+        size_t m_Length;                /* bytes of text */
+        size_t m_Primary;               /* row of the whole text */
+        unsigned int m_SampleRate;      /* text positions between samples */
+        unsigned int m_SampleBits;      /* bits in each sample */
+        size_t m_Before[UCHAR_MAX + 2]; /* rows before each byte's rows */
+        huffman_wavelet_c *m_Bwt;       /* Burrows-Wheeler transform */
+        bit_array_c *m_Sampled;         /* rows with a sampled position */
+        rank_select_c *m_SampledRanks;  /* directory for m_Sampled */
+        bit_array_c *m_Samples;         /* packed sampled positions */
+};
+
+#endif  /* ndef FMINDEX_H */
@@ -0,0 +1,768 @@
+/***************************************************************************
+*                          Binary Fuse Filter
+*
+*   File    : fusefilter.cpp
+*   Purpose : Provides a 3-wise binary fuse filter (Graf and Lemire,
+*             "Binary Fuse Filters: Fast and Smaller Than Xor Filters").
+*             It answers set membership queries for a fixed set of keys
+*             with a false positive rate of 2^-8 or 2^-16, using about
+*             1.13 fingerprints per key instead of the 1.44 * bits per key
+*             of a Bloom filter with the same rate.
+*
+*             Each key hashes to three positions, one in each of three
+*             consecutive segments of the fingerprint array.  The filter is
+*             built so that the XOR of a key's three fingerprints equals
+*             the key's own fingerprint.  A lookup recomputes the three
+*             positions and checks that.
+*
+*             Construction peels the key set: a position used by only one
+*             remaining key determines that key's fingerprint, so that key
+*             is pushed on a stack and removed, which may leave other
+*             positions with only one key.  If every key is peeled, the
+*             fingerprints are assigned in reverse order.  Otherwise a new
+*             seed is tried.  Hashing the keys, sorting the hashes by
+*             segment and counting the keys at each position are split
+*             among threads; peeling itself is sequential.
+*
+*             Fingerprints are stored in a bit_array_c, 8 or 16 bits each,
+*             and the filter serializes with the bit array binary format.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "fusefilter.h"
+#include "bitrand.h"
+#include "parallel.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* seeds to try before deciding the keys can't be peeled */
+#define MAX_ATTEMPTS          100
+
+/* largest segment length */
+#define MAX_SEGMENT_LENGTH    262144
+
+/* most pieces the keys are split into for parallel construction */
+#define BUILD_PIECES          64
+
+/* number of keys hashed at a time by batch lookups */
+#define BATCH_KEYS            32
+
+/* serialized filters start with a magic number and version */
+#define SERIAL_MAGIC          "FUSE"
+#define SERIAL_VERSION        1
+#define SERIAL_HEADER_CHARS   (4 + 1 + 1 + (3 * 4) + 8)
+
+/* hint that an address will be read soon */
+#if defined(__GNUC__)
+#define PREFETCH(addr)        __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr)
+#endif
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : MulHi
+*   Description: This function returns the upper 64 bits of the product of
+*                a 64 bit value and a 32 bit value, which maps a hash
+*                uniformly onto [0, range).
+*   Parameters : hash - 64 bit value
+*                range - 32 bit value
+*   Effects    : None
+*   Returned   : (hash * range) >> 64
+***************************************************************************/
+static inline uint64_t MulHi(const uint64_t hash, const uint32_t range)
+{
+    return ((hash >> 32) * range +
+        (((hash & 0xFFFFFFFF) * range) >> 32)) >> 32;
+}
+
+/***************************************************************************
+*   Function   : PutLE / GetLE
+*   Description: These functions store and load an unsigned value as
+*                bytes, least significant first.
+*   Parameters : bytes - location of the value
+*                value - value to store
+*                count - number of bytes
+*   Effects    : PutLE writes count bytes
+*   Returned   : GetLE returns the value
+***************************************************************************/
+static void PutLE(unsigned char *bytes, const uint64_t value,
+    const int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        bytes[i] = (unsigned char)(value >> (CHAR_BIT * i));
+    }
+}
+
+static uint64_t GetLE(const unsigned char *bytes, const int count)
+{
+    uint64_t value = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        value |= (uint64_t)bytes[i] << (CHAR_BIT * i);
+    }
+
+    return value;
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : fuse_filter_c - constructor
+*   Description: This is the fuse_filter_c constructor.  It builds a filter
+*                for a set of keys.  Duplicate keys are allowed.
+*   Parameters : keys - array of keys in the set
+*                count - number of keys
+*                fingerprintBits - 8 or 16
+*                numThreads - maximum number of threads for construction,
+*                    0 for one per hardware thread
+*   Effects    : Allocates and fills in the fingerprints
+*   Returned   : None
+***************************************************************************/
+fuse_filter_c::fuse_filter_c(const uint64_t *keys, const size_t count,
+    const unsigned int fingerprintBits, const unsigned int numThreads):
+    m_FingerprintBits(fingerprintBits),
+    m_Seed(0),
+    m_Fingerprints(NULL)
+{
+    if ((fingerprintBits != 8) && (fingerprintBits != 16))
+    {
+        throw invalid_argument(
+            "Error: Fingerprints must have 8 or 16 bits.");
+    }
+
+    if (count > (UINT32_MAX / 2))
+    {
+        throw length_error("Error: Too many keys for fuse filter.");
+    }
+
+    SetGeometry(count);
+    m_Fingerprints = new bit_array_c((size_t)m_ArrayLength *
+        m_FingerprintBits);
+
+    try
+    {
+        Build(keys, count, numThreads);
+    }
+    catch (...)
+    {
+        delete m_Fingerprints;
+        throw;
+    }
+}
+
+/***************************************************************************
+*   Method     : fuse_filter_c - constructor
+*   Description: This is the fuse_filter_c constructor.  It reads a filter
+*                written by Serialize from a binary stream.
+*   Parameters : inStream - stream to read from
+*   Effects    : Allocates and reads the fingerprints
+*   Returned   : None
+***************************************************************************/
+fuse_filter_c::fuse_filter_c(std::istream &inStream):
+    m_Fingerprints(NULL)
+{
+    unsigned char header[SERIAL_HEADER_CHARS];
+
+    inStream.read((char *)header, SERIAL_HEADER_CHARS);
+
+    if (!inStream || (memcmp(header, SERIAL_MAGIC, 4) != 0) ||
+        (header[4] != SERIAL_VERSION))
+    {
+        throw invalid_argument("Error: Invalid fuse filter stream.");
+    }
+
+    m_FingerprintBits = header[5];
+    m_SegmentLength = (uint32_t)GetLE(&header[6], 4);
+    m_SegmentCount = (uint32_t)GetLE(&header[10], 4);
+    m_ArrayLength = (uint32_t)GetLE(&header[14], 4);
+    m_Seed = GetLE(&header[18], 8);
+
+    m_Fingerprints = new bit_array_c(inStream);
+
+    if (((m_FingerprintBits != 8) && (m_FingerprintBits != 16)) ||
+        (m_SegmentLength == 0) ||
+        ((m_SegmentLength & (m_SegmentLength - 1)) != 0) ||
+        (m_ArrayLength !=
+            ((uint64_t)m_SegmentCount + 2) * m_SegmentLength) ||
+        (m_Fingerprints->Size() !=
+            (size_t)m_ArrayLength * m_FingerprintBits))
+    {
+        delete m_Fingerprints;
+        throw invalid_argument("Error: Invalid fuse filter stream.");
+    }
+}
+
+/***************************************************************************
+*   Method     : ~fuse_filter_c - destructor
+*   Description: This is the fuse_filter_c destructor.  It frees the
+*                fingerprints.
+*   Parameters : None
+*   Effects    : Fingerprints are freed
+*   Returned   : None
+***************************************************************************/
+fuse_filter_c::~fuse_filter_c(void)
+{
+    delete m_Fingerprints;
+}
+
+/***************************************************************************
+*   Method     : SetGeometry
+*   Description: This method picks the segment length and number of
+*                segments for a number of keys, using the parameters from
+*                the binary fuse filter paper.
+*   Parameters : count - number of keys
+*   Effects    : m_SegmentLength, m_SegmentCount and m_ArrayLength are set
+*   Returned   : None
+***************************************************************************/
+void fuse_filter_c::SetGeometry(const size_t count)
+{
+    double sizeFactor;
+    size_t capacity, segments;
+
+    if (count < 2)
+    {
+        m_SegmentLength = 4;
+        capacity = 0;
+    }
+    else
+    {
+        m_SegmentLength = (uint32_t)1 <<
+            (int)floor((log((double)count) / log(3.33)) + 2.25);
+        sizeFactor = max(1.125,
+            0.875 + (0.25 * log(1000000.0) / log((double)count)));
+        capacity = (size_t)floor(((double)count * sizeFactor) + 0.5);
+    }
+
+    m_SegmentLength = min(m_SegmentLength, (uint32_t)MAX_SEGMENT_LENGTH);
+
+    /* keys start in any segment but the last 2 */
+    segments = (capacity + m_SegmentLength - 1) / m_SegmentLength;
+    m_SegmentCount = (segments > 3) ? (uint32_t)(segments - 2) : 1;
+    m_ArrayLength = (m_SegmentCount + 2) * m_SegmentLength;
+}
+
+/***************************************************************************
+*   Method     : Position
+*   Description: This method computes one of the three positions of a
+*                hashed key.  Position i is in segment s + i, where s is
+*                chosen by the high bits of the hash, and the offset within
+*                the segment comes from bits 36 - 18i and up of the hash.
+*   Parameters : index - 0, 1 or 2
+*                hash - hash of the key
+*   Effects    : None
+*   Returned   : Index of a fingerprint
+***************************************************************************/
+uint32_t fuse_filter_c::Position(const int index, const uint64_t hash) const
+{
+    uint64_t position;
+
+    position = MulHi(hash, m_SegmentCount * m_SegmentLength) +
+        ((uint64_t)index * m_SegmentLength);
+    position ^= ((hash & (((uint64_t)1 << 36) - 1)) >> (36 - (18 * index))) &
+        (m_SegmentLength - 1);
+    return (uint32_t)position;
+}
+
+/***************************************************************************
+*   Method     : Fingerprint
+*   Description: This method computes the fingerprint of a hashed key.
+*   Parameters : hash - hash of the key
+*   Effects    : None
+*   Returned   : Fingerprint with m_FingerprintBits bits
+***************************************************************************/
+uint32_t fuse_filter_c::Fingerprint(const uint64_t hash) const
+{
+    return (uint32_t)(hash ^ (hash >> 32)) &
+        (((uint32_t)1 << m_FingerprintBits) - 1);
+}
+
+/***************************************************************************
+*   Method     : Get
+*   Description: This method reads a fingerprint from the bit array.
+*   Parameters : index - index of the fingerprint
+*   Effects    : None
+*   Returned   : Fingerprint
+***************************************************************************/
+uint32_t fuse_filter_c::Get(const size_t index) const
+{
+    const unsigned char *p;
+
+    if (m_FingerprintBits == 8)
+    {
+        return m_Fingerprints->Chars()[index];
+    }
+
+    p = &m_Fingerprints->Chars()[2 * index];
+    return ((uint32_t)p[0] << CHAR_BIT) | p[1];
+}
+
+/***************************************************************************
+*   Method     : Set
+*   Description: This method writes a fingerprint to the bit array.
+*   Parameters : index - index of the fingerprint
+*                value - new fingerprint
+*   Effects    : The fingerprint is replaced
+*   Returned   : None
+***************************************************************************/
+void fuse_filter_c::Set(const size_t index, const uint32_t value)
+{
+    unsigned char *p;
+
+    if (m_FingerprintBits == 8)
+    {
+        m_Fingerprints->Chars()[index] = (unsigned char)value;
+        return;
+    }
+
+    p = &m_Fingerprints->Chars()[2 * index];
+    p[0] = (unsigned char)(value >> CHAR_BIT);
+    p[1] = (unsigned char)value;
+}
+
+/***************************************************************************
+*   Method     : CountPositions
+*   Description: This method adds hashed keys to the per position counts
+*                used for peeling.  A key whose hash matches the one
+*                before it at the same positions is a duplicate, and is
+*                taken back out.
+*   Parameters : hashes - array of key hashes
+*                count - number of hashes
+*                t2count - 4 times the keys at each position, plus the
+*                    XOR of which of their positions it is
+*                t2hash - XOR of the hashes at each position
+*                error - set to 1 if a count overflowed, else 0
+*   Effects    : t2count and t2hash include the keys
+*   Returned   : Number of duplicates found
+***************************************************************************/
+size_t fuse_filter_c::CountPositions(const uint64_t *hashes,
+    const size_t count, unsigned char *t2count, uint64_t *t2hash,
+    unsigned char &error) const
+{
+    uint32_t h[3];
+    size_t duplicates = 0;
+
+    error = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t hash = hashes[i];
+
+        for (int j = 0; j < 3; j++)
+        {
+            h[j] = Position(j, hash);
+            t2count[h[j]] += 4;
+            t2count[h[j]] ^= j;
+            t2hash[h[j]] ^= hash;
+        }
+
+        if ((t2hash[h[0]] & t2hash[h[1]] & t2hash[h[2]]) == 0)
+        {
+            if (((t2hash[h[0]] == 0) && (t2count[h[0]] == 8)) ||
+                ((t2hash[h[1]] == 0) && (t2count[h[1]] == 8)) ||
+                ((t2hash[h[2]] == 0) && (t2count[h[2]] == 8)))
+            {
+                /* the same hash twice: undo the second one */
+                duplicates++;
+
+                for (int j = 0; j < 3; j++)
+                {
+                    t2count[h[j]] -= 4;
+                    t2count[h[j]] ^= j;
+                    t2hash[h[j]] ^= hash;
+                }
+            }
+        }
+
+        for (int j = 0; j < 3; j++)
+        {
+            error |= (t2count[h[j]] < 4) ? 1 : 0;
+        }
+    }
+
+    return duplicates;
+}
+
+/***************************************************************************
+*   Method     : Build
+*   Description: This method peels the key set and assigns fingerprints.
+*                The hashes are first counting sorted into buckets by
+*                their top bits, which orders them by start segment, so
+*                that the counting pass walks the array roughly in order.
+*                For every position, t2count holds 4 times the number of
+*                keys using it plus the XOR of which of the key's three
+*                positions it is, and t2hash holds the XOR of their hashes,
+*                so a position with one key identifies that key directly.
+*
+*                Hashing, sorting and counting are split among threads.
+*                For counting, the buckets are split into pieces that
+*                each span at least 4 segments.  A key's positions are
+*                within 3 segments of its start, so pieces two apart never
+*                touch the same position, and the even pieces are counted
+*                in parallel, then the odd ones.  Peeling is sequential.
+*   Parameters : keys - array of keys in the set
+*                count - number of keys
+*                numThreads - maximum number of threads
+*   Effects    : Fingerprints are filled in
+*   Returned   : None
+***************************************************************************/
+void fuse_filter_c::Build(const uint64_t *keys, const size_t count,
+    const unsigned int numThreads)
+{
+    vector<uint64_t> unique, order, t2hash;
+    vector<uint32_t> alone, bucketStart, histogram, pieceDuplicates;
+    vector<unsigned char> t2count, reverseH, pieceErrors;
+    uint64_t seedState;
+    uint32_t blockBits, block, size, h[5], numPieces, pieceBuckets;
+    size_t stackSize, duplicates;
+    int attempt;
+
+    size = (uint32_t)count;
+    order.resize(size);
+    reverseH.resize(size);
+    t2hash.resize(m_ArrayLength);
+    t2count.resize(m_ArrayLength);
+    alone.resize(m_ArrayLength);
+
+    for (blockBits = 1; ((uint32_t)1 << blockBits) < m_SegmentCount;
+        blockBits++);
+    block = (uint32_t)1 << blockBits;
+    bucketStart.resize(block + 1);
+
+    /* a bucket spans at most one segment, 8 span at least 4 */
+    pieceBuckets = max((uint32_t)8, block / BUILD_PIECES);
+    numPieces = (block + pieceBuckets - 1) / pieceBuckets;
+    pieceErrors.resize(numPieces);
+    pieceDuplicates.resize(numPieces);
+
+    seedState = 0x726B2B9D438B9D4DULL;
+
+    for (attempt = 0; ; attempt++)
+    {
+        bool error = false;
+        uint32_t queued, keyPieces;
+
+        if (attempt >= MAX_ATTEMPTS)
+        {
+            throw runtime_error("Error: Unable to build fuse filter.");
+        }
+
+        m_Seed = bit_random_c::Hash(seedState);
+        seedState += 0x9E3779B97F4A7C15ULL;
+        fill(t2count.begin(), t2count.end(), 0);
+        fill(t2hash.begin(), t2hash.end(), 0);
+
+        /* count the hashes in each bucket for each piece of the keys */
+        keyPieces = (uint32_t)min((size_t)BUILD_PIECES, (size_t)size);
+        histogram.assign((size_t)keyPieces * block, 0);
+
+        ParallelFor(keyPieces, numThreads,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t piece = begin; piece < end; piece++)
+                {
+                    uint32_t *counts = &histogram[piece * block];
+
+                    for (size_t i = (piece * size) / keyPieces;
+                        i < ((piece + 1) * size) / keyPieces; i++)
+                    {
+                        uint64_t hash = bit_random_c::Hash(keys[i] + m_Seed);
+
+                        counts[hash >> (64 - blockBits)]++;
+                    }
+                }
+            });
+
+        /* turn the counts into each piece's offset in each bucket */
+        bucketStart[0] = 0;
+
+        for (uint32_t b = 0; b < block; b++)
+        {
+            uint32_t offset = bucketStart[b];
+
+            for (uint32_t piece = 0; piece < keyPieces; piece++)
+            {
+                uint32_t pieceCount = histogram[((size_t)piece * block) + b];
+
+                histogram[((size_t)piece * block) + b] = offset;
+                offset += pieceCount;
+            }
+
+            bucketStart[b + 1] = offset;
+        }
+
+        /* bucket the hashes by their top bits */
+        ParallelFor(keyPieces, numThreads,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t piece = begin; piece < end; piece++)
+                {
+                    uint32_t *offsets = &histogram[piece * block];
+
+                    for (size_t i = (piece * size) / keyPieces;
+                        i < ((piece + 1) * size) / keyPieces; i++)
+                    {
+                        uint64_t hash = bit_random_c::Hash(keys[i] + m_Seed);
+
+                        order[offsets[hash >> (64 - blockBits)]++] = hash;
+                    }
+                }
+            });
+
+        /* count the keys at every position, even pieces then odd ones */
+        for (uint32_t parity = 0; parity < 2; parity++)
+        {
+            ParallelFor((numPieces + 1 - parity) / 2, numThreads,
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t k = begin; k < end; k++)
+                    {
+                        size_t piece = (2 * k) + parity;
+                        size_t first = min((size_t)block,
+                            piece * pieceBuckets);
+                        size_t last = min((size_t)block,
+                            (piece + 1) * pieceBuckets);
+
+                        pieceDuplicates[piece] = (uint32_t)CountPositions(
+                            order.data() + bucketStart[first],
+                            bucketStart[last] - bucketStart[first],
+                            t2count.data(), t2hash.data(),
+                            pieceErrors[piece]);
+                    }
+                });
+        }
+
+        duplicates = 0;
+
+        for (uint32_t piece = 0; piece < numPieces; piece++)
+        {
+            duplicates += pieceDuplicates[piece];
+            error = error || (pieceErrors[piece] != 0);
+        }
+
+        if (error)
+        {
+            continue;       /* a counter overflowed */
+        }
+
+        /* peel positions used by a single key */
+        queued = 0;
+
+        for (uint32_t i = 0; i < m_ArrayLength; i++)
+        {
+            alone[queued] = i;
+            queued += ((t2count[i] >> 2) == 1) ? 1 : 0;
+        }
+
+        stackSize = 0;
+
+        while (queued > 0)
+        {
+            uint32_t index;
+            uint64_t hash;
+            unsigned char found;
+
+            queued--;
+            index = alone[queued];
+
+            if ((t2count[index] >> 2) != 1)
+            {
+                continue;
+            }
+
+            hash = t2hash[index];
+            found = t2count[index] & 3;
+            h[0] = Position(0, hash);
+            h[1] = Position(1, hash);
+            h[2] = Position(2, hash);
+            h[3] = h[0];
+            h[4] = h[1];
+
+            reverseH[stackSize] = found;
+            order[stackSize] = hash;
+            stackSize++;
+
+            for (int j = 1; j < 3; j++)
+            {
+                uint32_t other = h[found + j];
+
+                alone[queued] = other;
+                queued += ((t2count[other] >> 2) == 2) ? 1 : 0;
+                t2count[other] -= 4;
+                t2count[other] ^= (found + j) % 3;
+                t2hash[other] ^= hash;
+            }
+        }
+
+        if ((stackSize + duplicates) == size)
+        {
+            break;          /* every key was peeled */
+        }
+
+        if (duplicates > 0)
+        {
+            /* drop duplicate keys so they can't block peeling */
+            unique.assign(keys, keys + size);
+            sort(unique.begin(), unique.end());
+            unique.erase(std::unique(unique.begin(), unique.end()),
+                unique.end());
+            keys = &unique[0];
+            size = (uint32_t)unique.size();
+        }
+    }
+
+    /* assign fingerprints in reverse peeling order */
+    for (size_t i = stackSize; i-- > 0;)
+    {
+        uint64_t hash = order[i];
+        unsigned char found = reverseH[i];
+
+        h[0] = Position(0, hash);
+        h[1] = Position(1, hash);
+        h[2] = Position(2, hash);
+        h[3] = h[0];
+        h[4] = h[1];
+
+        Set(h[found], Fingerprint(hash) ^ Get(h[found + 1]) ^
+            Get(h[found + 2]));
+    }
+}
+
+/***************************************************************************
+*   Method     : Contains
+*   Description: This method tests whether a key may be in the set.
+*   Parameters : key - key to look for
+*   Effects    : None
+*   Returned   : true if the key is in the set, and with probability
+*                2^-FingerprintBits() if it isn't
+***************************************************************************/
+bool fuse_filter_c::Contains(const uint64_t key) const
+{
+    uint64_t hash;
+
+    hash = bit_random_c::Hash(key + m_Seed);
+    return ((Fingerprint(hash) ^ Get(Position(0, hash)) ^
+        Get(Position(1, hash)) ^ Get(Position(2, hash))) == 0);
+}
+
+/***************************************************************************
+*   Method     : ContainsBatch
+*   Description: This method tests a list of keys.  A block of keys is
+*                hashed and its fingerprints are prefetched before any of
+*                them are compared, so the cache misses of different keys
+*                overlap.
+*   Parameters : keys - array of keys to look for
+*                count - number of keys
+*                results - array receiving true for each key that may be
+*                    in the set
+*   Effects    : None
+*   Returned   : Number of keys that may be in the set
+***************************************************************************/
+size_t fuse_filter_c::ContainsBatch(const uint64_t *keys, const size_t count,
+    bool *results) const
+{
+    uint64_t hashes[BATCH_KEYS];
+    uint32_t positions[BATCH_KEYS][3];
+    size_t bytes, found;
+
+    bytes = m_FingerprintBits / CHAR_BIT;
+    found = 0;
+
+    for (size_t start = 0; start < count; start += BATCH_KEYS)
+    {
+        size_t n = min((size_t)BATCH_KEYS, count - start);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            hashes[i] = bit_random_c::Hash(keys[start + i] + m_Seed);
+
+            for (int j = 0; j < 3; j++)
+            {
+                positions[i][j] = Position(j, hashes[i]);
+                PREFETCH(&m_Fingerprints->Chars()[positions[i][j] * bytes]);
+            }
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            results[start + i] = ((Fingerprint(hashes[i]) ^
+                Get(positions[i][0]) ^ Get(positions[i][1]) ^
+                Get(positions[i][2])) == 0);
+            found += results[start + i] ? 1 : 0;
+        }
+    }
+
+    return found;
+}
+
+/***************************************************************************
+*   Method     : Serialize
+*   Description: This method writes the filter to a binary stream in a
+*                form that can be read back with the stream constructor.
+*                The format is the 4 characters "FUSE", a version byte,
+*                the fingerprint size, the segment length, segment count
+*                and array length as 4 bytes each and the seed as 8 bytes,
+*                all least significant first, followed by the fingerprints
+*                in bit array format (see bit_array_c::Serialize).
+*   Parameters : outStream - stream to write to
+*   Effects    : Filter is written to outStream
+*   Returned   : None
+***************************************************************************/
+void fuse_filter_c::Serialize(std::ostream &outStream) const
+{
+    unsigned char header[SERIAL_HEADER_CHARS];
+
+    memcpy(header, SERIAL_MAGIC, 4);
+    header[4] = SERIAL_VERSION;
+    header[5] = (unsigned char)m_FingerprintBits;
+    PutLE(&header[6], m_SegmentLength, 4);
+    PutLE(&header[10], m_SegmentCount, 4);
+    PutLE(&header[14], m_ArrayLength, 4);
+    PutLE(&header[18], m_Seed, 8);
+
+    outStream.write((const char *)header, SERIAL_HEADER_CHARS);
+    m_Fingerprints->Serialize(outStream);
+}
@@ -0,0 +1,89 @@
+/***************************************************************************
+*                          Binary Fuse Filter
+*
+*   File    : fusefilter.h
+*   Purpose : Header file for a static set membership filter that stores
+*             8 or 16 bit fingerprints in a bit array.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef FUSE_FILTER_H
+#define FUSE_FILTER_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <istream>
+#include <ostream>
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class fuse_filter_c
+{
+    public:
+        fuse_filter_c(const uint64_t *keys, const size_t count,
+            const unsigned int fingerprintBits,
+            const unsigned int numThreads);
+        fuse_filter_c(std::istream &inStream);  /* from Serialize */
+        virtual ~fuse_filter_c(void);
+
+        size_t Size() const { return m_ArrayLength; };
+        unsigned int FingerprintBits() const { return m_FingerprintBits; };
+
+        /* lookups */
+        bool Contains(const uint64_t key) const;
+        size_t ContainsBatch(const uint64_t *keys, const size_t count,
+            bool *results) const;
+
+        void Serialize(std::ostream &outStream) const;
+
+    private:
+        /* filters can't be copied */
+        fuse_filter_c(const fuse_filter_c &);
+        fuse_filter_c& operator=(const fuse_filter_c &);
+
+        void SetGeometry(const size_t count);
+        void Build(const uint64_t *keys, const size_t count,
+            const unsigned int numThreads);
+        size_t CountPositions(const uint64_t *hashes, const size_t count,
+            unsigned char *t2count, uint64_t *t2hash,
+            unsigned char &error) const;
+        uint32_t Position(const int index, const uint64_t hash) const;
+        uint32_t Fingerprint(const uint64_t hash) const;
+        uint32_t Get(const size_t index) const;
+        void Set(const size_t index, const uint32_t value);
+
+        unsigned int m_FingerprintBits; /* 8 or 16 */
+        uint64_t m_Seed;                /* seed mixed into key hashes */
+        uint32_t m_SegmentLength;       /* fingerprints per segment */
+        uint32_t m_SegmentCount;        /* segments a key may start in */
+        uint32_t m_ArrayLength;         /* total number of fingerprints */
+        bit_array_c *m_Fingerprints;    /* fingerprint storage */
+};
+
+#endif  /* ndef FUSE_FILTER_H */
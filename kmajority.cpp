@@ -0,0 +1,290 @@
+/***************************************************************************
+*                       K-Majority Clustering
+*
+*   File    : kmajority.cpp
+*   Purpose : Provides k-majority clustering, the Hamming space version
+*             of k-means.  Each point (a row of a bit matrix) is assigned
+*             to the centroid with the fewest differing bits, and each
+*             centroid becomes the bitwise majority of its points.  The
+*             two steps repeat until no point changes cluster.
+*
+*             Assignment uses bit_matrix_c::NearestRows, a blocked
+*             XOR-popcount search split among threads.
+*
+*             Centroids are updated with bit-sliced vertical counters.
+*             The count of 1 bits in every column of a cluster is kept as
+*             planes of words: plane p holds bit p of each column's count.
+*             Adding a point is a ripple carry through the planes, one
+*             word of columns at a time, which touches about 2 planes per
+*             word on average.  The majority test count > members / 2 is
+*             then a bit-sliced comparison with a constant, again a word
+*             of columns at a time.  Points are bucketed by cluster with a
+*             counting sort, then threads each own a range of clusters and
+*             read only those clusters' points, so no counters are shared.
+*             A column with a tie (an even number of members, half of them
+*             1) keeps its old centroid bit, and a cluster with no points
+*             keeps its old centroid.
+*
+*             The initial centroids are distinct random points.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "kmajority.h"
+#include "bitrand.h"
+#include "bitwords.h"
+#include "parallel.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : kmajority_c - constructor
+*   Description: This is the kmajority_c constructor.  It picks distinct
+*                random points as the initial centroids.  The points must
+*                not change or be destroyed while the clustering is used.
+*   Parameters : points - matrix with one point per row
+*                numClusters - number of clusters (1 to the number of
+*                    points)
+*                seed - seed for choosing the initial centroids
+*   Effects    : Initial centroids are chosen and no points are assigned
+*   Returned   : None
+***************************************************************************/
+kmajority_c::kmajority_c(const bit_matrix_c &points, const size_t numClusters,
+    const uint64_t seed):
+    m_Points(points),
+    m_Centroids(max((size_t)1, numClusters), points.Cols()),
+    m_Assignments(points.Rows(), UINT32_MAX)
+{
+    bit_random_c rng(seed);
+    vector<size_t> chosen;
+
+    if ((numClusters == 0) || (numClusters > points.Rows()) ||
+        (numClusters >= UINT32_MAX))
+    {
+        throw invalid_argument(
+            "Error: Clusters must be between 1 and the number of points.");
+    }
+
+    /* Floyd's algorithm for numClusters distinct points */
+    for (size_t i = points.Rows() - numClusters; i < points.Rows(); i++)
+    {
+        size_t point = (size_t)rng.Below(i + 1);
+
+        if (find(chosen.begin(), chosen.end(), point) != chosen.end())
+        {
+            point = i;
+        }
+
+        chosen.push_back(point);
+    }
+
+    for (size_t c = 0; c < numClusters; c++)
+    {
+        memcpy(m_Centroids.RowChars(c), points.RowChars(chosen[c]),
+            points.m_RowWords * sizeof(uint64_t));
+    }
+}
+
+/***************************************************************************
+*   Method     : ~kmajority_c - destructor
+*   Description: This is the kmajority_c destructor.  At this point it's
+*                just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+kmajority_c::~kmajority_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : Run
+*   Description: This method alternates assigning points and updating
+*                centroids until no point changes cluster or an iteration
+*                limit is reached.  It may be called again to continue.
+*   Parameters : maxIterations - most assignment steps to run
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : Points are assigned to clusters and centroids updated
+*   Returned   : Number of assignment steps run
+***************************************************************************/
+size_t kmajority_c::Run(const size_t maxIterations,
+    const unsigned int numThreads)
+{
+    size_t iteration;
+
+    for (iteration = 0; iteration < maxIterations; iteration++)
+    {
+        if (m_Points.NearestRows(m_Centroids, &m_Assignments[0], NULL,
+            numThreads) == 0)
+        {
+            return iteration + 1;       /* converged */
+        }
+
+        UpdateCentroids(numThreads);
+    }
+
+    return iteration;
+}
+
+/***************************************************************************
+*   Method     : UpdateCentroids
+*   Description: This method replaces each centroid with the bitwise
+*                majority of the points assigned to it, using bit-sliced
+*                counters.  The points are first bucketed by cluster so
+*                each thread reads only the points of its own clusters.
+*   Parameters : numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : Centroids with at least one point are replaced
+*   Returned   : None
+***************************************************************************/
+void kmajority_c::UpdateCentroids(const unsigned int numThreads)
+{
+    const size_t words = m_Points.m_RowWords;
+    vector<size_t> first(m_Centroids.Rows() + 1, 0);
+    vector<size_t> order(m_Points.Rows());
+    size_t numPlanes;
+
+    /* enough planes to count every point */
+    for (numPlanes = 1; (m_Points.Rows() >> numPlanes) != 0; numPlanes++);
+
+    /* bucket the points by cluster, order[first[c]] onward are cluster c */
+    for (size_t point = 0; point < m_Points.Rows(); point++)
+    {
+        first[m_Assignments[point] + 1]++;
+    }
+
+    for (size_t cluster = 0; cluster < m_Centroids.Rows(); cluster++)
+    {
+        first[cluster + 1] += first[cluster];
+    }
+
+    for (size_t point = 0; point < m_Points.Rows(); point++)
+    {
+        order[first[m_Assignments[point]]++] = point;
+    }
+
+    for (size_t cluster = m_Centroids.Rows(); cluster > 0; cluster--)
+    {
+        first[cluster] = first[cluster - 1];
+    }
+
+    first[0] = 0;
+
+    ParallelFor(m_Centroids.Rows(), numThreads,
+        [&](size_t begin, size_t end)
+        {
+            vector<uint64_t> planes((end - begin) * numPlanes * words, 0);
+            vector<size_t> members(end - begin, 0);
+
+            /* count the 1 bits in each column of each cluster */
+            for (size_t cluster = begin; cluster < end; cluster++)
+            {
+                uint64_t *counter;
+
+                counter = &planes[(cluster - begin) * numPlanes * words];
+                members[cluster - begin] =
+                    first[cluster + 1] - first[cluster];
+
+                for (size_t i = first[cluster]; i < first[cluster + 1]; i++)
+                {
+                    const unsigned char *row = m_Points.RowChars(order[i]);
+
+                    for (size_t w = 0; w < words; w++)
+                    {
+                        uint64_t carry =
+                            LoadWord(&row[w * sizeof(uint64_t)]);
+
+                        for (size_t p = 0; carry != 0; p++)
+                        {
+                            uint64_t *plane = &counter[(p * words) + w];
+                            uint64_t next = *plane & carry;
+
+                            *plane ^= carry;
+                            carry = next;
+                        }
+                    }
+                }
+            }
+
+            /* centroid bit = count > members / 2, old bit on ties */
+            for (size_t cluster = begin; cluster < end; cluster++)
+            {
+                const uint64_t *counter;
+                unsigned char *centroid;
+                size_t half = members[cluster - begin] / 2;
+                bool even = (members[cluster - begin] % 2) == 0;
+
+                if (members[cluster - begin] == 0)
+                {
+                    continue;       /* keep the old centroid */
+                }
+
+                counter = &planes[(cluster - begin) * numPlanes * words];
+                centroid = m_Centroids.RowChars(cluster);
+
+                for (size_t w = 0; w < words; w++)
+                {
+                    uint64_t greater = 0, equal = ~(uint64_t)0, old;
+
+                    for (size_t p = numPlanes; p-- > 0;)
+                    {
+                        uint64_t plane = counter[(p * words) + w];
+
+                        if ((half >> p) & 1)
+                        {
+                            equal &= plane;
+                        }
+                        else
+                        {
+                            greater |= equal & plane;
+                            equal &= ~plane;
+                        }
+                    }
+
+                    old = LoadWord(&centroid[w * sizeof(uint64_t)]);
+
+                    if (even)
+                    {
+                        greater |= equal & old;
+                    }
+
+                    memcpy(&centroid[w * sizeof(uint64_t)], &greater,
+                        sizeof(uint64_t));
+                }
+            }
+        });
+}
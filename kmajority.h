@@ -0,0 +1,74 @@
+/***************************************************************************
+*                       K-Majority Clustering
+*
+*   File    : kmajority.h
+*   Purpose : Header file for a class that clusters the rows of a bit
+*             matrix around bitwise majority centroids.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef K_MAJORITY_H
+#define K_MAJORITY_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <vector>
+#include <stdint.h>
+#include "bitmatrix.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class kmajority_c
+{
+    public:
+        kmajority_c(const bit_matrix_c &points, const size_t numClusters,
+            const uint64_t seed);
+        virtual ~kmajority_c(void);
+
+        size_t Clusters() const { return m_Centroids.Rows(); };
+
+        /* returns the number of iterations run */
+        size_t Run(const size_t maxIterations,
+            const unsigned int numThreads);
+
+        const bit_matrix_c &Centroids(void) const { return m_Centroids; };
+        uint32_t Cluster(const size_t point) const
+            { return m_Assignments[point]; };
+
+    private:
+        /* clusterings can't be copied */
+        kmajority_c(const kmajority_c &);
+        kmajority_c& operator=(const kmajority_c &);
+
+        void UpdateCentroids(const unsigned int numThreads);
+
+        const bit_matrix_c &m_Points;           /* points being clustered */
+        bit_matrix_c m_Centroids;               /* one row per cluster */
+        std::vector<uint32_t> m_Assignments;    /* cluster of each point */
+};
+
+#endif  /* ndef K_MAJORITY_H */
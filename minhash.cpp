@@ -0,0 +1,315 @@
+/***************************************************************************
+*                            b-bit MinHash
+*
+*   File    : minhash.cpp
+*   Purpose : Provides b-bit MinHash signatures (Li and Konig, "b-Bit
+*             Minwise Hashing").  A MinHash signature of a set keeps, for
+*             each of k hash functions, the smallest hash of any member.
+*             Two sets have the same minimum for a hash function with
+*             probability equal to their Jaccard similarity.  A b-bit
+*             signature keeps only the lowest b bits of each minimum, so
+*             a signature of k hashes takes k * b bits.  Unequal minimums
+*             then match with probability about 2^-b, which the similarity
+*             estimate corrects for.
+*
+*             Tokens are hashed once with bit_random_c::Hash and the k
+*             hash functions are h_i(x) = a_i * x + c_i mod 2^64 with odd
+*             a_i.  The inner loop over the k functions is independent
+*             multiplies, adds and minimums, which compilers vectorize.
+*             The low bits of a_i * x + c_i only depend on the low bits of
+*             x, so the b bits kept start at bit 32 of the minimum.
+*
+*             Signatures are written directly into the unsigned chars of a
+*             bit array, b bits per hash with the first hash in the most
+*             significant bits.  Signatures must be a whole number of
+*             bytes, so a batch split among threads never has two threads
+*             writing the same byte, and two signatures are compared a
+*             word at a time: XOR the words, fold each b bit lane into its
+*             low bit, and count the lanes that differ.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "minhash.h"
+#include "bitrand.h"
+#include "bitwords.h"
+#include "parallel.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* number of tokens hashed at a time */
+#define BATCH_TOKENS          64
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : LaneMask
+*   Description: This function returns a 64 bit word with the lowest bit
+*                of every lane of a given width set.
+*   Parameters : laneBits - width of the lanes (a power of 2 up to 64)
+*   Effects    : None
+*   Returned   : Mask of the lowest bit of each lane
+***************************************************************************/
+static uint64_t LaneMask(const unsigned int laneBits)
+{
+    uint64_t mask = 0;
+
+    for (unsigned int i = 0; i < 64; i += laneBits)
+    {
+        mask |= (uint64_t)1 << i;
+    }
+
+    return mask;
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : minhash_c - constructor
+*   Description: This is the minhash_c constructor.  It derives the hash
+*                functions from a seed.  Signatures can only be compared
+*                if they were built with the same seed.
+*   Parameters : numHashes - number of hash functions
+*                bitsPerHash - bits kept of each minimum (1, 2, 4, 8 or 16)
+*                seed - value selecting the hash functions
+*   Effects    : Hash functions are chosen
+*   Returned   : None
+***************************************************************************/
+minhash_c::minhash_c(const size_t numHashes, const unsigned int bitsPerHash,
+    const uint64_t seed):
+    m_NumHashes(numHashes),
+    m_BitsPerHash(bitsPerHash),
+    m_Multiply(numHashes),
+    m_Add(numHashes)
+{
+    if ((bitsPerHash == 0) || (bitsPerHash > 16) ||
+        ((bitsPerHash & (bitsPerHash - 1)) != 0))
+    {
+        throw invalid_argument(
+            "Error: MinHash must keep 1, 2, 4, 8 or 16 bits per hash.");
+    }
+
+    if ((numHashes == 0) || (((numHashes * bitsPerHash) % CHAR_BIT) != 0))
+    {
+        throw invalid_argument(
+            "Error: MinHash signature must be a whole number of bytes.");
+    }
+
+    for (size_t i = 0; i < numHashes; i++)
+    {
+        m_Multiply[i] = bit_random_c::Hash(seed + (2 * i)) | 1;
+        m_Add[i] = bit_random_c::Hash(seed + (2 * i) + 1);
+    }
+}
+
+/***************************************************************************
+*   Method     : ~minhash_c - destructor
+*   Description: This is the minhash_c destructor.  At this point it's
+*                just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+minhash_c::~minhash_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : Signature
+*   Description: This method builds the signature of a set of tokens and
+*                stores it in a bit array.  Repeated tokens don't change
+*                the signature.  A signature that doesn't fit in the array
+*                is not written.
+*   Parameters : tokens - array of tokens in the set
+*                count - number of tokens
+*                signatures - array receiving the signature
+*                index - position of the signature in signatures
+*   Effects    : Signature index of signatures is replaced
+*   Returned   : None
+***************************************************************************/
+void minhash_c::Signature(const uint64_t *tokens, const size_t count,
+    bit_array_c &signatures, const size_t index) const
+{
+    vector<uint64_t> minimums(m_NumHashes, UINT64_MAX);
+    uint64_t hashes[BATCH_TOKENS];
+    unsigned char *chars;
+    uint64_t laneMask;
+
+    if (signatures.Size() / SignatureBits() <= index)
+    {
+        return;         /* signature out of range */
+    }
+
+    for (size_t start = 0; start < count; start += BATCH_TOKENS)
+    {
+        size_t n = min((size_t)BATCH_TOKENS, count - start);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            hashes[i] = bit_random_c::Hash(tokens[start + i]);
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            const uint64_t x = hashes[i];
+
+            for (size_t j = 0; j < m_NumHashes; j++)
+            {
+                minimums[j] = min(minimums[j],
+                    (m_Multiply[j] * x) + m_Add[j]);
+            }
+        }
+    }
+
+    /* pack b bits from the middle of each minimum */
+    chars = &signatures.Chars()[(index * SignatureBits()) / CHAR_BIT];
+    laneMask = ((uint64_t)1 << m_BitsPerHash) - 1;
+    memset(chars, 0, SignatureBits() / CHAR_BIT);
+
+    for (size_t i = 0; i < m_NumHashes; i++)
+    {
+        size_t bit = i * m_BitsPerHash;
+        unsigned int value = (unsigned int)((minimums[i] >> 32) & laneMask);
+
+        if (m_BitsPerHash > CHAR_BIT)
+        {
+            chars[bit / CHAR_BIT] = (unsigned char)(value >> CHAR_BIT);
+            chars[(bit / CHAR_BIT) + 1] = (unsigned char)value;
+        }
+        else
+        {
+            chars[bit / CHAR_BIT] |= (unsigned char)(value <<
+                (CHAR_BIT - m_BitsPerHash - (bit % CHAR_BIT)));
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : SignatureBatch
+*   Description: This method builds the signatures of a list of documents,
+*                splitting the documents among threads.
+*   Parameters : documents - array of pointers to each document's tokens
+*                lengths - array of the number of tokens in each document
+*                count - number of documents
+*                signatures - array receiving signature i of document i
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : Signatures 0 to count - 1 of signatures are replaced
+*   Returned   : None
+***************************************************************************/
+void minhash_c::SignatureBatch(const uint64_t *const *documents,
+    const size_t *lengths, const size_t count, bit_array_c &signatures,
+    const unsigned int numThreads) const
+{
+    ParallelFor(count, numThreads,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                Signature(documents[i], lengths[i], signatures, i);
+            }
+        });
+}
+
+/***************************************************************************
+*   Method     : Similarity
+*   Description: This method estimates the Jaccard similarity of the sets
+*                of two signatures.  If P is the fraction of hashes with
+*                equal b bit values, the estimate is
+*                (P - 2^-b) / (1 - 2^-b), limited to [0, 1].
+*   Parameters : a - array containing the first signature
+*                aIndex - position of the signature in a
+*                b - array containing the second signature
+*                bIndex - position of the signature in b
+*   Effects    : None
+*   Returned   : Estimated similarity, 0 if a signature is out of range
+***************************************************************************/
+double minhash_c::Similarity(const bit_array_c &a, const size_t aIndex,
+    const bit_array_c &b, const size_t bIndex) const
+{
+    const unsigned char *aChars, *bChars;
+    size_t numChars, differ, i;
+    uint64_t laneMask, word;
+    double match, chance;
+
+    if ((a.Size() / SignatureBits() <= aIndex) ||
+        (b.Size() / SignatureBits() <= bIndex))
+    {
+        return 0.0;     /* signature out of range */
+    }
+
+    numChars = SignatureBits() / CHAR_BIT;
+    aChars = &a.Chars()[aIndex * numChars];
+    bChars = &b.Chars()[bIndex * numChars];
+    laneMask = LaneMask(m_BitsPerHash);
+    differ = 0;
+
+    for (i = 0; ; i += sizeof(uint64_t))
+    {
+        if (i + sizeof(uint64_t) <= numChars)
+        {
+            word = LoadWord(&aChars[i]) ^ LoadWord(&bChars[i]);
+        }
+        else if (i < numChars)
+        {
+            uint64_t aWord = 0, bWord = 0;
+
+            memcpy(&aWord, &aChars[i], numChars - i);
+            memcpy(&bWord, &bChars[i], numChars - i);
+            word = aWord ^ bWord;
+        }
+        else
+        {
+            break;
+        }
+
+        /* fold each lane into its lowest bit */
+        for (unsigned int shift = 1; shift < m_BitsPerHash; shift <<= 1)
+        {
+            word |= word >> shift;
+        }
+
+        differ += PopCount(word & laneMask);
+    }
+
+    match = (double)(m_NumHashes - differ) / (double)m_NumHashes;
+    chance = 1.0 / (double)(1 << m_BitsPerHash);
+    return max(0.0, (match - chance) / (1.0 - chance));
+}
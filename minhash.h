@@ -0,0 +1,77 @@
+/***************************************************************************
+*                            b-bit MinHash
+*
+*   File    : minhash.h
+*   Purpose : Header file for a class that builds b-bit MinHash signatures
+*             of token sets in bit arrays and estimates the Jaccard
+*             similarity of two sets from their signatures.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef MIN_HASH_H
+#define MIN_HASH_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <vector>
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class minhash_c
+{
+    public:
+        minhash_c(const size_t numHashes, const unsigned int bitsPerHash,
+            const uint64_t seed);
+        virtual ~minhash_c(void);
+
+        size_t Hashes() const { return m_NumHashes; };
+        unsigned int BitsPerHash() const { return m_BitsPerHash; };
+        size_t SignatureBits() const
+            { return m_NumHashes * m_BitsPerHash; };
+
+        /* signature index of an array holds bits [index * SignatureBits(),
+         * (index + 1) * SignatureBits()) */
+        void Signature(const uint64_t *tokens, const size_t count,
+            bit_array_c &signatures, const size_t index) const;
+        void SignatureBatch(const uint64_t *const *documents,
+            const size_t *lengths, const size_t count,
+            bit_array_c &signatures, const unsigned int numThreads) const;
+
+        /* estimated Jaccard similarity of two signatures */
+        double Similarity(const bit_array_c &a, const size_t aIndex,
+            const bit_array_c &b, const size_t bIndex) const;
+
+    private:
+        size_t m_NumHashes;             /* hash functions per signature */
+        unsigned int m_BitsPerHash;     /* 1, 2, 4, 8 or 16 */
+        std::vector<uint64_t> m_Multiply;   /* odd multipliers */
+        std::vector<uint64_t> m_Add;        /* addends */
+};
+
+#endif  /* ndef MIN_HASH_H */
@@ -0,0 +1,207 @@
+/***************************************************************************
+*                    Arrays of Packed 4 Bit Counters
+*
+*   File    : nibbles.cpp
+*   Purpose : Provides an array of 4 bit counters packed two to a byte.
+*             The counters live in the storage of a bit_array_c, so an
+*             array of n counters takes n / 2 bytes.  Increment stops at
+*             NIBBLE_MAX and Decrement stops at 0.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include "nibbles.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* array index for character containing counter */
+#define COUNTER_CHAR(counter)   ((counter) / 2)
+
+/* shift of counter within its character, the first counter is high */
+#define COUNTER_SHIFT(counter)  (((counter) & 1) ? 0 : 4)
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : nibble_array_c - constructor
+*   Description: This is the nibble_array_c constructor.  It allocates 4
+*                bits for each counter.
+*   Parameters : numCounters - number of counters in the array
+*   Effects    : Allocates the array with all counters 0
+*   Returned   : None
+***************************************************************************/
+nibble_array_c::nibble_array_c(const size_t numCounters):
+    bit_array_c(numCounters * 4)
+{
+}
+
+/***************************************************************************
+*   Method     : ~nibble_array_c - destructor
+*   Description: This is the nibble_array_c destructor.  At this point it's
+*                just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+nibble_array_c::~nibble_array_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : Get
+*   Description: This method returns the value of a counter.
+*   Parameters : counter - index of the counter
+*   Effects    : None
+*   Returned   : Value of the counter.  0 if it's out of range.
+***************************************************************************/
+unsigned int nibble_array_c::Get(const size_t counter) const
+{
+    if (counter >= Size())
+    {
+        return 0;       /* counter out of range */
+    }
+
+    return (m_Array[COUNTER_CHAR(counter)] >> COUNTER_SHIFT(counter)) &
+        NIBBLE_MAX;
+}
+
+/***************************************************************************
+*   Method     : Set
+*   Description: This method sets the value of a counter.
+*   Parameters : counter - index of the counter
+*                value - new value, values above NIBBLE_MAX are stored as
+*                    NIBBLE_MAX
+*   Effects    : The counter holds the new value
+*   Returned   : None
+***************************************************************************/
+void nibble_array_c::Set(const size_t counter, const unsigned int value)
+{
+    unsigned char *c;
+
+    if (counter >= Size())
+    {
+        return;         /* counter out of range */
+    }
+
+    c = &m_Array[COUNTER_CHAR(counter)];
+    *c = (*c & ~(NIBBLE_MAX << COUNTER_SHIFT(counter))) |
+        (((value < NIBBLE_MAX) ? value : NIBBLE_MAX) <<
+            COUNTER_SHIFT(counter));
+}
+
+/***************************************************************************
+*   Method     : Increment
+*   Description: This method adds 1 to a counter unless it's already
+*                NIBBLE_MAX.
+*   Parameters : counter - index of the counter
+*   Effects    : The counter is incremented
+*   Returned   : New value of the counter
+***************************************************************************/
+unsigned int nibble_array_c::Increment(const size_t counter)
+{
+    unsigned int value;
+
+    value = Get(counter);
+
+    if (value < NIBBLE_MAX)
+    {
+        value++;
+        Set(counter, value);
+    }
+
+    return value;
+}
+
+/***************************************************************************
+*   Method     : Decrement
+*   Description: This method subtracts 1 from a counter unless it's
+*                already 0.
+*   Parameters : counter - index of the counter
+*   Effects    : The counter is decremented
+*   Returned   : New value of the counter
+***************************************************************************/
+unsigned int nibble_array_c::Decrement(const size_t counter)
+{
+    unsigned int value;
+
+    value = Get(counter);
+
+    if (value > 0)
+    {
+        value--;
+        Set(counter, value);
+    }
+
+    return value;
+}
+
+/***************************************************************************
+*   Method     : NonZero
+*   Description: This method sets bit i of a bit array if counter i is not
+*                0.  Four characters of counters produce one character of
+*                bits.
+*   Parameters : dest - bit array with one bit per counter
+*   Effects    : dest holds the non-zero counters.  dest is unchanged if
+*                its size doesn't match.
+*   Returned   : None
+***************************************************************************/
+void nibble_array_c::NonZero(bit_array_c &dest) const
+{
+    size_t chars, size;
+
+    if (dest.Size() != Size())
+    {
+        return;
+    }
+
+    chars = (m_NumBits + CHAR_BIT - 1) / CHAR_BIT;
+    size = (dest.Size() + CHAR_BIT - 1) / CHAR_BIT;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        unsigned char bits = 0;
+
+        /* each source character supplies two bits */
+        for (size_t j = 0; j < 4; j++)
+        {
+            unsigned char c;
+
+            c = ((4 * i) + j < chars) ? m_Array[(4 * i) + j] : 0;
+            bits = (bits << 2) | (((c & 0xF0) != 0) ? 2 : 0) |
+                (((c & 0x0F) != 0) ? 1 : 0);
+        }
+
+        dest.Chars()[i] = bits;
+    }
+}
@@ -0,0 +1,78 @@
+/***************************************************************************
+*                    Arrays of Packed 4 Bit Counters
+*
+*   File    : nibbles.h
+*   Purpose : Header file for a class that packs saturating 4 bit counters
+*             two to a byte in bit array storage.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef NIBBLES_H
+#define NIBBLES_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include "bitarray.h"
+
+/***************************************************************************
+*                                CONSTANTS
+***************************************************************************/
+#define NIBBLE_MAX      15              /* largest counter value */
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/***************************************************************************
+* Counter i occupies bits 4i through 4i + 3 of the underlying bit array,
+* most significant bit first, so each byte holds two counters.
+***************************************************************************/
+class nibble_array_c : protected bit_array_c
+{
+    public:
+        nibble_array_c(const size_t numCounters);
+        virtual ~nibble_array_c(void);
+
+        size_t Size() const { return m_NumBits / 4; };
+
+        using bit_array_c::ClearAll;
+
+        /* counter access */
+        unsigned int Get(const size_t counter) const;
+        void Set(const size_t counter, const unsigned int value);
+        unsigned int Increment(const size_t counter);   /* saturates */
+        unsigned int Decrement(const size_t counter);   /* stops at 0 */
+
+        /* bit i of dest = (counter i != 0) */
+        void NonZero(bit_array_c &dest) const;
+
+    private:
+        /* counter arrays can't be copied */
+        nibble_array_c(const nibble_array_c &);
+        nibble_array_c& operator=(const nibble_array_c &);
+};
+
+#endif  /* ndef NIBBLES_H */
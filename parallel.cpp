@@ -0,0 +1,133 @@
+/***************************************************************************
+*                         Parallel Loop Helper
+*
+*   File    : parallel.cpp
+*   Purpose : Provides a function that splits a loop over a range of
+*             items into one contiguous piece per thread.  The calling
+*             thread does the first piece itself, so a single thread runs
+*             with no thread creation at all.
+*
+*             The pieces are contiguous and in order, so work that writes
+*             whole bytes of a shared bit array for each item (for example
+*             signatures that are a whole number of bytes) never has two
+*             threads writing the same byte.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+#include "parallel.h"
+
+using namespace std;
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : ParallelFor
+*   Description: This function divides [0, count) into at most numThreads
+*                contiguous pieces of nearly equal size and calls work on
+*                each piece in its own thread.  It returns when every
+*                piece is done.  If work throws, the first exception is
+*                rethrown after all of the threads finish.
+*   Parameters : count - number of items
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*                work - function called with the first item of a piece
+*                    and one past its last item
+*   Effects    : work is called on every item
+*   Returned   : None
+***************************************************************************/
+void ParallelFor(const size_t count, unsigned int numThreads,
+    const std::function<void(size_t, size_t)> &work)
+{
+    vector<thread> threads;
+    vector<exception_ptr> errors;
+    size_t pieces;
+
+    if (numThreads == 0)
+    {
+        numThreads = max(1U, thread::hardware_concurrency());
+    }
+
+    pieces = min((size_t)numThreads, count);
+
+    if (pieces <= 1)
+    {
+        if (count > 0)
+        {
+            work(0, count);
+        }
+
+        return;
+    }
+
+    errors.resize(pieces);
+
+    try
+    {
+        for (size_t i = 1; i < pieces; i++)
+        {
+            threads.push_back(thread([&, i]()
+            {
+                try
+                {
+                    work((count * i) / pieces, (count * (i + 1)) / pieces);
+                }
+                catch (...)
+                {
+                    errors[i] = current_exception();
+                }
+            }));
+        }
+
+        work(0, count / pieces);
+    }
+    catch (...)
+    {
+        /* the first piece failed or a thread couldn't be started */
+        errors[0] = current_exception();
+    }
+
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    for (size_t i = 0; i < pieces; i++)
+    {
+        if (errors[i])
+        {
+            rethrow_exception(errors[i]);
+        }
+    }
+}
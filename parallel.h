@@ -0,0 +1,49 @@
+/***************************************************************************
+*                         Parallel Loop Helper
+*
+*   File    : parallel.h
+*   Purpose : Header file for a function that splits a loop over a range
+*             of items among threads.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <cstddef>
+#include <functional>
+
+/***************************************************************************
+*                               PROTOTYPES
+***************************************************************************/
+
+/* calls work(begin, end) on pieces of [0, count); 0 threads = 1 per core */
+void ParallelFor(const size_t count, unsigned int numThreads,
+    const std::function<void(size_t, size_t)> &work);
+
+#endif  /* ndef PARALLEL_H */
@@ -0,0 +1,361 @@
+/***************************************************************************
+*                        Rank/Select Directory
+*
+*   File    : rankbits.cpp
+*   Purpose : Provides a directory of counts that answers rank (how many
+*             1s or 0s come before a position) and select (where is the
+*             k-th 1 or 0) on a bit array without scanning it.
+*
+*             The bits are divided into blocks of BLOCK_WORDS 64 bit
+*             words.  The directory stores the number of 1s before each
+*             block, so a rank is one table lookup plus at most
+*             BLOCK_WORDS popcounts.  The directory takes 64 bits per
+*             512 bits, 12.5% of the array.
+*
+*             Select first looks up the blocks that hold every
+*             SELECT_SAMPLE-th 1 (or 0), which brackets the answer.  A
+*             binary search of the block counts between them finds the
+*             block, and the block is scanned a word and then a byte at a
+*             time.
+*
+*             The directory reads the bit array in place; it doesn't copy
+*             it.  Bit i of the array is bit 63 - (i % 64) of word i / 64,
+*             so ranks within a word are popcounts of its upper bits.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include "rankbits.h"
+#include "bitwords.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* bits in a word */
+#define WORD_BITS             64
+
+/* words in a block of the directory */
+#define BLOCK_WORDS           8
+#define BLOCK_BITS            (BLOCK_WORDS * WORD_BITS)
+
+/* 1s (or 0s) between select samples */
+#define SELECT_SAMPLE         4096
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : SelectInWord
+*   Description: This function finds the position of a set bit in a word,
+*                counting from the most significant bit.
+*   Parameters : word - word to search
+*                rank - number of set bits to skip (less than the number
+*                    of bits set in word)
+*   Effects    : None
+*   Returned   : Position (0 is the MSB) of set bit number rank
+***************************************************************************/
+static size_t SelectInWord(const uint64_t word, size_t rank)
+{
+    size_t pos = 0;
+
+    /* skip whole bytes */
+    for (;;)
+    {
+        size_t count = PopCount((word >> (WORD_BITS - CHAR_BIT - pos)) &
+            UCHAR_MAX);
+
+        if (rank < count)
+        {
+            break;
+        }
+
+        rank -= count;
+        pos += CHAR_BIT;
+    }
+
+    /* then bits */
+    for (;; pos++)
+    {
+        if ((word >> (WORD_BITS - 1 - pos)) & 1)
+        {
+            if (rank == 0)
+            {
+                return pos;
+            }
+
+            rank--;
+        }
+    }
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : rank_select_c - constructor
+*   Description: This is the rank_select_c constructor.  It counts the
+*                bits of the array and builds the directory.
+*   Parameters : bits - array to index
+*   Effects    : Directory is built
+*   Returned   : None
+***************************************************************************/
+rank_select_c::rank_select_c(const bit_array_c &bits):
+    m_Bits(bits)
+{
+    size_t numBlocks, ones, zeros;
+
+    m_NumWords = (bits.Size() + WORD_BITS - 1) / WORD_BITS;
+    numBlocks = (m_NumWords + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    m_Blocks.resize(numBlocks + 1);
+    ones = 0;
+
+    for (size_t block = 0; block < numBlocks; block++)
+    {
+        size_t last = min(m_NumWords, (block + 1) * BLOCK_WORDS);
+
+        m_Blocks[block] = ones;
+
+        for (size_t w = block * BLOCK_WORDS; w < last; w++)
+        {
+            ones += PopCount(Word(w));
+        }
+    }
+
+    m_Blocks[numBlocks] = ones;
+
+    /* note the blocks holding every SELECT_SAMPLE-th 1 and 0 */
+    for (size_t block = 0; block < numBlocks; block++)
+    {
+        ones = m_Blocks[block + 1];
+        zeros = min((block + 1) * BLOCK_BITS, bits.Size()) - ones;
+
+        while ((m_OneSamples.size() * SELECT_SAMPLE) < ones)
+        {
+            m_OneSamples.push_back(block);
+        }
+
+        while ((m_ZeroSamples.size() * SELECT_SAMPLE) < zeros)
+        {
+            m_ZeroSamples.push_back(block);
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : ~rank_select_c - destructor
+*   Description: This is the rank_select_c destructor.  At this point it's
+*                just a place holder.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : None
+***************************************************************************/
+rank_select_c::~rank_select_c(void)
+{
+}
+
+/***************************************************************************
+*   Method     : Word
+*   Description: This method returns a 64 bit word of the array with its
+*                first bit in the most significant position.  Bits past
+*                the end of the array are 0.
+*   Parameters : index - index of the word
+*   Effects    : None
+*   Returned   : The word
+***************************************************************************/
+uint64_t rank_select_c::Word(const size_t index) const
+{
+    size_t numChars = (m_Bits.Size() + CHAR_BIT - 1) / CHAR_BIT;
+    size_t first = index * sizeof(uint64_t);
+    unsigned char chars[sizeof(uint64_t)];
+
+    if ((first + sizeof(uint64_t)) <= numChars)
+    {
+        return LoadBigEndian(&m_Bits.Chars()[first]);
+    }
+
+    memset(chars, 0, sizeof(chars));
+    memcpy(chars, &m_Bits.Chars()[first], numChars - first);
+    return LoadBigEndian(chars);
+}
+
+/***************************************************************************
+*   Method     : Rank1
+*   Description: This method counts the 1s before a position.
+*   Parameters : pos - position (positions past the end count as Size())
+*   Effects    : None
+*   Returned   : Number of 1s in bits [0, pos)
+***************************************************************************/
+size_t rank_select_c::Rank1(const size_t pos) const
+{
+    size_t end, rank, word, bits;
+
+    end = min(pos, m_Bits.Size());
+    word = end / WORD_BITS;
+    bits = end % WORD_BITS;
+    rank = m_Blocks[end / BLOCK_BITS];
+
+    for (size_t w = (end / BLOCK_BITS) * BLOCK_WORDS; w < word; w++)
+    {
+        rank += PopCount(Word(w));
+    }
+
+    if (bits != 0)
+    {
+        rank += PopCount(Word(word) >> (WORD_BITS - bits));
+    }
+
+    return rank;
+}
+
+/***************************************************************************
+*   Method     : Rank0
+*   Description: This method counts the 0s before a position.
+*   Parameters : pos - position (positions past the end count as Size())
+*   Effects    : None
+*   Returned   : Number of 0s in bits [0, pos)
+***************************************************************************/
+size_t rank_select_c::Rank0(const size_t pos) const
+{
+    return min(pos, m_Bits.Size()) - Rank1(pos);
+}
+
+/***************************************************************************
+*   Method     : SelectBlock
+*   Description: This method finds the block holding a 1 or 0, using the
+*                samples to limit a binary search of the block counts.
+*   Parameters : rank - number of the 1 or 0 (must exist)
+*                ones - true to find a 1, false to find a 0
+*   Effects    : None
+*   Returned   : Index of the block
+***************************************************************************/
+size_t rank_select_c::SelectBlock(const size_t rank, const bool ones) const
+{
+    const vector<size_t> &samples = ones ? m_OneSamples : m_ZeroSamples;
+    size_t low, high;
+
+    low = samples[rank / SELECT_SAMPLE];
+    high = ((rank / SELECT_SAMPLE) + 1 < samples.size()) ?
+        samples[(rank / SELECT_SAMPLE) + 1] : (m_Blocks.size() - 2);
+
+    /* last block with fewer than rank + 1 1s (or 0s) before it */
+    while (low < high)
+    {
+        size_t mid = low + ((high - low + 1) / 2);
+        size_t before = ones ? m_Blocks[mid] :
+            ((mid * BLOCK_BITS) - m_Blocks[mid]);
+
+        if (before <= rank)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    return low;
+}
+
+/***************************************************************************
+*   Method     : Select1
+*   Description: This method finds the position of a 1.
+*   Parameters : rank - number of the 1, counting from 0
+*   Effects    : None
+*   Returned   : Position of 1 number rank, Size() if there are no more
+*                than rank 1s
+***************************************************************************/
+size_t rank_select_c::Select1(const size_t rank) const
+{
+    size_t block, remaining, w;
+
+    if (rank >= Ones())
+    {
+        return m_Bits.Size();
+    }
+
+    block = SelectBlock(rank, true);
+    remaining = rank - m_Blocks[block];
+
+    for (w = block * BLOCK_WORDS; ; w++)
+    {
+        size_t count = PopCount(Word(w));
+
+        if (remaining < count)
+        {
+            break;
+        }
+
+        remaining -= count;
+    }
+
+    return (w * WORD_BITS) + SelectInWord(Word(w), remaining);
+}
+
+/***************************************************************************
+*   Method     : Select0
+*   Description: This method finds the position of a 0.
+*   Parameters : rank - number of the 0, counting from 0
+*   Effects    : None
+*   Returned   : Position of 0 number rank, Size() if there are no more
+*                than rank 0s
+***************************************************************************/
+size_t rank_select_c::Select0(const size_t rank) const
+{
+    size_t block, remaining, w;
+
+    if (rank >= (m_Bits.Size() - Ones()))
+    {
+        return m_Bits.Size();
+    }
+
+    block = SelectBlock(rank, false);
+    remaining = rank - ((block * BLOCK_BITS) - m_Blocks[block]);
+
+    for (w = block * BLOCK_WORDS; ; w++)
+    {
+        size_t count = WORD_BITS - PopCount(Word(w));
+
+        if (remaining < count)
+        {
+            break;
+        }
+
+        remaining -= count;
+    }
+
+    return (w * WORD_BITS) + SelectInWord(~Word(w), remaining);
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+*                        Rank/Select Directory
+*
+*   File    : rankbits.h
+*   Purpose : Header file for a directory that answers rank and select
+*             queries on a bit array in constant or logarithmic time.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef RANK_BITS_H
+#define RANK_BITS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <vector>
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class rank_select_c
+{
+    public:
+        /* bits must not change or be destroyed while the directory is used */
+        rank_select_c(const bit_array_c &bits);
+        virtual ~rank_select_c(void);
+
+        size_t Size() const { return m_Bits.Size(); };
+        size_t Ones() const { return m_Blocks.back(); };
+
+        /* number of 1s or 0s in bits [0, pos) */
+        size_t Rank1(const size_t pos) const;
+        size_t Rank0(const size_t pos) const;
+
+        /* position of 1 or 0 number rank (from 0), Size() if none */
+        size_t Select1(const size_t rank) const;
+        size_t Select0(const size_t rank) const;
+
+    private:
+        /* directories can't be copied */
+        rank_select_c(const rank_select_c &);
+        rank_select_c& operator=(const rank_select_c &);
+
+        uint64_t Word(const size_t index) const;
+        size_t SelectBlock(const size_t rank, const bool ones) const;
+
+        const bit_array_c &m_Bits;      /* array being indexed */
+        size_t m_NumWords;              /* 64 bit words in m_Bits */
+
+        /* m_Blocks[i] = 1s before block i, one extra entry for the total */
+        std::vector<uint64_t> m_Blocks;
+
+        /* blocks holding every SELECT_SAMPLE-th 1 and 0 */
+        std::vector<size_t> m_OneSamples;
+        std::vector<size_t> m_ZeroSamples;
+};
+
+#endif  /* ndef RANK_BITS_H */
@@ -0,0 +1,544 @@
+/***************************************************************************
+*              Read-Copy-Update Arrays of Arbitrary Bit Length
+*
+*   File    : rcubits.cpp
+*   Purpose : Provides an array of bits that readers may query without
+*             ever blocking while a single writer applies updates.
+*
+*             The array is split into chunks, each a bit_array_c.  A
+*             version of the array is a table of chunk pointers.  The
+*             writer builds a pending version that shares every chunk with
+*             the published version until the chunk is first written,
+*             when it is copied (copy-on-write).  Publish makes the pending
+*             version current with a single atomic store, so a batch of
+*             updates becomes visible all at once.
+*
+*             Readers announce the global epoch in a slot of their own and
+*             then load the current version with a single atomic load.
+*             Each replaced version is tagged with the epoch that follows
+*             its replacement, and it is only freed once every reader is
+*             either idle or has announced an epoch at least that new.
+*             Such a reader must have loaded the version pointer after the
+*             replacement, so it can't be using the old version.
+*
+*             Chunk reference counts are only touched by the writer, so
+*             they don't need to be atomic.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <stdexcept>
+#include "rcubits.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : rcu_bit_array_c - constructor
+*   Description: This is the rcu_bit_array_c constructor.  It rounds the
+*                chunk size up to a power of two, allocates reader slots
+*                and publishes an initial version with all bits cleared.
+*   Parameters : numBits - number of bits in the array
+*                chunkBits - requested number of bits per chunk
+*                maxReaders - maximum number of simultaneous readers
+*   Effects    : Allocates the initial version and reader slots
+*   Returned   : None
+***************************************************************************/
+rcu_bit_array_c::rcu_bit_array_c(const size_t numBits,
+    const size_t chunkBits, const size_t maxReaders):
+    m_NumBits(numBits),
+    m_ChunkShift(0),
+    m_NumChunks(0),
+    m_MaxReaders(maxReaders),
+    m_Current(NULL),
+    m_Epoch(1),
+    m_Readers(NULL),
+    m_Pending(NULL),
+    m_Copied(NULL),
+    m_Retired(NULL)
+{
+    rcu_version_t *version;
+    size_t total = 0;
+
+    if (numBits < 1)
+    {
+        throw invalid_argument("Error: Bit Array must have at least 1 bit.");
+    }
+
+    /* chunks are a power of two bits and start on a character boundary */
+    while ((((size_t)1 << m_ChunkShift) < chunkBits) ||
+        (((size_t)1 << m_ChunkShift) < CHAR_BIT))
+    {
+        m_ChunkShift++;
+    }
+
+    m_NumChunks = ((numBits - 1) >> m_ChunkShift) + 1;
+
+    m_Readers = new rcu_reader_slot_t[maxReaders];
+    for (size_t i = 0; i < maxReaders; i++)
+    {
+        m_Readers[i].epoch = 0;
+        m_Readers[i].inUse = false;
+    }
+
+    m_Copied = new bool[m_NumChunks];
+
+    version = new rcu_version_t;
+    version->chunks = new rcu_chunk_t*[m_NumChunks];
+    version->retiredEpoch = 0;
+    version->next = NULL;
+
+    for (size_t i = 0; i < m_NumChunks; i++)
+    {
+        version->chunks[i] = NewChunk(i);
+        total += version->chunks[i]->bits->Size();
+    }
+
+    /* the chunks must cover the array exactly, however large they are */
+    if (total != numBits)
+    {
+        FreeVersion(version);
+        delete[] m_Copied;
+        delete[] m_Readers;
+        throw logic_error("Error: RCU chunks don't cover the bit array.");
+    }
+
+    m_Current = version;
+}
+
+/***************************************************************************
+*   Method     : ~rcu_bit_array_c - destructor
+*   Description: This is the rcu_bit_array_c destructor.  It frees every
+*                version.  There must not be any readers left.
+*   Parameters : None
+*   Effects    : All versions and chunks are freed
+*   Returned   : None
+***************************************************************************/
+rcu_bit_array_c::~rcu_bit_array_c(void)
+{
+    rcu_version_t *version;
+
+    while (m_Retired != NULL)
+    {
+        version = m_Retired;
+        m_Retired = version->next;
+        FreeVersion(version);
+    }
+
+    if (m_Pending != NULL)
+    {
+        FreeVersion(m_Pending);
+    }
+
+    FreeVersion(m_Current.load());
+
+    delete[] m_Copied;
+    delete[] m_Readers;
+}
+
+/***************************************************************************
+*   Method     : NewChunk
+*   Description: This method allocates a cleared chunk with a single
+*                reference.  The last chunk only holds the remaining bits.
+*   Parameters : chunk - index of the chunk being allocated
+*   Effects    : Allocates a chunk
+*   Returned   : Pointer to the new chunk
+***************************************************************************/
+rcu_chunk_t *rcu_bit_array_c::NewChunk(const size_t chunk)
+{
+    rcu_chunk_t *result;
+    size_t bits;
+
+    if (chunk == m_NumChunks - 1)
+    {
+        bits = m_NumBits - (chunk << m_ChunkShift);
+    }
+    else
+    {
+        bits = (size_t)1 << m_ChunkShift;
+    }
+
+    result = new rcu_chunk_t;
+    result->bits = new bit_array_c(bits);
+    result->refs = 1;
+
+    return result;
+}
+
+/***************************************************************************
+*   Method     : ReleaseChunk
+*   Description: This method drops a reference to a chunk and frees it when
+*                no version uses it.
+*   Parameters : chunk - chunk being released
+*   Effects    : Chunk may be freed
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_array_c::ReleaseChunk(rcu_chunk_t *chunk)
+{
+    chunk->refs--;
+
+    if (chunk->refs == 0)
+    {
+        delete chunk->bits;
+        delete chunk;
+    }
+}
+
+/***************************************************************************
+*   Method     : FreeVersion
+*   Description: This method releases every chunk used by a version and
+*                frees the version.
+*   Parameters : version - version being freed
+*   Effects    : Version and unshared chunks are freed
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_array_c::FreeVersion(rcu_version_t *version)
+{
+    for (size_t i = 0; i < m_NumChunks; i++)
+    {
+        ReleaseChunk(version->chunks[i]);
+    }
+
+    delete[] version->chunks;
+    delete version;
+}
+
+/***************************************************************************
+*   Method     : WritableChunk
+*   Description: This method returns a chunk of the pending version that
+*                isn't shared with any other version.  The pending version
+*                is started if there isn't one, and a shared chunk is
+*                replaced by a private copy the first time it is written.
+*   Parameters : chunk - index of the chunk to be written
+*   Effects    : May create the pending version and copy a chunk
+*   Returned   : Pointer to bits of the private chunk
+***************************************************************************/
+bit_array_c *rcu_bit_array_c::WritableChunk(const size_t chunk)
+{
+    if (m_Pending == NULL)
+    {
+        rcu_version_t *current = m_Current.load();
+
+        /* start a version sharing every chunk with the current one */
+        m_Pending = new rcu_version_t;
+        m_Pending->chunks = new rcu_chunk_t*[m_NumChunks];
+        m_Pending->retiredEpoch = 0;
+        m_Pending->next = NULL;
+
+        for (size_t i = 0; i < m_NumChunks; i++)
+        {
+            m_Pending->chunks[i] = current->chunks[i];
+            m_Pending->chunks[i]->refs++;
+            m_Copied[i] = false;
+        }
+    }
+
+    if (!m_Copied[chunk])
+    {
+        rcu_chunk_t *shared = m_Pending->chunks[chunk];
+        rcu_chunk_t *copy = NewChunk(chunk);
+
+        *(copy->bits) = *(shared->bits);
+        ReleaseChunk(shared);
+
+        m_Pending->chunks[chunk] = copy;
+        m_Copied[chunk] = true;
+    }
+
+    return m_Pending->chunks[chunk]->bits;
+}
+
+/***************************************************************************
+*   Method     : SetAll
+*   Description: This method sets every bit of the pending version to 1.
+*   Parameters : None
+*   Effects    : Each of the bits in the pending version are set to 1.
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_array_c::SetAll(void)
+{
+    for (size_t i = 0; i < m_NumChunks; i++)
+    {
+        WritableChunk(i)->SetAll();
+    }
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method sets every bit of the pending version to 0.
+*   Parameters : None
+*   Effects    : Each of the bits in the pending version are set to 0.
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_array_c::ClearAll(void)
+{
+    for (size_t i = 0; i < m_NumChunks; i++)
+    {
+        WritableChunk(i)->ClearAll();
+    }
+}
+
+/***************************************************************************
+*   Method     : SetBit
+*   Description: This method sets a bit of the pending version to 1.  The
+*                change isn't seen by readers until Publish is called.
+*   Parameters : bit - the number of the bit to set
+*   Effects    : The specified bit will be set to 1.
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_array_c::SetBit(const size_t bit)
+{
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    WritableChunk(bit >> m_ChunkShift)->SetBit(
+        bit & (((size_t)1 << m_ChunkShift) - 1));
+}
+
+/***************************************************************************
+*   Method     : ClearBit
+*   Description: This method sets a bit of the pending version to 0.  The
+*                change isn't seen by readers until Publish is called.
+*   Parameters : bit - the number of the bit to clear
+*   Effects    : The specified bit will be set to 0.
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_array_c::ClearBit(const size_t bit)
+{
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    WritableChunk(bit >> m_ChunkShift)->ClearBit(
+        bit & (((size_t)1 << m_ChunkShift) - 1));
+}
+
+/***************************************************************************
+*   Method     : Publish
+*   Description: This method makes the pending version visible to readers
+*                and retires the version it replaces.  The retired version
+*                is tagged with the epoch that follows the publication and
+*                then any versions no longer in use are reclaimed.
+*   Parameters : None
+*   Effects    : Pending version becomes current
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_array_c::Publish(void)
+{
+    rcu_version_t *old;
+
+    if (m_Pending == NULL)
+    {
+        return;         /* nothing to publish */
+    }
+
+    old = m_Current.load();
+    m_Current.store(m_Pending);
+    m_Pending = NULL;
+
+    old->retiredEpoch = m_Epoch.fetch_add(1) + 1;
+    old->next = m_Retired;
+    m_Retired = old;
+
+    Reclaim();
+}
+
+/***************************************************************************
+*   Method     : Reclaim
+*   Description: This method frees retired versions that no reader can be
+*                using.  A version may be freed when every reader is idle
+*                or has announced an epoch at least as new as the version's
+*                retirement epoch.
+*   Parameters : None
+*   Effects    : Unused retired versions are freed
+*   Returned   : Number of retired versions still waiting for readers
+***************************************************************************/
+size_t rcu_bit_array_c::Reclaim(void)
+{
+    unsigned long oldest;
+    rcu_version_t **link;
+    size_t waiting;
+
+    /* find the oldest epoch announced by an active reader */
+    oldest = ULONG_MAX;
+    for (size_t i = 0; i < m_MaxReaders; i++)
+    {
+        unsigned long epoch = m_Readers[i].epoch.load();
+
+        if ((epoch != 0) && (epoch < oldest))
+        {
+            oldest = epoch;
+        }
+    }
+
+    waiting = 0;
+    link = &m_Retired;
+
+    while (*link != NULL)
+    {
+        rcu_version_t *version = *link;
+
+        if (version->retiredEpoch <= oldest)
+        {
+            *link = version->next;
+            FreeVersion(version);
+        }
+        else
+        {
+            link = &(version->next);
+            waiting++;
+        }
+    }
+
+    return waiting;
+}
+
+/***************************************************************************
+*   Method     : rcu_bit_reader_c - constructor
+*   Description: This is the rcu_bit_reader_c constructor.  It claims one
+*                of the array's reader slots.
+*   Parameters : array - array to be read
+*   Effects    : A reader slot is claimed
+*   Returned   : None
+***************************************************************************/
+rcu_bit_reader_c::rcu_bit_reader_c(rcu_bit_array_c &array):
+    m_Array(&array),
+    m_Slot(NULL),
+    m_Version(NULL)
+{
+    for (size_t i = 0; i < array.m_MaxReaders; i++)
+    {
+        bool expected = false;
+
+        if (array.m_Readers[i].inUse.compare_exchange_strong(expected, true))
+        {
+            m_Slot = &array.m_Readers[i];
+            return;
+        }
+    }
+
+    throw length_error("Error: Bit Array has no free reader slots.");
+}
+
+/***************************************************************************
+*   Method     : ~rcu_bit_reader_c - destructor
+*   Description: This is the rcu_bit_reader_c destructor.  It ends any
+*                snapshot in progress and gives up the reader slot.
+*   Parameters : None
+*   Effects    : Reader slot is released
+*   Returned   : None
+***************************************************************************/
+rcu_bit_reader_c::~rcu_bit_reader_c(void)
+{
+    Unlock();
+    m_Slot->inUse.store(false);
+}
+
+/***************************************************************************
+*   Method     : Lock
+*   Description: This method takes a snapshot of the current version.  It
+*                announces the global epoch and then loads the current
+*                version pointer.  Neither step ever waits on the writer.
+*   Parameters : None
+*   Effects    : Snapshot is held until Unlock
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_reader_c::Lock(void)
+{
+    m_Slot->epoch.store(m_Array->m_Epoch.load());
+    m_Version = m_Array->m_Current.load();
+}
+
+/***************************************************************************
+*   Method     : Unlock
+*   Description: This method ends a snapshot, allowing the writer to free
+*                the version it used.
+*   Parameters : None
+*   Effects    : Snapshot is released
+*   Returned   : None
+***************************************************************************/
+void rcu_bit_reader_c::Unlock(void)
+{
+    m_Version = NULL;
+    m_Slot->epoch.store(0);
+}
+
+/***************************************************************************
+*   Method     : Count
+*   Description: This method counts the set bits in the snapshot.
+*   Parameters : None
+*   Effects    : None
+*   Returned   : Number of set bits.  0 if there is no snapshot.
+***************************************************************************/
+size_t rcu_bit_reader_c::Count(void) const
+{
+    size_t count = 0;
+
+    if (m_Version == NULL)
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < m_Array->m_NumChunks; i++)
+    {
+        count += m_Version->chunks[i]->bits->Count();
+    }
+
+    return count;
+}
+
+/***************************************************************************
+*   Method     : operator[]
+*   Description: Overload of the [] operator.  This method returns the
+*                value of a bit in the snapshot.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : The value of the specified bit.  false if the bit is out
+*                of range or there is no snapshot.
+***************************************************************************/
+bool rcu_bit_reader_c::operator[](const size_t bit) const
+{
+    size_t shift;
+
+    if ((m_Version == NULL) || (m_Array->m_NumBits <= bit))
+    {
+        return false;
+    }
+
+    shift = m_Array->m_ChunkShift;
+    return (*m_Version->chunks[bit >> shift]->bits)[
+        bit & (((size_t)1 << shift) - 1)];
+}
@@ -0,0 +1,137 @@
+/***************************************************************************
+*              Read-Copy-Update Arrays of Arbitrary Bit Length
+*
+*   File    : rcubits.h
+*   Purpose : Header file for a class that lets readers take consistent,
+*             non-blocking snapshots of an arbitrary length array of bits
+*             while a writer publishes batches of updates.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef RCU_BITS_H
+#define RCU_BITS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <atomic>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* a chunk of bits that may be shared by several versions */
+struct rcu_chunk_t
+{
+    bit_array_c *bits;                  /* bits in this chunk */
+    size_t refs;                        /* versions using this chunk */
+};
+
+/* one published (or pending) version of the whole array */
+struct rcu_version_t
+{
+    rcu_chunk_t **chunks;               /* chunks making up this version */
+    unsigned long retiredEpoch;         /* epoch when replaced */
+    rcu_version_t *next;                /* next retired version */
+};
+
+/* epoch announced by a reader, 0 when not reading */
+struct alignas(64) rcu_reader_slot_t
+{
+    std::atomic<unsigned long> epoch;
+    std::atomic<bool> inUse;
+};
+
+class rcu_bit_array_c
+{
+    public:
+        rcu_bit_array_c(const size_t numBits,
+            const size_t chunkBits, const size_t maxReaders);
+
+        virtual ~rcu_bit_array_c(void);
+
+        size_t Size() const { return m_NumBits; };
+
+        /* writer functions; only one thread may write at a time */
+        void SetAll(void);
+        void ClearAll(void);
+        void SetBit(const size_t bit);
+        void ClearBit(const size_t bit);
+        void Publish(void);
+        size_t Reclaim(void);
+
+    private:
+        friend class rcu_bit_reader_c;
+
+        /* versions can't be copied */
+        rcu_bit_array_c(const rcu_bit_array_c &);
+        rcu_bit_array_c& operator=(const rcu_bit_array_c &);
+
+        rcu_chunk_t *NewChunk(const size_t chunk);
+        void ReleaseChunk(rcu_chunk_t *chunk);
+        void FreeVersion(rcu_version_t *version);
+        bit_array_c *WritableChunk(const size_t chunk);
+
+        size_t m_NumBits;               /* number of bits in the array */
+        size_t m_ChunkShift;            /* log2 of bits per chunk */
+        size_t m_NumChunks;             /* number of chunks */
+        size_t m_MaxReaders;            /* number of reader slots */
+
+        std::atomic<rcu_version_t *> m_Current;     /* published version */
+        std::atomic<unsigned long> m_Epoch;         /* global epoch */
+        rcu_reader_slot_t *m_Readers;               /* reader slots */
+
+        rcu_version_t *m_Pending;       /* version being written */
+        bool *m_Copied;                 /* chunks private to m_Pending */
+        rcu_version_t *m_Retired;       /* versions waiting for readers */
+};
+
+class rcu_bit_reader_c
+{
+    public:
+        rcu_bit_reader_c(rcu_bit_array_c &array);
+        virtual ~rcu_bit_reader_c(void);
+
+        /* snapshot section */
+        void Lock(void);
+        void Unlock(void);
+
+        /* queries on the snapshot taken by Lock */
+        size_t Size() const { return m_Array->m_NumBits; };
+        size_t Count(void) const;
+        bool operator[](const size_t bit) const;
+
+    private:
+        /* readers can't be copied */
+        rcu_bit_reader_c(const rcu_bit_reader_c &);
+        rcu_bit_reader_c& operator=(const rcu_bit_reader_c &);
+
+        rcu_bit_array_c *m_Array;       /* array being read */
+        rcu_reader_slot_t *m_Slot;      /* slot announcing our epoch */
+        rcu_version_t *m_Version;       /* snapshot, NULL if not locked */
+};
+
+#endif  /* ndef RCU_BITS_H */
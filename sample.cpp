@@ -51,9 +51,28 @@
 ***************************************************************************/
 
 #include <iostream>
+#include <sstream>
 #include <cstdlib>
 #include <climits>
 #include "bitarray.h"
+#include "bitrand.h"
+#include "shardbits.h"
+#include "rcubits.h"
+#include "adaptbits.h"
+#include "scratchbits.h"
+#include "epochbits.h"
+#include "countbloom.h"
+#include "fusefilter.h"
+#include "cardsketch.h"
+#include "minhash.h"
+#include "simhash.h"
+#include "binarizer.h"
+#include "bitmatrix.h"
+#include "kmajority.h"
+#include "rankbits.h"
+#include "wavelet.h"
+#include "fmindex.h"
+#include "treebits.h"
 
 using namespace std;
 
@@ -424,5 +443,528 @@ int main()
         ShowArray("ba3", &ba3);
     }
 
+    /* conversion to and from lists of bit indices */
+    size_t indices[NUM_BITS];
+    size_t count;
+
+    cout << endl << "ba3 has " << ba3.Count() << " bits set" << endl;
+
+    cout << endl << "clear ba1 and set bits 0, 3, 17, 64, 127 from a list"
+        << endl;
+    indices[0] = 0;
+    indices[1] = 3;
+    indices[2] = 17;
+    indices[3] = 64;
+    indices[4] = 127;
+    ba1.ClearAll();
+    ba1.FromIndices(indices, 5, true);
+    ShowArray("ba1", &ba1);
+
+    cout << endl << "test ba1 for set bits" << endl;
+    cout << "Any: " << ba1.Any() << ", None: " << ba1.None() << ", All: "
+        << ba1.All() << endl;
+
+    cout << endl << "compare ba1 and ba2 as sets" << endl;
+    cout << "ba1 " << (ba1.Intersects(ba2) ? "intersects" : "is disjoint from")
+        << " ba2" << endl;
+    cout << "ba1 " << (ba1.IsSubsetOf(ba2) ? "is" : "is not")
+        << " a subset of ba2" << endl;
+    cout << "ba2 " << (ba2.IsSupersetOf(ba1) ? "is" : "is not")
+        << " a superset of ba1" << endl;
+    cout << "ba1 " << (ba1.ContainsAll(indices, 5) ? "contains" :
+        "doesn't contain") << " all of the listed bits" << endl;
+
+    cout << endl << "list the bits set in ba2" << endl;
+    count = ba2.ToIndices(indices, NUM_BITS);
+    cout << "ba2 has " << count << " bits set:";
+    for (i = 0; i < (int)count; i++)
+    {
+        cout << " " << indices[i];
+    }
+    cout << endl;
+
+    /* slices, concatenation and splitting */
+    cout << endl << "view bits 10 through 49 of ba2" << endl;
+    bit_array_slice_c slice = ba2.Slice(10, 40);
+    cout << "the view has " << slice.Count() << " of " << slice.Size()
+        << " bits set" << endl;
+
+    cout << endl << "copy the view into ba1 starting at bit 3" << endl;
+    ba1.ClearAll();
+    slice.CopyTo(ba1, 3);
+    ShowArray("ba1", &ba1);
+
+    cout << endl << "split ba2 at bit 33 and join the pieces in reverse"
+        << endl;
+    {
+        bit_array_c head(33), tail(NUM_BITS - 33);
+        bit_array_c *pieces[] = {&head, &tail};
+        const bit_array_c *parts[] = {&tail, &head};
+        size_t splitAt = 33;
+
+        ba2.Split(&splitAt, 1, pieces);
+        ba1.Concat(parts, 2);
+        ShowArray("ba2", &ba2);
+        ShowArray("ba1", &ba1);
+    }
+
+    /* operations on arrays of different sizes */
+    cout << endl << "or a 20 bit array of 1s into ba1 two ways" << endl;
+    {
+        bit_array_c ones(20);
+
+        ones.SetAll();
+
+        ba1.ClearAll();
+        ba1.Or(ones, BIT_SIZE_ZERO_EXTEND);
+        ShowArray("zero extend", &ba1);
+
+        ba1.ClearAll();
+        ba1.Or(ones, BIT_SIZE_ALIGN_RIGHT);
+        ShowArray("align right", &ba1);
+
+        cout << endl << "and ba2 with the 20 bit array, zero extended"
+            << endl;
+        ba1 = ba2;
+        ba1.And(ones, BIT_SIZE_ZERO_EXTEND);
+        ShowArray("ba1", &ba1);
+
+        cout << endl << "and ba2 with a 20 bit array of 0s, truncated" << endl;
+        ba1 = ba2;
+        ones.ClearAll();
+        ba1.And(ones, BIT_SIZE_TRUNCATE);
+        ShowArray("ba1", &ba1);
+    }
+
+    /* division and decimal conversion */
+    cout << endl << "set ba1 to 2^128 - 1 and print it in decimal" << endl;
+    ba1.SetAll();
+    cout << "ba1 = " << ba1.ToDecimalString() << endl;
+
+    cout << "ba1 % 1000 = " << ba1.ModSmall(1000) << endl;
+    cout << "ba1 / 1000 leaves remainder " << ba1.DivideSmall(1000) << endl;
+    cout << "ba1 = " << ba1.ToDecimalString() << endl;
+
+    cout << endl << "divide ba1 by ba2 = 12345678901234567890" << endl;
+    ba2.FromDecimalString("12345678901234567890");
+    ba1.SetAll();
+    ba1 /= ba2;
+    cout << "quotient = " << ba1.ToDecimalString() << endl;
+    ba1.SetAll();
+    ba1 %= ba2;
+    cout << "remainder = " << ba1.ToDecimalString() << endl;
+
+    cout << endl << "reduce ba1 = 2^128 - 1 with a Barrett reducer for ba2"
+        << endl;
+    {
+        bit_barrett_c reducer(ba2);
+
+        ba1.SetAll();
+        reducer.Reduce(ba1);
+        cout << "remainder = " << ba1.ToDecimalString() << endl;
+    }
+
+    /* random fill and sampling */
+    bit_random_c rng(2004);
+
+    cout << endl << "fill ba1 with random bits at a density of 0.25" << endl;
+    ba1.FillRandom(0.25, rng);
+    ShowArray("ba1", &ba1);
+    cout << "ba1 has " << ba1.Count() << " bits set" << endl;
+
+    if (ba1.SampleSetBit(rng, indices[0]))
+    {
+        cout << endl << "randomly chosen set bit in ba1: " << indices[0]
+            << endl;
+    }
+
+    cout << endl << "randomly choose 5 set bits in ba1:";
+    count = ba1.SampleK(5, indices, rng);
+    for (i = 0; i < (int)count; i++)
+    {
+        cout << " " << indices[i];
+    }
+    cout << endl;
+
+    /* sharded arrays may be shared between threads */
+    sharded_bit_array_c sba1(NUM_BITS, 32), sba2(NUM_BITS, 32);
+
+    cout << endl << "sba1 has " << sba1.Size() << " bits in "
+        << sba1.ShardCount() << " shards of " << sba1.ShardBits() << " bits"
+        << endl;
+
+    cout << endl << "set every 3rd bit of sba1 and every 2nd bit of sba2"
+        << endl;
+    for (i = 0; i < NUM_BITS; i++)
+    {
+        if ((i % 3) == 0)
+        {
+            sba1.SetBit(i);
+        }
+
+        if ((i % 2) == 0)
+        {
+            sba2.SetBit(i);
+        }
+    }
+
+    cout << "sba1 has " << sba1.Count() << " bits set" << endl;
+    cout << "sba2 has " << sba2.Count() << " bits set" << endl;
+
+    cout << endl << "sba1 &= sba2" << endl;
+    sba1 &= sba2;
+    cout << "sba1 has " << sba1.Count() << " bits set" << endl;
+
+    /* read-copy-update arrays let readers take non-blocking snapshots */
+    rcu_bit_array_c rba(NUM_BITS, 32, 4);
+    rcu_bit_reader_c reader(rba);
+
+    cout << endl << "take a snapshot of rba, then set bits 0 - 9 in rba"
+        << endl;
+    reader.Lock();
+    for (i = 0; i < 10; i++)
+    {
+        rba.SetBit(i);
+    }
+    cout << "snapshot has " << reader.Count() << " bits set" << endl;
+
+    cout << endl << "publish the changes and take a new snapshot" << endl;
+    rba.Publish();
+    cout << "old snapshot has " << reader.Count() << " bits set" << endl;
+    reader.Unlock();
+    reader.Lock();
+    cout << "new snapshot has " << reader.Count() << " bits set" << endl;
+    reader.Unlock();
+    cout << rba.Reclaim() << " old versions waiting to be freed" << endl;
+
+    if (sizeof(size_t) > 4)
+    {
+        /* chunks of 2^32 bits or more; untouched pages are never mapped */
+        const size_t bigChunk = (size_t)1 << 32;
+        rcu_bit_array_c bigRba(bigChunk + 64, bigChunk, 1);
+        rcu_bit_reader_c bigReader(bigRba);
+
+        cout << endl << "set bit 2^32 + 5 of a " << bigRba.Size() <<
+            " bit array with 2^32 bit chunks" << endl;
+        bigRba.SetBit(bigChunk + 5);
+        bigRba.Publish();
+        bigReader.Lock();
+        cout << "bit 2^32 + 5 is " << bigReader[bigChunk + 5] << endl;
+        bigReader.Unlock();
+    }
+
+    /* adaptive arrays pick their own representation */
+    adaptive_bit_array_c aba(NUM_BITS);
+    const char *repNames[] = {"dense", "sorted list", "runs"};
+
+    cout << endl << "set bits 3 and 90 of aba" << endl;
+    aba.SetBit(3);
+    aba.SetBit(90);
+    cout << "aba is stored as " << repNames[aba.Representation()] << " in "
+        << aba.StorageSize() << " bytes" << endl;
+
+    cout << endl << "set all bits of aba, then clear bit 64" << endl;
+    aba.SetAll();
+    aba.ClearBit(64);
+    cout << "aba is stored as " << repNames[aba.Representation()] << " in "
+        << aba.StorageSize() << " bytes" << endl;
+
+    cout << endl << "clear every 3rd bit of aba" << endl;
+    for (i = 0; i < NUM_BITS; i += 3)
+    {
+        aba.ClearBit(i);
+    }
+    cout << "aba is stored as " << repNames[aba.Representation()] << " in "
+        << aba.StorageSize() << " bytes" << endl;
+    aba.ToBitArray(ba1);
+    ShowArray("ba1", &ba1);
+
+    adaptive_bit_array_c abb(NUM_BITS);
+
+    cout << endl << "abb = bits 60 through 69, then aba &= abb" << endl;
+    for (i = 60; i < 70; i++)
+    {
+        abb(i) = true;
+    }
+    aba &= abb;
+    cout << "aba is stored as " << repNames[aba.Representation()] << " in "
+        << aba.StorageSize() << " bytes" << endl;
+    aba.ToBitArray(ba1);
+    ShowArray("ba1", &ba1);
+    cout << "aba is a subset of abb: " << aba.IsSubsetOf(abb) << endl;
+
+    /* scratch array reset by clearing only the words written */
+    scratch_bit_array_c scratch(NUM_BITS, 4);
+
+    cout << endl << "set bits 5, 6 and 100 of scratch" << endl;
+    scratch.SetBit(5);
+    scratch(6) = true;
+    scratch.SetBit(100);
+    ba1 = scratch.Bits();
+    ShowArray("scratch", &ba1);
+    cout << "scratch has " << scratch.DirtyWords() << " dirty words" << endl;
+
+    cout << endl << "reset scratch" << endl;
+    scratch.Reset();
+    ba1 = scratch.Bits();
+    ShowArray("scratch", &ba1);
+    cout << "scratch has " << scratch.DirtyWords() << " dirty words" << endl;
+
+    /* epoch stamped array cleared in constant time */
+    epoch_bit_array_c eba(NUM_BITS);
+
+    cout << endl << "set bits 0 through 9 of eba" << endl;
+    for (i = 0; i < 10; i++)
+    {
+        eba.SetBit(i);
+    }
+    eba.ToBitArray(ba1);
+    ShowArray("eba", &ba1);
+
+    cout << endl << "clear eba, then set bit 127" << endl;
+    eba.ClearAll();
+    eba.SetBit(127);
+    eba.ToBitArray(ba1);
+    ShowArray("eba", &ba1);
+    cout << "eba has " << eba.Count() << " bits set" << endl;
+
+    /* counting Bloom filter */
+    counting_bloom_c bloom(NUM_BITS, 3);
+    const uint64_t keys[] = {7, 42, 1000, 123456789};
+
+    cout << endl << "insert 7, 42, 1000 and 123456789 in bloom" << endl;
+    bloom.InsertBatch(keys, 4);
+    cout << "bloom " << (bloom.Contains(42) ? "contains" : "doesn't contain")
+        << " 42" << endl;
+
+    cout << endl << "remove 42 from bloom" << endl;
+    bloom.Remove(42);
+    cout << "bloom " << (bloom.Contains(42) ? "contains" : "doesn't contain")
+        << " 42" << endl;
+
+    cout << endl << "convert bloom to a plain Bloom filter in ba1" << endl;
+    bloom.ToBloom(ba1);
+    ShowArray("ba1", &ba1);
+    cout << "ba1 " << (bloom.Contains(ba1, 1000) ? "contains" :
+        "doesn't contain") << " 1000" << endl;
+
+    /* binary fuse filter */
+    fuse_filter_c fuse(keys, 4, 8, 1);
+
+    cout << endl << "build fuse from 7, 42, 1000 and 123456789" << endl;
+    cout << "fuse " << (fuse.Contains(1000) ? "contains" : "doesn't contain")
+        << " 1000" << endl;
+
+    cout << endl << "serialize fuse and read it back into fuse2" << endl;
+    stringstream fuseStream;
+    fuse.Serialize(fuseStream);
+    fuse_filter_c fuse2(fuseStream);
+    cout << "fuse2 has " << fuse2.Size() << " fingerprints of " <<
+        fuse2.FingerprintBits() << " bits and " <<
+        (fuse2.Contains(7) ? "contains" : "doesn't contain") << " 7" << endl;
+
+    /* distinct count sketches */
+    linear_counter_c lc1(NUM_BITS), lc2(NUM_BITS);
+    mr_bitmap_c mrb(NUM_BITS, 8);
+    uint64_t hashes[100];
+
+    for (i = 0; i < 100; i++)
+    {
+        hashes[i] = bit_random_c::Hash(i);
+    }
+
+    cout << endl << "insert hashes of 0 .. 59 in lc1 and 40 .. 99 in lc2";
+    cout << endl;
+    lc1.InsertBatch(hashes, 60);
+    lc2.InsertBatch(&hashes[40], 60);
+    cout << "lc1 estimates " << lc1.Estimate() << " distinct keys" << endl;
+
+    cout << endl << "merge lc2 into lc1" << endl;
+    lc1 |= lc2;
+    cout << "lc1 estimates " << lc1.Estimate() << " distinct keys" << endl;
+
+    for (i = 0; i < 10000; i++)
+    {
+        mrb.Insert(bit_random_c::Hash(i));
+    }
+
+    cout << endl << "insert hashes of 0 .. 9999 in mrb" << endl;
+    cout << "mrb estimates " << mrb.Estimate() << " distinct keys" << endl;
+
+    /* b-bit MinHash signatures */
+    minhash_c minhash(256, 2, 1);
+    bit_array_c signatures(2 * minhash.SignatureBits());
+    const uint64_t *docs[2] = {hashes, &hashes[40]};
+    const size_t docLengths[2] = {60, 60};
+
+    cout << endl << "sign hashes of 0 .. 59 and 40 .. 99" << endl;
+    minhash.SignatureBatch(docs, docLengths, 2, signatures, 2);
+    signatures.Slice(0, NUM_BITS).CopyTo(ba1, 0);
+    ShowArray("first bits of signature 0", &ba1);
+    cout << "estimated similarity is " <<
+        minhash.Similarity(signatures, 0, signatures, 1) << " (exact 0.2)" <<
+        endl;
+
+    /* SimHash fingerprints */
+    simhash_c simhash(NUM_BITS / 2, 1);
+
+    cout << endl << "fingerprint hashes of 0 .. 59 and 40 .. 99 into ba1";
+    cout << endl;
+    simhash.FingerprintBatch(docs, NULL, docLengths, 2, ba1, 2);
+    ShowArray("ba1", &ba1);
+    cout << "fingerprints differ in " << simhash.Distance(ba1, 0, ba1, 1) <<
+        " of " << simhash.FingerprintBits() << " bits" << endl;
+
+    /* random projection codes */
+    binarizer_c binarizer(3, NUM_BITS / 2, 1);
+    const float embeddings[2][3] = {{1.0f, 2.0f, 3.0f}, {1.0f, 2.0f, 2.5f}};
+
+    cout << endl << "encode (1, 2, 3) and (1, 2, 2.5) into ba1" << endl;
+    binarizer.EncodeBatch(&embeddings[0][0], 2, ba1, 1);
+    ShowArray("ba1", &ba1);
+
+    /* binary matrix multiply */
+    bit_matrix_c activations(2, NUM_BITS), weights(3, NUM_BITS);
+    int32_t products[2 * 3];
+
+    cout << endl << "multiply activations ba1 and ba1 << 64 by weights 0, ~0";
+    cout << " and ba1" << endl;
+    activations.SetRow(0, ba1);
+    activations.SetRow(1, ba1 << (NUM_BITS / 2));
+    ba2.SetAll();
+    weights.SetRow(1, ba2);
+    weights.SetRow(2, ba1);
+    activations.XnorMultiply(weights, products, 1);
+
+    for (i = 0; i < 2; i++)
+    {
+        cout << "activation row " << i << " products: " << products[3 * i] <<
+            " " << products[(3 * i) + 1] << " " << products[(3 * i) + 2] <<
+            endl;
+    }
+
+    /* k-majority clustering */
+    bit_matrix_c points(8, 16);
+
+    for (i = 0; i < 8; i++)
+    {
+        /* points near 0xFF00 and near 0x00FF, one bit flipped in each */
+        for (int col = 0; col < 8; col++)
+        {
+            points.SetBit(i, (i < 4) ? col : (col + 8));
+        }
+
+        points.SetBit(i, (i < 4) ? (8 + (2 * i)) : (2 * (i - 4)));
+    }
+
+    kmajority_c clusters(points, 2, 1);
+
+    cout << endl << "cluster 8 points around 0xFF00 and 0x00FF" << endl;
+    cout << "converged after " << clusters.Run(10, 2) << " iterations";
+    cout << endl << "clusters:";
+
+    for (i = 0; i < 8; i++)
+    {
+        cout << " " << clusters.Cluster(i);
+    }
+
+    cout << endl;
+
+    /* rank and select */
+    ba1.ClearAll();
+
+    for (i = 0; i < (int)ba1.Size(); i += 3)
+    {
+        ba1.SetBit(i);
+    }
+
+    rank_select_c directory(ba1);
+
+    cout << endl << "every 3rd bit of " << ba1.Size() << " set" << endl;
+    cout << "1s before bit 50: " << directory.Rank1(50) << endl;
+    cout << "1 number 10 is bit " << directory.Select1(10) << endl;
+    cout << "0 number 10 is bit " << directory.Select0(10) << endl;
+
+    /* wavelet matrix */
+    uint32_t sequence[] = {5, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8};
+    uint32_t frequent[2];
+    size_t frequency[2];
+
+    wavelet_matrix_c wavelet(sequence, 12, 2);
+
+    cout << endl << "wavelet matrix of 5 1 4 1 5 9 2 6 5 3 5 8" << endl;
+    cout << "value 6: " << wavelet[6] << endl;
+    cout << "5s before value 8: " << wavelet.Rank(5, 8) << endl;
+    cout << "third 5 is value " << wavelet.Select(5, 2) << endl;
+    cout << "median of values 2 through 9: " << wavelet.Quantile(2, 10, 4)
+        << endl;
+
+    wavelet.TopK(0, 12, 2, frequent, frequency);
+    cout << "most frequent: " << frequent[0] << " (" << frequency[0] <<
+        " times), " << frequent[1] << " (" << frequency[1] << " times)" <<
+        endl;
+
+    stringstream waveletStream;
+    wavelet.Serialize(waveletStream);
+    wavelet_matrix_c waveletCopy(waveletStream);
+    cout << "value 6 of copy read back: " << waveletCopy[6] << endl;
+
+    /* Huffman shaped wavelet tree */
+    huffman_wavelet_c tree((const unsigned char *)"mississippi", 11, 1);
+
+    cout << endl << "Huffman wavelet tree of mississippi" << endl;
+    cout << "symbol 4: " << tree[4] << endl;
+    cout << "s's before symbol 6: " << tree.Rank('s', 6) << endl;
+    cout << "stored in " << tree.Bits() << " bits" << endl;
+
+    /* FM-index */
+    const char *text = "abracadabra";
+    size_t found[4], numFound;
+
+    fm_index_c index((const unsigned char *)text, 11, 4, 1);
+
+    cout << endl << "FM-index of " << text << endl;
+    cout << "\"abra\" occurs " <<
+        index.Count((const unsigned char *)"abra", 4) << " times at";
+
+    numFound = index.Locate((const unsigned char *)"abra", 4, found, 4);
+
+    for (i = 0; i < (int)numFound; i++)
+    {
+        cout << " " << found[i];
+    }
+
+    cout << endl;
+    cout << "\"cad\" occurs " <<
+        index.Count((const unsigned char *)"cad", 3) << " times" << endl;
+
+    /* succinct trees: root 0 with children 1 and 2, node 1 with child 3 */
+    louds_tree_c louds(4);
+    bp_tree_c parens(4);
+
+    louds.AddNode(2);       /* level order: 0, 1, 2, 3 */
+    louds.AddNode(1);
+    louds.AddNode(0);
+    louds.AddNode(0);
+    louds.Finish();
+
+    parens.Open();          /* depth first: 0, 1, 3, 2 */
+    parens.Open();
+    parens.Open();
+    parens.Close();
+    parens.Close();
+    parens.Open();
+    parens.Close();
+    parens.Close();
+    parens.Finish();
+
+    cout << endl << "LOUDS tree: root has " << louds.Degree(0) <<
+        " children, node 3's parent is " << louds.Parent(3) <<
+        ", node 1's subtree has " << louds.SubtreeSize(1) << " nodes" <<
+        endl;
+    cout << "parentheses tree (depth first numbers): node 1's next " <<
+        "sibling is " << parens.NextSibling(1) << ", node 2 is at depth " <<
+        parens.Depth(2) << endl;
+
     return(EXIT_SUCCESS);
 }
@@ -0,0 +1,269 @@
+/***************************************************************************
+*                 Scratch Arrays of Arbitrary Bit Length
+*
+*   File    : scratchbits.cpp
+*   Purpose : Provides a bit array for scratch use, such as the visited set
+*             of a graph search, that is cleared between uses.
+*
+*             The first time SetBit sets a bit in a 64 bit word, the index
+*             of the word is added to a dirty list.  Reset then clears
+*             just the listed words, which costs time proportional to the
+*             number of words written rather than the size of the array.
+*             A bitmap with one bit per word marks the listed words, so a
+*             word that is cleared and set again isn't listed twice.
+*
+*             When the dirty list fills up, tracking stops and the next
+*             Reset clears the whole array with ClearAll.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2004, 2006-2007, 2010 by
+*       Michael Dipperstein (mdipperstein@gmail.com)
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+#include "scratchbits.h"
+#include "bitwords.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* index of the word containing bit */
+#define BIT_WORD(bit)         ((bit) / (WORD_CHARS * CHAR_BIT))
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : scratch_bit_array_c - constructor
+*   Description: This is the scratch_bit_array_c constructor.  It
+*                allocates the bits, the dirty word list and a bitmap
+*                with one bit per word marking the words on the list.
+*   Parameters : numBits - number of bits in the array
+*                maxDirty - number of words that may be written before a
+*                    Reset falls back to clearing the whole array
+*   Effects    : Allocates the array with all bits cleared
+*   Returned   : None
+***************************************************************************/
+scratch_bit_array_c::scratch_bit_array_c(const size_t numBits,
+    const size_t maxDirty):
+    bit_array_c(numBits),
+    m_Listed(BIT_WORD(numBits - 1) + 1),
+    m_Dirty(NULL),
+    m_MaxDirty(maxDirty),
+    m_DirtyCount(0),
+    m_Overflow(false)
+{
+    if (maxDirty > 0)
+    {
+        m_Dirty = new size_t[maxDirty];
+    }
+}
+
+/***************************************************************************
+*   Method     : ~scratch_bit_array_c - destructor
+*   Description: This is the scratch_bit_array_c destructor.  It frees the
+*                dirty word list; the bits are freed by bit_array_c.
+*   Parameters : None
+*   Effects    : Dirty word list is freed
+*   Returned   : None
+***************************************************************************/
+scratch_bit_array_c::~scratch_bit_array_c(void)
+{
+    delete[] m_Dirty;
+}
+
+/***************************************************************************
+*   Method     : SetAll
+*   Description: This method sets every bit in the array.  Every word is
+*                now dirty, so the next Reset clears the whole array.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 1.
+*   Returned   : None
+***************************************************************************/
+void scratch_bit_array_c::SetAll(void)
+{
+    bit_array_c::SetAll();
+    m_Overflow = true;
+}
+
+/***************************************************************************
+*   Method     : SetBit
+*   Description: This method sets a bit in the array, recording the word
+*                containing it if the word isn't on the dirty list yet.
+*   Parameters : bit - the bit to set
+*   Effects    : The specified bit will be set to 1.
+*   Returned   : None
+***************************************************************************/
+void scratch_bit_array_c::SetBit(const size_t bit)
+{
+    size_t word;
+
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    word = BIT_WORD(bit);
+
+    if (!m_Overflow && !m_Listed[word])
+    {
+        if (m_DirtyCount < m_MaxDirty)
+        {
+            m_Dirty[m_DirtyCount] = word;
+            m_DirtyCount++;
+            m_Listed.SetBit(word);
+        }
+        else
+        {
+            m_Overflow = true;
+        }
+    }
+
+    bit_array_c::SetBit(bit);
+}
+
+/***************************************************************************
+*   Method     : ClearBit
+*   Description: This method clears a bit in the array.  Clearing never
+*                makes a word dirty, so nothing is recorded.
+*   Parameters : bit - the bit to clear
+*   Effects    : The specified bit will be set to 0.
+*   Returned   : None
+***************************************************************************/
+void scratch_bit_array_c::ClearBit(const size_t bit)
+{
+    bit_array_c::ClearBit(bit);
+}
+
+/***************************************************************************
+*   Method     : Reset
+*   Description: This method clears every bit in the array.  Only the
+*                words on the dirty list are cleared, unless the list
+*                overflowed, in which case the whole array is cleared.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 0, and the dirty
+*                list and its bitmap are emptied.
+*   Returned   : None
+***************************************************************************/
+void scratch_bit_array_c::Reset(void)
+{
+    size_t size, first;
+
+    if (m_Overflow)
+    {
+        ClearAll();
+        m_Listed.ClearAll();
+    }
+    else
+    {
+        size = BITS_TO_CHARS(m_NumBits);
+
+        for (size_t i = 0; i < m_DirtyCount; i++)
+        {
+            first = m_Dirty[i] * WORD_CHARS;
+            memset(&m_Array[first], 0, ((size - first) < WORD_CHARS) ?
+                (size - first) : WORD_CHARS);
+            m_Listed.ClearBit(m_Dirty[i]);
+        }
+    }
+
+    m_DirtyCount = 0;
+    m_Overflow = false;
+}
+
+/***************************************************************************
+*   Method     : operator()
+*   Description: Overload of the () operator.  This method approximates
+*                array indices used for assignment.  It returns a
+*                scratch_bit_index_c which includes an = method used to
+*                set bit values, so that the assignment is recorded.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : scratch_bit_index_c (pointer to bit)
+***************************************************************************/
+scratch_bit_index_c scratch_bit_array_c::operator()(const size_t bit)
+{
+    return scratch_bit_index_c(this, bit);
+}
+
+/***************************************************************************
+*   Method     : operator[]
+*   Description: Overload of the [] operator.  This method returns the
+*                value of a bit in the array.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : The value of the specified bit.
+***************************************************************************/
+bool scratch_bit_array_c::operator[](const size_t bit) const
+{
+    return bit_array_c::operator[](bit);
+}
+
+/***************************************************************************
+*   Method     : scratch_bit_index_c - constructor
+*   Description: This is the scratch_bit_index_c constructor.  It stores a
+*                pointer to the scratch array and the bit index.
+*   Parameters : array - pointer to scratch array
+*                index - index of bit in array
+*   Effects    : Pointer to scratch array and bit index are stored.
+*   Returned   : None
+***************************************************************************/
+scratch_bit_index_c::scratch_bit_index_c(scratch_bit_array_c *array,
+    const size_t index):
+    m_BitArray(array),
+    m_Index(index)
+{
+}
+
+/***************************************************************************
+*   Method     : operator=
+*   Description: overload of the = operator.  Sets the bit array bit to
+*                the value of src.
+*   Parameters : src - bit value
+*   Effects    : Bit pointed to by this object is set to the value of
+*                source.
+*   Returned   : None
+***************************************************************************/
+void scratch_bit_index_c::operator=(const bool src)
+{
+    if (src)
+    {
+        m_BitArray->SetBit(m_Index);
+    }
+    else
+    {
+        m_BitArray->ClearBit(m_Index);
+    }
+}
@@ -0,0 +1,102 @@
+/***************************************************************************
+*                 Scratch Arrays of Arbitrary Bit Length
+*
+*   File    : scratchbits.h
+*   Purpose : Header file for a bit array that remembers which words have
+*             been written, so that it can be reset by clearing only
+*             those words.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2004, 2006-2007, 2010 by
+*       Michael Dipperstein (mdipperstein@gmail.com)
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef SCRATCH_BITS_H
+#define SCRATCH_BITS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class scratch_bit_array_c;
+
+class scratch_bit_index_c
+{
+    public:
+        scratch_bit_index_c(scratch_bit_array_c *array, const size_t index);
+
+        /* assignment */
+        void operator=(const bool src);
+
+    private:
+        scratch_bit_array_c *m_BitArray;        /* array index applies to */
+        size_t m_Index;                         /* index of bit in array */
+};
+
+/***************************************************************************
+* Bits may only be set through this class, so every word that is written
+* gets recorded.  Use Bits() for read only access to the bit_array_c
+* methods.
+***************************************************************************/
+class scratch_bit_array_c : protected bit_array_c
+{
+    public:
+        scratch_bit_array_c(const size_t numBits, const size_t maxDirty);
+        virtual ~scratch_bit_array_c(void);
+
+        using bit_array_c::Size;
+        using bit_array_c::Count;
+
+        const bit_array_c &Bits(void) const { return *this; };
+        size_t DirtyWords(void) const { return m_DirtyCount; };
+        bool Overflowed(void) const { return m_Overflow; };
+
+        /* set/clear functions */
+        void SetAll(void);
+        void SetBit(const size_t bit);
+        void ClearBit(const size_t bit);
+        void Reset(void);                       /* clear all bits */
+
+        scratch_bit_index_c operator()(const size_t bit);
+
+        /* boolean operator */
+        bool operator[](const size_t bit) const;
+
+    private:
+        /* scratch arrays can't be copied */
+        scratch_bit_array_c(const scratch_bit_array_c &);
+        scratch_bit_array_c& operator=(const scratch_bit_array_c &);
+
+        bit_array_c m_Listed;           /* words already in m_Dirty */
+        size_t *m_Dirty;                /* indices of words written */
+        size_t m_MaxDirty;              /* capacity of m_Dirty */
+        size_t m_DirtyCount;            /* entries used in m_Dirty */
+        bool m_Overflow;                /* too many words to track */
+};
+
+#endif  /* ndef SCRATCH_BITS_H */
@@ -0,0 +1,368 @@
+/***************************************************************************
+*                    Sharded Arrays of Arbitrary Bit Length
+*
+*   File    : shardbits.cpp
+*   Purpose : Provides a thread safe array of bits that is split into
+*             shards, each with its own lock.
+*
+*             Point operations (SetBit, ClearBit, [] ...) lock only the
+*             shard containing the bit, so threads working on different
+*             shards never wait on each other.  Bulk operations visit the
+*             shards in ascending order, locking one shard at a time, so a
+*             whole array operation only delays point operations on the
+*             shard it is currently working on.  Because the shards are
+*             always locked in the same order no deadlock is possible.
+*
+*             A bulk operation is atomic per shard, not for the array as a
+*             whole; a reader may see an operation applied to some shards
+*             and not yet to others.
+*
+*             Shards hold a power of two number of bits (at least
+*             CHAR_BIT), so locating a shard is a shift and each shard is
+*             a bit_array_c of its own.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <stdexcept>
+#include "shardbits.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : sharded_bit_array_c - constructor
+*   Description: This is the sharded_bit_array_c constructor.  It rounds
+*                the shard size up to a power of two and allocates the
+*                shards.  The last shard only holds the bits that remain.
+*   Parameters : numBits - number of bits in the array
+*                shardBits - requested number of bits per shard
+*   Effects    : Allocates shards with all bits cleared
+*   Returned   : None
+***************************************************************************/
+sharded_bit_array_c::sharded_bit_array_c(const size_t numBits,
+    const size_t shardBits):
+    m_NumBits(numBits),
+    m_ShardShift(0),
+    m_NumShards(0),
+    m_Shards(NULL)
+{
+    if (numBits < 1)
+    {
+        throw invalid_argument("Error: Bit Array must have at least 1 bit.");
+    }
+
+    /* shards are a power of two bits and start on a character boundary */
+    while ((((size_t)1 << m_ShardShift) < shardBits) ||
+        (((size_t)1 << m_ShardShift) < CHAR_BIT))
+    {
+        m_ShardShift++;
+    }
+
+    m_NumShards = ((numBits - 1) >> m_ShardShift) + 1;
+    m_Shards = new bit_shard_t[m_NumShards];
+
+    for (size_t i = 0; i < m_NumShards; i++)
+    {
+        m_Shards[i].bits = NULL;
+    }
+
+    try
+    {
+        for (size_t i = 0; i < m_NumShards - 1; i++)
+        {
+            m_Shards[i].bits = new bit_array_c((size_t)1 << m_ShardShift);
+        }
+
+        m_Shards[m_NumShards - 1].bits =
+            new bit_array_c(numBits - ((m_NumShards - 1) << m_ShardShift));
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < m_NumShards; i++)
+        {
+            delete m_Shards[i].bits;
+        }
+
+        delete[] m_Shards;
+        throw;
+    }
+}
+
+/***************************************************************************
+*   Method     : ~sharded_bit_array_c - destructor
+*   Description: This is the sharded_bit_array_c destructor.  It frees the
+*                shards.  No other thread may be using the array.
+*   Parameters : None
+*   Effects    : Shards are freed
+*   Returned   : None
+***************************************************************************/
+sharded_bit_array_c::~sharded_bit_array_c(void)
+{
+    for (size_t i = 0; i < m_NumShards; i++)
+    {
+        delete m_Shards[i].bits;
+    }
+
+    delete[] m_Shards;
+}
+
+/***************************************************************************
+*   Method     : Count
+*   Description: This method counts the set bits one shard at a time.
+*   Parameters : None
+*   Effects    : Each shard is locked while it is counted
+*   Returned   : Number of set bits
+***************************************************************************/
+size_t sharded_bit_array_c::Count(void) const
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < m_NumShards; i++)
+    {
+        lock_guard<mutex> guard(m_Shards[i].lock);
+        count += m_Shards[i].bits->Count();
+    }
+
+    return count;
+}
+
+/***************************************************************************
+*   Method     : SetAll
+*   Description: This method sets every bit in the array to 1, one shard at
+*                a time.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 1.
+*   Returned   : None
+***************************************************************************/
+void sharded_bit_array_c::SetAll(void)
+{
+    for (size_t i = 0; i < m_NumShards; i++)
+    {
+        lock_guard<mutex> guard(m_Shards[i].lock);
+        m_Shards[i].bits->SetAll();
+    }
+}
+
+/***************************************************************************
+*   Method     : ClearAll
+*   Description: This method sets every bit in the array to 0, one shard at
+*                a time.
+*   Parameters : None
+*   Effects    : Each of the bits in the array are set to 0.
+*   Returned   : None
+***************************************************************************/
+void sharded_bit_array_c::ClearAll(void)
+{
+    for (size_t i = 0; i < m_NumShards; i++)
+    {
+        lock_guard<mutex> guard(m_Shards[i].lock);
+        m_Shards[i].bits->ClearAll();
+    }
+}
+
+/***************************************************************************
+*   Method     : SetBit
+*   Description: This method sets a bit in the array to 1.  Only the shard
+*                containing the bit is locked.
+*   Parameters : bit - the number of the bit to set
+*   Effects    : The specified bit will be set to 1.
+*   Returned   : None
+***************************************************************************/
+void sharded_bit_array_c::SetBit(const size_t bit)
+{
+    bit_shard_t *shard;
+
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    shard = &m_Shards[bit >> m_ShardShift];
+
+    lock_guard<mutex> guard(shard->lock);
+    shard->bits->SetBit(bit & (((size_t)1 << m_ShardShift) - 1));
+}
+
+/***************************************************************************
+*   Method     : ClearBit
+*   Description: This method sets a bit in the array to 0.  Only the shard
+*                containing the bit is locked.
+*   Parameters : bit - the number of the bit to clear
+*   Effects    : The specified bit will be set to 0.
+*   Returned   : None
+***************************************************************************/
+void sharded_bit_array_c::ClearBit(const size_t bit)
+{
+    bit_shard_t *shard;
+
+    if (m_NumBits <= bit)
+    {
+        return;         /* bit out of range */
+    }
+
+    shard = &m_Shards[bit >> m_ShardShift];
+
+    lock_guard<mutex> guard(shard->lock);
+    shard->bits->ClearBit(bit & (((size_t)1 << m_ShardShift) - 1));
+}
+
+/***************************************************************************
+*   Method     : operator[]
+*   Description: Overload of the [] operator.  This method returns the
+*                value of a bit in the array.  Only the shard containing
+*                the bit is locked.
+*   Parameters : bit - index of array bit
+*   Effects    : None
+*   Returned   : The value of the specified bit.  false if the bit is out
+*                of range.
+***************************************************************************/
+bool sharded_bit_array_c::operator[](const size_t bit) const
+{
+    bit_shard_t *shard;
+
+    if (m_NumBits <= bit)
+    {
+        return false;   /* bit out of range */
+    }
+
+    shard = &m_Shards[bit >> m_ShardShift];
+
+    lock_guard<mutex> guard(shard->lock);
+    return (*shard->bits)[bit & (((size_t)1 << m_ShardShift) - 1)];
+}
+
+/***************************************************************************
+*   Method     : BulkOp
+*   Description: This method applies a bit_array_c assignment operator to
+*                each shard of this array, using the matching shard of src
+*                as the source.  Shards are visited in ascending order and
+*                each pair is locked together with std::lock, so two
+*                threads performing a.op(b) and b.op(a) can't deadlock.
+*   Parameters : src - source array with the same size and shard size
+*                op - bit_array_c assignment operator to apply
+*   Effects    : Results of the operation are stored in this array
+*   Returned   : None
+***************************************************************************/
+void sharded_bit_array_c::BulkOp(const sharded_bit_array_c &src,
+    bulk_op_t op)
+{
+    if ((m_NumBits != src.m_NumBits) || (m_ShardShift != src.m_ShardShift))
+    {
+        /* don't do assignment with different array geometries */
+        return;
+    }
+
+    for (size_t i = 0; i < m_NumShards; i++)
+    {
+        if (&src == this)
+        {
+            lock_guard<mutex> guard(m_Shards[i].lock);
+            (m_Shards[i].bits->*op)(*m_Shards[i].bits);
+        }
+        else
+        {
+            lock(m_Shards[i].lock, src.m_Shards[i].lock);
+            lock_guard<mutex> guard(m_Shards[i].lock, adopt_lock);
+            lock_guard<mutex> srcGuard(src.m_Shards[i].lock, adopt_lock);
+
+            (m_Shards[i].bits->*op)(*src.m_Shards[i].bits);
+        }
+    }
+}
+
+/***************************************************************************
+*   Method     : operator&=
+*   Description: overload of the &= operator.  Performs a bitwise and
+*                between the source array and this array one shard at a
+*                time.  This array will contain the result.
+*   Parameters : src - Source array
+*   Effects    : Results of bitwise and are stored in this array
+*   Returned   : Reference to this array after and
+***************************************************************************/
+sharded_bit_array_c& sharded_bit_array_c::operator&=(
+    const sharded_bit_array_c &src)
+{
+    BulkOp(src, &bit_array_c::operator&=);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : operator^=
+*   Description: overload of the ^= operator.  Performs a bitwise xor
+*                between the source array and this array one shard at a
+*                time.  This array will contain the result.
+*   Parameters : src - Source array
+*   Effects    : Results of bitwise xor are stored in this array
+*   Returned   : Reference to this array after xor
+***************************************************************************/
+sharded_bit_array_c& sharded_bit_array_c::operator^=(
+    const sharded_bit_array_c &src)
+{
+    BulkOp(src, &bit_array_c::operator^=);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : operator|=
+*   Description: overload of the |= operator.  Performs a bitwise or
+*                between the source array and this array one shard at a
+*                time.  This array will contain the result.
+*   Parameters : src - Source array
+*   Effects    : Results of bitwise or are stored in this array
+*   Returned   : Reference to this array after or
+***************************************************************************/
+sharded_bit_array_c& sharded_bit_array_c::operator|=(
+    const sharded_bit_array_c &src)
+{
+    BulkOp(src, &bit_array_c::operator|=);
+    return *this;
+}
+
+/***************************************************************************
+*   Method     : Not
+*   Description: Negates all bits in the array one shard at a time.
+*   Parameters : None
+*   Effects    : Contents of the array are negated.
+*   Returned   : Reference to this array after not
+***************************************************************************/
+sharded_bit_array_c& sharded_bit_array_c::Not(void)
+{
+    for (size_t i = 0; i < m_NumShards; i++)
+    {
+        lock_guard<mutex> guard(m_Shards[i].lock);
+        m_Shards[i].bits->Not();
+    }
+
+    return *this;
+}
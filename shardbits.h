@@ -0,0 +1,95 @@
+/***************************************************************************
+*                    Sharded Arrays of Arbitrary Bit Length
+*
+*   File    : shardbits.h
+*   Purpose : Header file for a class that splits an arbitrary length
+*             array of bits into independently locked shards so that it
+*             may be shared by multiple threads.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef SHARD_BITS_H
+#define SHARD_BITS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <mutex>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* one shard: a piece of the array and the lock protecting it */
+struct alignas(64) bit_shard_t
+{
+    std::mutex lock;                    /* held while using bits */
+    bit_array_c *bits;                  /* bits in this shard */
+};
+
+class sharded_bit_array_c
+{
+    public:
+        sharded_bit_array_c(const size_t numBits,
+            const size_t shardBits);
+
+        virtual ~sharded_bit_array_c(void);
+
+        size_t Size() const { return m_NumBits; };
+        size_t ShardBits() const { return (size_t)1 << m_ShardShift; };
+        size_t ShardCount() const { return m_NumShards; };
+        size_t Count(void) const;
+
+        /* set/clear functions */
+        void SetAll(void);
+        void ClearAll(void);
+        void SetBit(const size_t bit);
+        void ClearBit(const size_t bit);
+
+        /* boolean operator */
+        bool operator[](const size_t bit) const;
+
+        /* bulk assignments */
+        sharded_bit_array_c& operator&=(const sharded_bit_array_c &src);
+        sharded_bit_array_c& operator^=(const sharded_bit_array_c &src);
+        sharded_bit_array_c& operator|=(const sharded_bit_array_c &src);
+        sharded_bit_array_c& Not(void);
+
+    private:
+        /* shards can't be copied */
+        sharded_bit_array_c(const sharded_bit_array_c &);
+        sharded_bit_array_c& operator=(const sharded_bit_array_c &);
+
+        typedef bit_array_c& (bit_array_c::*bulk_op_t)(const bit_array_c &);
+        void BulkOp(const sharded_bit_array_c &src, bulk_op_t op);
+
+        size_t m_NumBits;               /* number of bits in the array */
+        size_t m_ShardShift;            /* log2 of bits per shard */
+        size_t m_NumShards;             /* number of shards */
+        bit_shard_t *m_Shards;          /* array of shards */
+};
+
+#endif  /* ndef SHARD_BITS_H */
@@ -0,0 +1,75 @@
+/***************************************************************************
+*                               SimHash
+*
+*   File    : simhash.h
+*   Purpose : Header file for a class that builds SimHash fingerprints of
+*             weighted feature sets in bit arrays.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef SIM_HASH_H
+#define SIM_HASH_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <stdint.h>
+#include "bitarray.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class simhash_c
+{
+    public:
+        simhash_c(const size_t numBits, const uint64_t seed);
+        virtual ~simhash_c(void);
+
+        size_t FingerprintBits() const { return m_NumBits; };
+
+        /* fingerprint index of an array holds bits
+         * [index * FingerprintBits(), (index + 1) * FingerprintBits()),
+         * weights may be NULL for weights of 1 */
+        void Fingerprint(const uint64_t *features, const float *weights,
+            const size_t count, bit_array_c &fingerprints,
+            const size_t index) const;
+        void FingerprintBatch(const uint64_t *const *features,
+            const float *const *weights, const size_t *lengths,
+            const size_t count, bit_array_c &fingerprints,
+            const unsigned int numThreads) const;
+
+        /* number of bits that differ in two fingerprints */
+        size_t Distance(const bit_array_c &a, const size_t aIndex,
+            const bit_array_c &b, const size_t bIndex) const;
+
+    private:
+        void Build(const uint64_t *features, const float *weights,
+            const size_t count, float *sums, unsigned char *chars) const;
+
+        size_t m_NumBits;               /* bits in a fingerprint */
+        uint64_t m_Seed;                /* seed mixed into feature hashes */
+};
+
+#endif  /* ndef SIM_HASH_H */
@@ -0,0 +1,1035 @@
+/***************************************************************************
+*                        Succinct Ordinal Trees
+*
+*   File    : treebits.cpp
+*   Purpose : Provides two ways of storing an ordinal tree of n nodes in
+*             about 2n bits, with navigation done by rank and select (see
+*             rankbits.h) instead of pointers.
+*
+*             A level-order unary degree sequence (LOUDS) tree writes
+*             "10" for a super root and then 1^d 0 for each node of
+*             degree d in level order.  Node x is the 1 numbered x and its
+*             children's 1s follow the 0 numbered x, so parent, child,
+*             sibling and degree are each a rank or select or two.
+*             Subtree size walks down one level at a time.
+*
+*             A balanced parentheses (BP) tree writes a 1 (open) as each
+*             node is entered in a depth-first walk and a 0 (close) as it
+*             is left.  A node is the subtree between its open and the
+*             matching close, so parent, sibling and subtree size come
+*             from finding matching parentheses.  With excess(i) being
+*             the opens minus the closes before position i, the close
+*             matching an open at p is the first position q > p where
+*             excess(q + 1) = excess(p), and the parent's open is the last
+*             position r < p where excess(r) = excess(p) - 1.  Excess
+*             changes by 1 a bit, so the first position at or below the
+*             target is the answer.  That search is done with a range
+*             min-max tree, a complete binary tree over blocks of
+*             BLOCK_BITS holding each node's minimum excess: the block
+*             holding the start is scanned a byte at a time with a table
+*             of each byte's excess change and minimum, and if the answer
+*             isn't there the tree leads to the nearest block that has it
+*             in O(log n) steps.  The tree takes 128 bits per block, 1/4
+*             bit per parenthesis.
+*
+*             Both kinds are built by streaming: the caller hands over
+*             one node (or parenthesis) at a time into a bit array sized
+*             for the node count, and Finish builds the directories.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <algorithm>
+#include <stdexcept>
+#include "treebits.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* parentheses in each leaf of the range min-max tree (multiple of 8) */
+#define BLOCK_BITS            512
+
+/* bit of a parentheses byte array, most significant first */
+#define PAREN_BIT(array, i)   \
+    (((array)[(i) / CHAR_BIT] >> (CHAR_BIT - 1 - ((i) % CHAR_BIT))) & 1)
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* excess change over each byte and the lowest it reaches after a bit */
+class bp_excess_table_c
+{
+    public:
+        bp_excess_table_c(void);
+
+        signed char total[UCHAR_MAX + 1];
+        signed char minimum[UCHAR_MAX + 1];
+};
+
+/***************************************************************************
+*                               FUNCTIONS
+***************************************************************************/
+
+/***************************************************************************
+*   Function   : ExcessTable
+*   Description: This function returns the table of byte excesses.  The
+*                table is built the first time that it is requested.
+*   Parameters : None
+*   Effects    : Builds the excess table on the first call
+*   Returned   : Reference to the excess table
+***************************************************************************/
+static const bp_excess_table_c &ExcessTable(void)
+{
+    static const bp_excess_table_c table;
+    return table;
+}
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : bp_excess_table_c - constructor
+*   Description: This is the bp_excess_table_c constructor.  It fills in
+*                the excess change of every unsigned char value and the
+*                minimum excess after each of its bits.
+*   Parameters : None
+*   Effects    : Table is filled in
+*   Returned   : None
+***************************************************************************/
+bp_excess_table_c::bp_excess_table_c(void)
+{
+    for (unsigned int value = 0; value <= UCHAR_MAX; value++)
+    {
+        int excess = 0;
+        int lowest = CHAR_BIT;
+
+        for (int bit = 0; bit < CHAR_BIT; bit++)
+        {
+            excess += ((value >> (CHAR_BIT - 1 - bit)) & 1) ? 1 : -1;
+            lowest = min(lowest, excess);
+        }
+
+        total[value] = (signed char)excess;
+        minimum[value] = (signed char)lowest;
+    }
+}
+
+/***************************************************************************
+*   Method     : louds_tree_c - constructor
+*   Description: This is the louds_tree_c constructor.  It allocates the
+*                bits for a tree, which must then be given its nodes with
+*                AddNode and completed with Finish.
+*   Parameters : numNodes - number of nodes in the tree (at least 1)
+*   Effects    : An empty tree is allocated
+*   Returned   : None
+***************************************************************************/
+louds_tree_c::louds_tree_c(const size_t numNodes):
+    m_NumNodes(numNodes),
+    m_NodesAdded(0),
+    m_Written(2),
+    m_Bits((2 * numNodes) + 1),
+    m_Ranks(NULL)
+{
+    if (numNodes == 0)
+    {
+        throw invalid_argument("Error: Tree must have at least 1 node.");
+    }
+
+    /* super root with the root as its only child */
+    m_Bits.ClearAll();
+    m_Bits.SetBit(0);
+}
+
+/***************************************************************************
+*   Method     : ~louds_tree_c - destructor
+*   Description: This is the louds_tree_c destructor.  It frees the rank
+*                directory.
+*   Parameters : None
+*   Effects    : Directory is freed
+*   Returned   : None
+***************************************************************************/
+louds_tree_c::~louds_tree_c(void)
+{
+    delete m_Ranks;
+}
+
+/***************************************************************************
+*   Method     : AddNode
+*   Description: This method appends the next node in level order.
+*   Parameters : degree - number of children of the node
+*   Effects    : degree 1s and a 0 are written
+*   Returned   : None
+***************************************************************************/
+void louds_tree_c::AddNode(const size_t degree)
+{
+    /* the node must be a child of an earlier node (its 1 written), and
+     * there must be room for the 0s of the nodes still to come */
+    if ((m_NodesAdded == m_NumNodes) ||
+        ((m_Written - 1 - m_NodesAdded) <= m_NodesAdded) ||
+        (degree > (m_Bits.Size() - m_Written - (m_NumNodes - m_NodesAdded))))
+    {
+        throw invalid_argument(
+            "Error: LOUDS tree has more nodes or children than declared.");
+    }
+
+    for (size_t i = 0; i < degree; i++)
+    {
+        m_Bits.SetBit(m_Written++);
+    }
+
+    m_Written++;
+    m_NodesAdded++;
+}
+
+/***************************************************************************
+*   Method     : Finish
+*   Description: This method checks that the whole tree has been added and
+*                builds the rank directory used for navigation.
+*   Parameters : None
+*   Effects    : Rank directory is built
+*   Returned   : None
+***************************************************************************/
+void louds_tree_c::Finish(void)
+{
+    if (m_Written != m_Bits.Size())
+    {
+        throw invalid_argument("Error: LOUDS tree is incomplete.");
+    }
+
+    delete m_Ranks;
+    m_Ranks = NULL;
+    m_Ranks = new rank_select_c(m_Bits);
+}
+
+/***************************************************************************
+*   Method     : Parent
+*   Description: This method finds a node's parent.  A node's 1 lies in
+*                its parent's degree run, which follows the parent's 0.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Parent, Size() for the root
+***************************************************************************/
+size_t louds_tree_c::Parent(const size_t node) const
+{
+    if ((node == 0) || (node >= m_NumNodes))
+    {
+        return m_NumNodes;
+    }
+
+    return m_Ranks->Rank0(m_Ranks->Select1(node)) - 1;
+}
+
+/***************************************************************************
+*   Method     : FirstChild
+*   Description: This method finds a node's first child.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : First child, Size() for a leaf
+***************************************************************************/
+size_t louds_tree_c::FirstChild(const size_t node) const
+{
+    return Child(node, 0);
+}
+
+/***************************************************************************
+*   Method     : LastChild
+*   Description: This method finds a node's last child, the 1 before the 0
+*                ending the node's degree run.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Last child, Size() for a leaf
+***************************************************************************/
+size_t louds_tree_c::LastChild(const size_t node) const
+{
+    size_t end;
+
+    if (node >= m_NumNodes)
+    {
+        return m_NumNodes;
+    }
+
+    end = m_Ranks->Select0(node + 1);
+
+    if (!m_Bits[end - 1])
+    {
+        return m_NumNodes;
+    }
+
+    return m_Ranks->Rank1(end) - 1;
+}
+
+/***************************************************************************
+*   Method     : Child
+*   Description: This method finds one of a node's children.  Children are
+*                numbered consecutively from the 1 after the node's 0.
+*   Parameters : node - node number
+*                index - which child, counting from 0
+*   Effects    : None
+*   Returned   : Child number index, Size() if there aren't that many
+***************************************************************************/
+size_t louds_tree_c::Child(const size_t node, const size_t index) const
+{
+    size_t start;
+
+    if (node >= m_NumNodes)
+    {
+        return m_NumNodes;
+    }
+
+    start = m_Ranks->Select0(node) + 1;
+
+    if (index >= (m_Ranks->Select0(node + 1) - start))
+    {
+        return m_NumNodes;
+    }
+
+    return m_Ranks->Rank1(start) + index;
+}
+
+/***************************************************************************
+*   Method     : NextSibling
+*   Description: This method finds the sibling after a node, the node of
+*                the next 1 if it's in the same degree run.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Next sibling, Size() if node is the last child
+***************************************************************************/
+size_t louds_tree_c::NextSibling(const size_t node) const
+{
+    if ((node == 0) || (node >= m_NumNodes) ||
+        !m_Bits[m_Ranks->Select1(node) + 1])
+    {
+        return m_NumNodes;
+    }
+
+    return node + 1;
+}
+
+/***************************************************************************
+*   Method     : PrevSibling
+*   Description: This method finds the sibling before a node, the node of
+*                the previous 1 if it's in the same degree run.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Previous sibling, Size() if node is the first child
+***************************************************************************/
+size_t louds_tree_c::PrevSibling(const size_t node) const
+{
+    if ((node == 0) || (node >= m_NumNodes) ||
+        !m_Bits[m_Ranks->Select1(node) - 1])
+    {
+        return m_NumNodes;
+    }
+
+    return node - 1;
+}
+
+/***************************************************************************
+*   Method     : Degree
+*   Description: This method returns the number of children of a node, the
+*                length of its run of 1s.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Number of children, 0 if node is out of range
+***************************************************************************/
+size_t louds_tree_c::Degree(const size_t node) const
+{
+    if (node >= m_NumNodes)
+    {
+        return 0;
+    }
+
+    return m_Ranks->Select0(node + 1) - m_Ranks->Select0(node) - 1;
+}
+
+/***************************************************************************
+*   Method     : IsLeaf
+*   Description: This method tests if a node has no children.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : true if node is a leaf (or out of range)
+***************************************************************************/
+bool louds_tree_c::IsLeaf(const size_t node) const
+{
+    if (node >= m_NumNodes)
+    {
+        return true;
+    }
+
+    return !m_Bits[m_Ranks->Select0(node) + 1];
+}
+
+/***************************************************************************
+*   Method     : SubtreeSize
+*   Description: This method counts the nodes in a node's subtree.  The
+*                subtree's nodes on each level are consecutive, and the
+*                children of nodes [first, end) are the nodes of the 1s
+*                between 0 number first and 0 number end, so each level's
+*                range comes from the one above it.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Number of nodes in the subtree, 0 if node is out of range
+***************************************************************************/
+size_t louds_tree_c::SubtreeSize(const size_t node) const
+{
+    size_t first, end, size;
+
+    if (node >= m_NumNodes)
+    {
+        return 0;
+    }
+
+    first = node;
+    end = node + 1;
+    size = 0;
+
+    while (first < end)
+    {
+        size += end - first;
+        first = m_Ranks->Rank1(m_Ranks->Select0(first));
+        end = m_Ranks->Rank1(m_Ranks->Select0(end));
+    }
+
+    return size;
+}
+
+/***************************************************************************
+*   Method     : bp_tree_c - constructor
+*   Description: This is the bp_tree_c constructor.  It allocates the bits
+*                for a tree, which must then be given its parentheses with
+*                Open and Close and completed with Finish.
+*   Parameters : numNodes - number of nodes in the tree (at least 1)
+*   Effects    : An empty tree is allocated
+*   Returned   : None
+***************************************************************************/
+bp_tree_c::bp_tree_c(const size_t numNodes):
+    m_NumNodes(numNodes),
+    m_Written(0),
+    m_Depth(0),
+    m_Bits(2 * numNodes),
+    m_Ranks(NULL),
+    m_Leaves(0)
+{
+    if (numNodes == 0)
+    {
+        throw invalid_argument("Error: Tree must have at least 1 node.");
+    }
+
+    m_Bits.ClearAll();
+}
+
+/***************************************************************************
+*   Method     : ~bp_tree_c - destructor
+*   Description: This is the bp_tree_c destructor.  It frees the rank
+*                directory.
+*   Parameters : None
+*   Effects    : Directory is freed
+*   Returned   : None
+***************************************************************************/
+bp_tree_c::~bp_tree_c(void)
+{
+    delete m_Ranks;
+}
+
+/***************************************************************************
+*   Method     : Open
+*   Description: This method enters a new node, a child of the node that
+*                is open, or the root if this is the first call.
+*   Parameters : None
+*   Effects    : An open parenthesis is written
+*   Returned   : None
+***************************************************************************/
+void bp_tree_c::Open(void)
+{
+    /* one root, and room left to close everything that's open */
+    if (((m_Depth == 0) && (m_Written != 0)) ||
+        ((m_Written + (size_t)m_Depth + 2) > m_Bits.Size()))
+    {
+        throw invalid_argument(
+            "Error: Parentheses don't describe a tree of the declared size.");
+    }
+
+    m_Bits.SetBit(m_Written++);
+    m_Depth++;
+}
+
+/***************************************************************************
+*   Method     : Close
+*   Description: This method leaves the node that is open.
+*   Parameters : None
+*   Effects    : A close parenthesis is written
+*   Returned   : None
+***************************************************************************/
+void bp_tree_c::Close(void)
+{
+    if (m_Depth == 0)
+    {
+        throw invalid_argument(
+            "Error: Parentheses don't describe a tree of the declared size.");
+    }
+
+    m_Written++;
+    m_Depth--;
+}
+
+/***************************************************************************
+*   Method     : Finish
+*   Description: This method checks that every node has been closed and
+*                builds the rank directory and the range min-max tree.
+*   Parameters : None
+*   Effects    : Directory and min-max tree are built
+*   Returned   : None
+***************************************************************************/
+void bp_tree_c::Finish(void)
+{
+    const bp_excess_table_c &table = ExcessTable();
+    const size_t size = m_Bits.Size();
+    size_t numBlocks;
+    int64_t excess;
+
+    if ((m_Written != size) || (m_Depth != 0))
+    {
+        throw invalid_argument("Error: Parentheses tree is incomplete.");
+    }
+
+    delete m_Ranks;
+    m_Ranks = NULL;
+    m_Ranks = new rank_select_c(m_Bits);
+
+    numBlocks = (size + BLOCK_BITS - 1) / BLOCK_BITS;
+
+    for (m_Leaves = 1; m_Leaves < numBlocks; m_Leaves *= 2);
+
+    m_MinExcess.assign(2 * m_Leaves, INT64_MAX);
+    excess = 0;
+
+    /* leaves hold the minimum excess after each bit of their block */
+    for (size_t block = 0; block < numBlocks; block++)
+    {
+        const size_t end = min(size, (block + 1) * BLOCK_BITS);
+        int64_t lowest = INT64_MAX;
+        size_t i;
+
+        for (i = block * BLOCK_BITS; (i + CHAR_BIT) <= end; i += CHAR_BIT)
+        {
+            unsigned char byte = m_Bits.Chars()[i / CHAR_BIT];
+
+            lowest = min(lowest, excess + table.minimum[byte]);
+            excess += table.total[byte];
+        }
+
+        for (; i < end; i++)
+        {
+            excess += PAREN_BIT(m_Bits.Chars(), i) ? 1 : -1;
+            lowest = min(lowest, excess);
+        }
+
+        m_MinExcess[m_Leaves + block] = lowest;
+    }
+
+    for (size_t node = m_Leaves; node-- > 1;)
+    {
+        m_MinExcess[node] =
+            min(m_MinExcess[2 * node], m_MinExcess[(2 * node) + 1]);
+    }
+}
+
+/***************************************************************************
+*   Method     : Excess
+*   Description: This method returns the opens minus the closes before a
+*                position.
+*   Parameters : pos - position
+*   Effects    : None
+*   Returned   : Excess before pos
+***************************************************************************/
+int64_t bp_tree_c::Excess(const size_t pos) const
+{
+    return (2 * (int64_t)m_Ranks->Rank1(pos)) - (int64_t)pos;
+}
+
+/***************************************************************************
+*   Method     : ScanForward
+*   Description: This method scans part of a block for the first position
+*                with the excess after it at or below a target, a byte at
+*                a time until a byte that reaches the target.
+*   Parameters : pos - first position to scan
+*                end - one past the last position to scan
+*                excess - excess before pos
+*                target - excess being searched for
+*   Effects    : None
+*   Returned   : First position found, or the number of bits if none is
+***************************************************************************/
+size_t bp_tree_c::ScanForward(size_t pos, const size_t end, int64_t excess,
+    const int64_t target) const
+{
+    const bp_excess_table_c &table = ExcessTable();
+
+    while (pos < end)
+    {
+        if (((pos % CHAR_BIT) == 0) && ((pos + CHAR_BIT) <= end))
+        {
+            unsigned char byte = m_Bits.Chars()[pos / CHAR_BIT];
+
+            if ((excess + table.minimum[byte]) > target)
+            {
+                excess += table.total[byte];
+                pos += CHAR_BIT;
+                continue;
+            }
+        }
+
+        excess += PAREN_BIT(m_Bits.Chars(), pos) ? 1 : -1;
+
+        if (excess <= target)
+        {
+            return pos;
+        }
+
+        pos++;
+    }
+
+    return m_Bits.Size();
+}
+
+/***************************************************************************
+*   Method     : ScanBackward
+*   Description: This method scans part of a block for the last position
+*                with the excess after it at or below a target, a byte at
+*                a time until a byte that reaches the target.
+*   Parameters : end - one past the last position to scan
+*                begin - first position to scan
+*                excess - excess before end
+*                target - excess being searched for
+*   Effects    : None
+*   Returned   : Last position found, or the number of bits if none is
+***************************************************************************/
+size_t bp_tree_c::ScanBackward(size_t end, const size_t begin,
+    int64_t excess, const int64_t target) const
+{
+    const bp_excess_table_c &table = ExcessTable();
+
+    while (end > begin)
+    {
+        if (((end % CHAR_BIT) == 0) && ((end - CHAR_BIT) >= begin))
+        {
+            unsigned char byte = m_Bits.Chars()[(end / CHAR_BIT) - 1];
+            int64_t start = excess - table.total[byte];
+
+            if ((start + table.minimum[byte]) > target)
+            {
+                excess = start;
+                end -= CHAR_BIT;
+                continue;
+            }
+        }
+
+        if (excess <= target)
+        {
+            return end - 1;
+        }
+
+        excess -= PAREN_BIT(m_Bits.Chars(), end - 1) ? 1 : -1;
+        end--;
+    }
+
+    return m_Bits.Size();
+}
+
+/***************************************************************************
+*   Method     : NextBlock
+*   Description: This method uses the min-max tree to find the first block
+*                after a block that reaches a target excess.  It climbs
+*                until a right sibling reaches the target, then descends
+*                to that sibling's leftmost leaf that does.
+*   Parameters : block - block to search after
+*                target - excess being searched for
+*   Effects    : None
+*   Returned   : Block found, or the number of leaves if none is
+***************************************************************************/
+size_t bp_tree_c::NextBlock(size_t block, const int64_t target) const
+{
+    size_t node = m_Leaves + block;
+
+    for (;;)
+    {
+        if (node == 1)
+        {
+            return m_Leaves;
+        }
+
+        if (((node % 2) == 0) && (m_MinExcess[node + 1] <= target))
+        {
+            node++;
+            break;
+        }
+
+        node /= 2;
+    }
+
+    while (node < m_Leaves)
+    {
+        node = (m_MinExcess[2 * node] <= target) ?
+            (2 * node) : ((2 * node) + 1);
+    }
+
+    return node - m_Leaves;
+}
+
+/***************************************************************************
+*   Method     : PrevBlock
+*   Description: This method uses the min-max tree to find the last block
+*                before a block that reaches a target excess.
+*   Parameters : block - block to search before
+*                target - excess being searched for
+*   Effects    : None
+*   Returned   : Block found, or the number of leaves if none is
+***************************************************************************/
+size_t bp_tree_c::PrevBlock(size_t block, const int64_t target) const
+{
+    size_t node = m_Leaves + block;
+
+    for (;;)
+    {
+        if (node == 1)
+        {
+            return m_Leaves;
+        }
+
+        if (((node % 2) == 1) && (m_MinExcess[node - 1] <= target))
+        {
+            node--;
+            break;
+        }
+
+        node /= 2;
+    }
+
+    while (node < m_Leaves)
+    {
+        node = (m_MinExcess[(2 * node) + 1] <= target) ?
+            ((2 * node) + 1) : (2 * node);
+    }
+
+    return node - m_Leaves;
+}
+
+/***************************************************************************
+*   Method     : Forward
+*   Description: This method finds the first position at or after pos with
+*                the excess after it at or below a target.
+*   Parameters : pos - first position to search
+*                target - excess being searched for
+*   Effects    : None
+*   Returned   : Position found, or the number of bits if none is
+***************************************************************************/
+size_t bp_tree_c::Forward(const size_t pos, const int64_t target) const
+{
+    const size_t size = m_Bits.Size();
+    size_t found, block, start;
+
+    if (pos >= size)
+    {
+        return size;
+    }
+
+    block = pos / BLOCK_BITS;
+    found = ScanForward(pos, min(size, (block + 1) * BLOCK_BITS),
+        Excess(pos), target);
+
+    if (found != size)
+    {
+        return found;
+    }
+
+    block = NextBlock(block, target);
+
+    if (block == m_Leaves)
+    {
+        return size;
+    }
+
+    start = block * BLOCK_BITS;
+    return ScanForward(start, min(size, start + BLOCK_BITS), Excess(start),
+        target);
+}
+
+/***************************************************************************
+*   Method     : Backward
+*   Description: This method finds the last position before end with the
+*                excess after it at or below a target.
+*   Parameters : end - one past the last position to search
+*                target - excess being searched for
+*   Effects    : None
+*   Returned   : Position found, or the number of bits if none is
+***************************************************************************/
+size_t bp_tree_c::Backward(const size_t end, const int64_t target) const
+{
+    const size_t size = m_Bits.Size();
+    size_t found, block, start, stop;
+
+    if (end == 0)
+    {
+        return size;
+    }
+
+    block = (end - 1) / BLOCK_BITS;
+    found = ScanBackward(end, block * BLOCK_BITS, Excess(end), target);
+
+    if (found != size)
+    {
+        return found;
+    }
+
+    block = PrevBlock(block, target);
+
+    if (block == m_Leaves)
+    {
+        return size;
+    }
+
+    start = block * BLOCK_BITS;
+    stop = min(size, start + BLOCK_BITS);
+    return ScanBackward(stop, start, Excess(stop), target);
+}
+
+/***************************************************************************
+*   Method     : FindClose
+*   Description: This method finds the close matching an open, the first
+*                position after it where the excess returns to its level.
+*   Parameters : pos - position of an open
+*   Effects    : None
+*   Returned   : Position of the matching close
+***************************************************************************/
+size_t bp_tree_c::FindClose(const size_t pos) const
+{
+    return Forward(pos + 1, Excess(pos));
+}
+
+/***************************************************************************
+*   Method     : Enclosing
+*   Description: This method finds the last position before end where the
+*                excess before it is at or below a target.  With the target
+*                one below an open's excess it finds the enclosing open,
+*                and with the excess after a close it finds the matching
+*                open.
+*   Parameters : end - position to search before
+*                target - excess being searched for
+*   Effects    : None
+*   Returned   : Position found, or the number of bits if none is
+***************************************************************************/
+size_t bp_tree_c::Enclosing(const size_t end, const int64_t target) const
+{
+    size_t found;
+
+    if (end == 0)
+    {
+        return m_Bits.Size();
+    }
+
+    /* the excess before position r is the excess after r - 1 */
+    found = Backward(end - 1, target);
+
+    if (found != m_Bits.Size())
+    {
+        return found + 1;
+    }
+
+    return (target >= 0) ? 0 : m_Bits.Size();
+}
+
+/***************************************************************************
+*   Method     : Parent
+*   Description: This method finds a node's parent, the open enclosing the
+*                node's open.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Parent, Size() for the root
+***************************************************************************/
+size_t bp_tree_c::Parent(const size_t node) const
+{
+    size_t pos;
+
+    if ((node == 0) || (node >= m_NumNodes))
+    {
+        return m_NumNodes;
+    }
+
+    pos = m_Ranks->Select1(node);
+    return m_Ranks->Rank1(Enclosing(pos, Excess(pos) - 1));
+}
+
+/***************************************************************************
+*   Method     : FirstChild
+*   Description: This method finds a node's first child, which opens right
+*                after the node does.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : First child, Size() for a leaf
+***************************************************************************/
+size_t bp_tree_c::FirstChild(const size_t node) const
+{
+    return IsLeaf(node) ? m_NumNodes : (node + 1);
+}
+
+/***************************************************************************
+*   Method     : LastChild
+*   Description: This method finds a node's last child, the open matching
+*                the close just before the node's close.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Last child, Size() for a leaf
+***************************************************************************/
+size_t bp_tree_c::LastChild(const size_t node) const
+{
+    size_t close;
+
+    if (IsLeaf(node))
+    {
+        return m_NumNodes;
+    }
+
+    close = FindClose(m_Ranks->Select1(node)) - 1;
+    return m_Ranks->Rank1(Enclosing(close, Excess(close + 1)));
+}
+
+/***************************************************************************
+*   Method     : NextSibling
+*   Description: This method finds the sibling after a node, which opens
+*                right after the node closes.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Next sibling, Size() if node is the last child
+***************************************************************************/
+size_t bp_tree_c::NextSibling(const size_t node) const
+{
+    size_t next;
+
+    if ((node == 0) || (node >= m_NumNodes))
+    {
+        return m_NumNodes;
+    }
+
+    next = FindClose(m_Ranks->Select1(node)) + 1;
+
+    if ((next >= m_Bits.Size()) || !PAREN_BIT(m_Bits.Chars(), next))
+    {
+        return m_NumNodes;
+    }
+
+    return m_Ranks->Rank1(next);
+}
+
+/***************************************************************************
+*   Method     : PrevSibling
+*   Description: This method finds the sibling before a node, the open
+*                matching the close right before the node opens.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Previous sibling, Size() if node is the first child
+***************************************************************************/
+size_t bp_tree_c::PrevSibling(const size_t node) const
+{
+    size_t pos;
+
+    if ((node == 0) || (node >= m_NumNodes))
+    {
+        return m_NumNodes;
+    }
+
+    pos = m_Ranks->Select1(node);
+
+    if (PAREN_BIT(m_Bits.Chars(), pos - 1))
+    {
+        return m_NumNodes;
+    }
+
+    return m_Ranks->Rank1(Enclosing(pos - 1, Excess(pos)));
+}
+
+/***************************************************************************
+*   Method     : Depth
+*   Description: This method returns a node's depth, the number of nodes
+*                open before it.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Depth of node, the root has depth 0
+***************************************************************************/
+size_t bp_tree_c::Depth(const size_t node) const
+{
+    if (node >= m_NumNodes)
+    {
+        return 0;
+    }
+
+    return (size_t)Excess(m_Ranks->Select1(node));
+}
+
+/***************************************************************************
+*   Method     : SubtreeSize
+*   Description: This method counts the nodes in a node's subtree, half of
+*                the parentheses from its open to its close.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : Number of nodes in the subtree, 0 if node is out of range
+***************************************************************************/
+size_t bp_tree_c::SubtreeSize(const size_t node) const
+{
+    size_t pos;
+
+    if (node >= m_NumNodes)
+    {
+        return 0;
+    }
+
+    pos = m_Ranks->Select1(node);
+    return (FindClose(pos) - pos + 1) / 2;
+}
+
+/***************************************************************************
+*   Method     : IsLeaf
+*   Description: This method tests if a node has no children, if its open
+*                is followed by a close.
+*   Parameters : node - node number
+*   Effects    : None
+*   Returned   : true if node is a leaf (or out of range)
+***************************************************************************/
+bool bp_tree_c::IsLeaf(const size_t node) const
+{
+    if (node >= m_NumNodes)
+    {
+        return true;
+    }
+
+    return !PAREN_BIT(m_Bits.Chars(), m_Ranks->Select1(node) + 1);
+}
@@ -0,0 +1,138 @@
+/***************************************************************************
+*                        Succinct Ordinal Trees
+*
+*   File    : treebits.h
+*   Purpose : Header file for trees stored in about 2 bits per node,
+*             level-order unary degree sequence (LOUDS) trees and
+*             balanced parentheses trees, built a node at a time.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef TREE_BITS_H
+#define TREE_BITS_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <vector>
+#include <stdint.h>
+#include "bitarray.h"
+#include "rankbits.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* nodes are numbered in level order, navigation returns Size() for none */
+class louds_tree_c
+{
+    public:
+        louds_tree_c(const size_t numNodes);
+        virtual ~louds_tree_c(void);
+
+        /* give each node's degree in level order, then call Finish */
+        void AddNode(const size_t degree);
+        void Finish(void);
+
+        size_t Size() const { return m_NumNodes; };
+
+        size_t Parent(const size_t node) const;
+        size_t FirstChild(const size_t node) const;
+        size_t LastChild(const size_t node) const;
+        size_t Child(const size_t node, const size_t index) const;
+        size_t NextSibling(const size_t node) const;
+        size_t PrevSibling(const size_t node) const;
+        size_t Degree(const size_t node) const;
+        bool IsLeaf(const size_t node) const;
+
+        /* nodes in the subtree, O(height of the subtree) */
+        size_t SubtreeSize(const size_t node) const;
+
+    private:
+        /* trees can't be copied */
+        louds_tree_c(const louds_tree_c &);
+        louds_tree_c& operator=(const louds_tree_c &);
+
+        size_t m_NumNodes;              /* nodes in the tree */
+        size_t m_NodesAdded;            /* nodes given to AddNode */
+        size_t m_Written;               /* bits written so far */
+        bit_array_c m_Bits;             /* 1^degree 0 for each node */
+        rank_select_c *m_Ranks;         /* directory built by Finish */
+};
+
+/* nodes are numbered in depth-first order, navigation returns Size() for
+ * none */
+class bp_tree_c
+{
+    public:
+        bp_tree_c(const size_t numNodes);
+        virtual ~bp_tree_c(void);
+
+        /* open each node as it's entered and close it as it's left in a
+         * depth-first walk, then call Finish */
+        void Open(void);
+        void Close(void);
+        void Finish(void);
+
+        size_t Size() const { return m_NumNodes; };
+
+        size_t Parent(const size_t node) const;
+        size_t FirstChild(const size_t node) const;
+        size_t LastChild(const size_t node) const;
+        size_t NextSibling(const size_t node) const;
+        size_t PrevSibling(const size_t node) const;
+        size_t Depth(const size_t node) const;      /* root is 0 */
+        size_t SubtreeSize(const size_t node) const;
+        bool IsLeaf(const size_t node) const;
+
+    private:
+        /* trees can't be copied */
+        bp_tree_c(const bp_tree_c &);
+        bp_tree_c& operator=(const bp_tree_c &);
+
+        int64_t Excess(const size_t pos) const;
+        size_t ScanForward(size_t pos, const size_t end, int64_t excess,
+            const int64_t target) const;
+        size_t ScanBackward(size_t end, const size_t begin, int64_t excess,
+            const int64_t target) const;
+        size_t Forward(const size_t pos, const int64_t target) const;
+        size_t Backward(const size_t end, const int64_t target) const;
+        size_t NextBlock(size_t block, const int64_t target) const;
+        size_t PrevBlock(size_t block, const int64_t target) const;
+        size_t FindClose(const size_t pos) const;
+        size_t Enclosing(const size_t end, const int64_t target) const;
+
+        size_t m_NumNodes;              /* nodes in the tree */
+        size_t m_Written;               /* parentheses written so far */
+        int64_t m_Depth;                /* open minus close so far */
+        bit_array_c m_Bits;             /* 1 opens a node, 0 closes it */
+        rank_select_c *m_Ranks;         /* directory built by Finish */
+
+        /* range min tree over blocks, leaves from m_Leaves on */
+        size_t m_Leaves;
+        std::vector<int64_t> m_MinExcess;
+};
+
+#endif  /* ndef TREE_BITS_H */
@@ -0,0 +1,949 @@
+/***************************************************************************
+*                            Wavelet Matrix
+*
+*   File    : wavelet.cpp
+*   Purpose : Provides a wavelet matrix (see "The Wavelet Matrix", SPIRE
+*             2012).  A sequence of n values of L bits is stored as L
+*             bit arrays of n bits.  Level 0 holds the most significant
+*             bit of every value.  The values are then stably
+*             reordered with the 0s of that level first, and level 1
+*             holds their next bit, and so on.  Each level has a
+*             rank/select directory (see rankbits.h), so a value can be
+*             followed from level to level in constant time, and every
+*             query takes O(L) rank or select operations.  The structure
+*             takes n * L bits plus 12.5% for the directories.
+*
+*             Construction builds the levels in order, since each level's
+*             order depends on the one above it, but the work within a
+*             level is split among threads: each chunk of CHUNK_VALUES
+*             values writes its own bytes of the level and counts its 0s,
+*             and after a prefix sum of the counts each chunk moves its
+*             values to their place in the next level's order.
+*
+*             A matrix is serialized as the 4 characters "WAVM", a
+*             version byte, the number of levels, the number of values as
+*             8 bytes least significant first, and then each level in
+*             bit array format (see bit_array_c::Serialize).  The rank
+*             directories are rebuilt when a matrix is read.
+*
+*             The Huffman shaped wavelet tree stores a sequence of bytes
+*             in less than n * (H0 + 1) bits plus 12.5% for directories,
+*             where H0 is the zero order entropy of the sequence.  Each
+*             byte's Huffman code is the path from the root to its leaf,
+*             and each internal node has a bit array with one bit per
+*             byte passing through it, so frequent bytes take short paths
+*             and access and rank take O(H0) rank operations on average.
+*
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include "wavelet.h"
+#include "bitwords.h"
+#include "parallel.h"
+
+using namespace std;
+
+/***************************************************************************
+*                                 MACROS
+***************************************************************************/
+
+/* values handled by each piece of level construction (a multiple of 8) */
+#define CHUNK_VALUES          65536
+
+/* serialized matrices start with a magic number and version */
+#define SERIAL_MAGIC          "WAVM"
+#define SERIAL_VERSION        1
+#define SERIAL_HEADER_CHARS   (4 + 1 + 1 + 8)
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+
+/* range of the matrix at some level holding values with one prefix */
+typedef struct
+{
+    size_t begin;               /* first position in the level */
+    size_t end;                 /* one past the last position */
+    unsigned int level;         /* level the range is in */
+    uint32_t prefix;            /* high bits shared by the values */
+} wavelet_range_t;
+
+/* orders ranges by size, then by prefix, for TopK's priority queue */
+class wavelet_range_less_c
+{
+    public:
+        bool operator()(const wavelet_range_t &a,
+            const wavelet_range_t &b) const
+        {
+            if ((a.end - a.begin) != (b.end - b.begin))
+            {
+                return (a.end - a.begin) < (b.end - b.begin);
+            }
+
+            return a.prefix > b.prefix;
+        }
+};
+
+/***************************************************************************
+*                                 METHODS
+***************************************************************************/
+
+/***************************************************************************
+*   Method     : wavelet_matrix_c - constructor
+*   Description: This is the wavelet_matrix_c constructor.  It builds the
+*                levels for a sequence of values.  The number of levels is
+*                the number of bits in the largest value.
+*   Parameters : values - array of values
+*                count - number of values (at least 1)
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : Levels and their directories are built
+*   Returned   : None
+***************************************************************************/
+wavelet_matrix_c::wavelet_matrix_c(const uint32_t *values, const size_t count,
+    const unsigned int numThreads):
+    m_Size(count)
+{
+    vector<uint32_t> current(values, values + count), next(count);
+    vector<size_t> chunkZeros;
+    size_t numChunks;
+    unsigned int numLevels;
+    uint32_t largest;
+
+    if (count == 0)
+    {
+        throw invalid_argument(
+            "Error: Wavelet matrix must have at least 1 value.");
+    }
+
+    largest = *max_element(values, values + count);
+
+    for (numLevels = 1; (numLevels < 32) && ((largest >> numLevels) != 0);
+        numLevels++);
+
+    numChunks = (count + CHUNK_VALUES - 1) / CHUNK_VALUES;
+    chunkZeros.resize(numChunks + 1);
+
+    try
+    {
+        for (unsigned int level = 0; level < numLevels; level++)
+        {
+            const unsigned int shift = numLevels - 1 - level;
+            bit_array_c *bits = new bit_array_c(count);
+            size_t zeros;
+
+            m_Levels.push_back(bits);
+
+            /* write this level's bits and count each chunk's 0s */
+            ParallelFor(numChunks, numThreads,
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t chunk = begin; chunk < end; chunk++)
+                    {
+                        size_t first = chunk * CHUNK_VALUES;
+                        size_t last = min(count, first + CHUNK_VALUES);
+                        size_t ones = 0;
+
+                        for (size_t i = first; i < last; i += CHAR_BIT)
+                        {
+                            unsigned char byte = 0;
+
+                            for (size_t j = i; j < min(last, i + CHAR_BIT);
+                                j++)
+                            {
+                                unsigned char bit =
+                                    (current[j] >> shift) & 1;
+
+                                byte |= bit << (CHAR_BIT - 1 - (j - i));
+                                ones += bit;
+                            }
+
+                            bits->Chars()[i / CHAR_BIT] = byte;
+                        }
+
+                        chunkZeros[chunk] = (last - first) - ones;
+                    }
+                });
+
+            /* chunk offsets in the 0 and 1 parts of the next order */
+            zeros = 0;
+
+            for (size_t chunk = 0; chunk < numChunks; chunk++)
+            {
+                size_t chunkCount = chunkZeros[chunk];
+
+                chunkZeros[chunk] = zeros;
+                zeros += chunkCount;
+            }
+
+            m_Zeros.push_back(zeros);
+
+            /* stable partition into the next order */
+            ParallelFor(numChunks, numThreads,
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t chunk = begin; chunk < end; chunk++)
+                    {
+                        size_t first = chunk * CHUNK_VALUES;
+                        size_t last = min(count, first + CHUNK_VALUES);
+                        size_t pos[2];
+
+                        /* index by the bit, the bits are unpredictable */
+                        pos[0] = chunkZeros[chunk];
+                        pos[1] = zeros + (first - pos[0]);
+
+                        for (size_t i = first; i < last; i++)
+                        {
+                            next[pos[(current[i] >> shift) & 1]++] =
+                                current[i];
+                        }
+                    }
+                });
+
+            current.swap(next);
+            m_Ranks.push_back(new rank_select_c(*bits));
+        }
+    }
+    catch (...)
+    {
+        Free();
+        throw;
+    }
+}
+
+/***************************************************************************
+*   Method     : wavelet_matrix_c - constructor
+*   Description: This is the wavelet_matrix_c constructor.  It reads a
+*                matrix written by Serialize from a binary stream.
+*   Parameters : inStream - stream to read from
+*   Effects    : Levels are read and their directories built
+*   Returned   : None
+***************************************************************************/
+wavelet_matrix_c::wavelet_matrix_c(std::istream &inStream)
+{
+    unsigned char header[SERIAL_HEADER_CHARS];
+    unsigned int numLevels;
+
+    inStream.read((char *)header, SERIAL_HEADER_CHARS);
+
+    if (!inStream || (memcmp(header, SERIAL_MAGIC, 4) != 0) ||
+        (header[4] != SERIAL_VERSION) || (header[5] < 1) ||
+        (header[5] > 32))
+    {
+        throw invalid_argument("Error: Invalid wavelet matrix stream.");
+    }
+
+    numLevels = header[5];
+    m_Size = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        m_Size |= (size_t)header[6 + i] << (CHAR_BIT * i);
+    }
+
+    try
+    {
+        for (unsigned int level = 0; level < numLevels; level++)
+        {
+            bit_array_c *bits = new bit_array_c(inStream);
+
+            m_Levels.push_back(bits);
+
+            if (bits->Size() != m_Size)
+            {
+                throw invalid_argument(
+                    "Error: Invalid wavelet matrix stream.");
+            }
+
+            m_Ranks.push_back(new rank_select_c(*bits));
+            m_Zeros.push_back(m_Size - m_Ranks.back()->Ones());
+        }
+    }
+    catch (...)
+    {
+        Free();
+        throw;
+    }
+}
+
+/***************************************************************************
+*   Method     : ~wavelet_matrix_c - destructor
+*   Description: This is the wavelet_matrix_c destructor.  It frees the
+*                levels.
+*   Parameters : None
+*   Effects    : Levels and directories are freed
+*   Returned   : None
+***************************************************************************/
+wavelet_matrix_c::~wavelet_matrix_c(void)
+{
+    Free();
+}
+
+/***************************************************************************
+*   Method     : Free
+*   Description: This method frees the levels and their directories.
+*   Parameters : None
+*   Effects    : Levels and directories are freed
+*   Returned   : None
+***************************************************************************/
+void wavelet_matrix_c::Free(void)
+{
+    for (size_t i = 0; i < m_Ranks.size(); i++)
+    {
+        delete m_Ranks[i];
+    }
+
+    for (size_t i = 0; i < m_Levels.size(); i++)
+    {
+        delete m_Levels[i];
+    }
+
+    m_Ranks.clear();
+    m_Levels.clear();
+}
+
+/***************************************************************************
+*   Method     : Access
+*   Description: This method returns the value at a position by following
+*                it down the levels.
+*   Parameters : pos - position (less than Size())
+*   Effects    : None
+*   Returned   : Value at pos, 0 if pos is out of range
+***************************************************************************/
+uint32_t wavelet_matrix_c::Access(size_t pos) const
+{
+    uint32_t value = 0;
+
+    if (pos >= m_Size)
+    {
+        return 0;
+    }
+
+    for (size_t level = 0; level < m_Levels.size(); level++)
+    {
+        if ((*m_Levels[level])[pos])
+        {
+            value = (value << 1) | 1;
+            pos = m_Zeros[level] + m_Ranks[level]->Rank1(pos);
+        }
+        else
+        {
+            value <<= 1;
+            pos = m_Ranks[level]->Rank0(pos);
+        }
+    }
+
+    return value;
+}
+
+/***************************************************************************
+*   Method     : Access
+*   Description: This method returns the value at a position along with
+*                the number of times it occurs before the position.  The
+*                start of the value's range is followed down the levels
+*                with the position, so it costs less than Access and Rank
+*                done separately.
+*   Parameters : pos - position (less than Size())
+*                rank - set to the occurrences of the value in [0, pos)
+*   Effects    : rank is set
+*   Returned   : Value at pos, 0 (with rank 0) if pos is out of range
+***************************************************************************/
+uint32_t wavelet_matrix_c::Access(size_t pos, size_t &rank) const
+{
+    uint32_t value = 0;
+    size_t begin = 0;
+
+    rank = 0;
+
+    if (pos >= m_Size)
+    {
+        return 0;
+    }
+
+    for (size_t level = 0; level < m_Levels.size(); level++)
+    {
+        if ((*m_Levels[level])[pos])
+        {
+            value = (value << 1) | 1;
+            begin = m_Zeros[level] + m_Ranks[level]->Rank1(begin);
+            pos = m_Zeros[level] + m_Ranks[level]->Rank1(pos);
+        }
+        else
+        {
+            value <<= 1;
+            begin = m_Ranks[level]->Rank0(begin);
+            pos = m_Ranks[level]->Rank0(pos);
+        }
+    }
+
+    rank = pos - begin;
+    return value;
+}
+
+/***************************************************************************
+*   Method     : Rank
+*   Description: This method counts the occurrences of a value before a
+*                position.
+*   Parameters : value - value to count
+*                pos - position (positions past the end count as Size())
+*   Effects    : None
+*   Returned   : Occurrences of value in [0, pos)
+***************************************************************************/
+size_t wavelet_matrix_c::Rank(const uint32_t value, const size_t pos) const
+{
+    size_t begin, end;
+
+    if ((m_Levels.size() < 32) && ((value >> m_Levels.size()) != 0))
+    {
+        return 0;       /* value is too big to be present */
+    }
+
+    begin = 0;
+    end = min(pos, m_Size);
+
+    for (size_t level = 0; level < m_Levels.size(); level++)
+    {
+        if ((value >> (m_Levels.size() - 1 - level)) & 1)
+        {
+            begin = m_Zeros[level] + m_Ranks[level]->Rank1(begin);
+            end = m_Zeros[level] + m_Ranks[level]->Rank1(end);
+        }
+        else
+        {
+            begin = m_Ranks[level]->Rank0(begin);
+            end = m_Ranks[level]->Rank0(end);
+        }
+    }
+
+    return end - begin;
+}
+
+/***************************************************************************
+*   Method     : Select
+*   Description: This method finds an occurrence of a value.  It follows
+*                the value down the levels to where its occurrences start
+*                in the last level's order, then back up with select.
+*   Parameters : value - value to find
+*                rank - number of the occurrence, counting from 0
+*   Effects    : None
+*   Returned   : Position of occurrence rank of value, Size() if there
+*                are no more than rank occurrences
+***************************************************************************/
+size_t wavelet_matrix_c::Select(const uint32_t value, const size_t rank) const
+{
+    size_t pos;
+
+    if (rank >= Rank(value, m_Size))
+    {
+        return m_Size;
+    }
+
+    pos = 0;
+
+    for (size_t level = 0; level < m_Levels.size(); level++)
+    {
+        if ((value >> (m_Levels.size() - 1 - level)) & 1)
+        {
+            pos = m_Zeros[level] + m_Ranks[level]->Rank1(pos);
+        }
+        else
+        {
+            pos = m_Ranks[level]->Rank0(pos);
+        }
+    }
+
+    pos += rank;
+
+    for (size_t level = m_Levels.size(); level-- > 0;)
+    {
+        if ((value >> (m_Levels.size() - 1 - level)) & 1)
+        {
+            pos = m_Ranks[level]->Select1(pos - m_Zeros[level]);
+        }
+        else
+        {
+            pos = m_Ranks[level]->Select0(pos);
+        }
+    }
+
+    return pos;
+}
+
+/***************************************************************************
+*   Method     : Quantile
+*   Description: This method finds the value that would be at a given
+*                position if a range of the sequence were sorted.  At each
+*                level it goes to the 0s if there are more than k of them
+*                in the range, otherwise to the 1s.
+*   Parameters : begin - first position of the range
+*                end - one past the last position of the range
+*                k - position in sorted order, counting from 0
+*   Effects    : None
+*   Returned   : Value number k of the sorted range, 0 if k isn't less
+*                than the size of the range
+***************************************************************************/
+uint32_t wavelet_matrix_c::Quantile(size_t begin, size_t end, size_t k) const
+{
+    uint32_t value = 0;
+
+    end = min(end, m_Size);
+
+    if ((begin >= end) || (k >= (end - begin)))
+    {
+        return 0;
+    }
+
+    for (size_t level = 0; level < m_Levels.size(); level++)
+    {
+        size_t zeroBegin = m_Ranks[level]->Rank0(begin);
+        size_t zeroEnd = m_Ranks[level]->Rank0(end);
+
+        if (k < (zeroEnd - zeroBegin))
+        {
+            value <<= 1;
+            begin = zeroBegin;
+            end = zeroEnd;
+        }
+        else
+        {
+            value = (value << 1) | 1;
+            k -= zeroEnd - zeroBegin;
+            begin = m_Zeros[level] + (begin - zeroBegin);
+            end = m_Zeros[level] + (end - zeroEnd);
+        }
+    }
+
+    return value;
+}
+
+/***************************************************************************
+*   Method     : TopK
+*   Description: This method finds the most frequent values in a range.
+*                Ranges of values sharing a prefix are kept in a priority
+*                queue by size.  The largest is split into its 0 and 1
+*                halves at the next level until the largest is a single
+*                value at the last level, which is the next most frequent.
+*                Values with equal counts come out smallest first.
+*   Parameters : begin - first position of the range
+*                end - one past the last position of the range
+*                k - number of values wanted
+*                values - array of k receiving the values
+*                counts - array of k receiving the number of occurrences,
+*                    may be NULL
+*   Effects    : values and counts are written
+*   Returned   : Number of values found (k or the number of distinct
+*                values in the range, whichever is less)
+***************************************************************************/
+size_t wavelet_matrix_c::TopK(const size_t begin, const size_t end,
+    const size_t k, uint32_t *values, size_t *counts) const
+{
+    priority_queue<wavelet_range_t, vector<wavelet_range_t>,
+        wavelet_range_less_c> ranges;
+    wavelet_range_t range;
+    size_t found = 0;
+
+    range.begin = begin;
+    range.end = min(end, m_Size);
+    range.level = 0;
+    range.prefix = 0;
+
+    if (range.begin < range.end)
+    {
+        ranges.push(range);
+    }
+
+    while (!ranges.empty() && (found < k))
+    {
+        range = ranges.top();
+        ranges.pop();
+
+        if (range.level == m_Levels.size())
+        {
+            values[found] = range.prefix;
+
+            if (counts != NULL)
+            {
+                counts[found] = range.end - range.begin;
+            }
+
+            found++;
+            continue;
+        }
+
+        const unsigned int level = range.level;
+        size_t zeroBegin = m_Ranks[level]->Rank0(range.begin);
+        size_t zeroEnd = m_Ranks[level]->Rank0(range.end);
+        wavelet_range_t child;
+
+        child.level = level + 1;
+
+        if (zeroBegin < zeroEnd)
+        {
+            child.begin = zeroBegin;
+            child.end = zeroEnd;
+            child.prefix = range.prefix << 1;
+            ranges.push(child);
+        }
+
+        child.begin = m_Zeros[level] + (range.begin - zeroBegin);
+        child.end = m_Zeros[level] + (range.end - zeroEnd);
+
+        if (child.begin < child.end)
+        {
+            child.prefix = (range.prefix << 1) | 1;
+            ranges.push(child);
+        }
+    }
+
+    return found;
+}
+
+/***************************************************************************
+*   Method     : Serialize
+*   Description: This method writes the matrix to a binary stream in a
+*                form that can be read back with the stream constructor.
+*   Parameters : outStream - stream to write to
+*   Effects    : Matrix is written to outStream
+*   Returned   : None
+***************************************************************************/
+void wavelet_matrix_c::Serialize(std::ostream &outStream) const
+{
+    unsigned char header[SERIAL_HEADER_CHARS];
+
+    memcpy(header, SERIAL_MAGIC, 4);
+    header[4] = SERIAL_VERSION;
+    header[5] = (unsigned char)m_Levels.size();
+
+    for (int i = 0; i < 8; i++)
+    {
+        header[6 + i] = (unsigned char)((uint64_t)m_Size >> (CHAR_BIT * i));
+    }
+
+    outStream.write((const char *)header, SERIAL_HEADER_CHARS);
+
+    for (size_t level = 0; level < m_Levels.size(); level++)
+    {
+        m_Levels[level]->Serialize(outStream);
+    }
+}
+
+/***************************************************************************
+*   Method     : huffman_wavelet_c - constructor
+*   Description: This is the huffman_wavelet_c constructor.  It builds a
+*                Huffman code for the symbols' frequencies, then appends
+*                each symbol's code bits to the nodes along its path, a
+*                64 bit word at a time.  The node directories are built
+*                in parallel.
+*   Parameters : symbols - array of symbols
+*                count - number of symbols (at least 1)
+*                numThreads - maximum number of threads, 0 for one per
+*                    hardware thread
+*   Effects    : Nodes and their directories are built
+*   Returned   : None
+***************************************************************************/
+huffman_wavelet_c::huffman_wavelet_c(const unsigned char *symbols,
+    const size_t count, const unsigned int numThreads):
+    m_Size(count),
+    m_Bits(0),
+    m_Only(0)
+{
+    typedef pair<size_t, int32_t> weighted_t;   /* weight, node or ~leaf */
+    priority_queue<weighted_t, vector<weighted_t>, greater<weighted_t> >
+        heap;
+    vector<int32_t> parents;
+    int32_t leafParents[UCHAR_MAX + 1];
+    vector<size_t> weights;
+    vector<uint64_t> pending;
+    vector<unsigned char *> chars;
+
+    if (count == 0)
+    {
+        throw invalid_argument(
+            "Error: Wavelet tree must have at least 1 symbol.");
+    }
+
+    memset(m_Counts, 0, sizeof(m_Counts));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_Counts[symbols[i]]++;
+    }
+
+    for (int c = 0; c <= UCHAR_MAX; c++)
+    {
+        if (m_Counts[c] != 0)
+        {
+            heap.push(weighted_t(m_Counts[c], ~c));
+            m_Only = (unsigned char)c;
+        }
+    }
+
+    /* merge the two lightest trees until one is left */
+    while (heap.size() > 1)
+    {
+        weighted_t child[2];
+        int32_t node = (int32_t)weights.size();
+
+        for (int b = 0; b < 2; b++)
+        {
+            child[b] = heap.top();
+            heap.pop();
+            m_Children.push_back(child[b].second);
+
+            /* parents hold node * 2 + the bit leading to the child */
+            if (child[b].second < 0)
+            {
+                leafParents[~child[b].second] = (node * 2) + b;
+            }
+            else
+            {
+                parents[child[b].second] = (node * 2) + b;
+            }
+        }
+
+        weights.push_back(child[0].first + child[1].first);
+        parents.push_back(-1);
+        heap.push(weighted_t(weights.back(), node));
+    }
+
+    /* codes, from the root down, are the parent links reversed */
+    for (int c = 0; c <= UCHAR_MAX; c++)
+    {
+        m_PathStart[c] = m_Paths.size();
+
+        if ((m_Counts[c] != 0) && !weights.empty())
+        {
+            for (int32_t link = leafParents[c]; link >= 0;
+                link = parents[link / 2])
+            {
+                m_Paths.push_back((uint32_t)link);
+            }
+
+            reverse(m_Paths.begin() + m_PathStart[c], m_Paths.end());
+        }
+    }
+
+    m_PathStart[UCHAR_MAX + 1] = m_Paths.size();
+
+    try
+    {
+        for (size_t node = 0; node < weights.size(); node++)
+        {
+            m_Nodes.push_back(new bit_array_c(weights[node]));
+            chars.push_back(m_Nodes.back()->Chars());
+            m_Bits += weights[node];
+        }
+
+        /* append each code's bits to its nodes, pending bits first */
+        pending.resize(weights.size(), 0);
+        weights.assign(weights.size(), 0);      /* now bits written */
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const unsigned char c = symbols[i];
+
+            for (size_t j = m_PathStart[c]; j < m_PathStart[c + 1]; j++)
+            {
+                size_t node = m_Paths[j] / 2;
+
+                pending[node] = (pending[node] << 1) | (m_Paths[j] & 1);
+                weights[node]++;
+
+                if ((weights[node] % 64) == 0)
+                {
+                    StoreBigEndian(
+                        &chars[node][(weights[node] / CHAR_BIT) - 8],
+                        pending[node]);
+                }
+            }
+        }
+
+        for (size_t node = 0; node < weights.size(); node++)
+        {
+            size_t left = weights[node] % 64;
+            size_t first = (weights[node] - left) / CHAR_BIT;
+            uint64_t word = (left == 0) ? 0 : pending[node] << (64 - left);
+
+            for (size_t i = 0; (i * CHAR_BIT) < left; i++)
+            {
+                chars[node][first + i] =
+                    (unsigned char)(word >> (56 - (CHAR_BIT * i)));
+            }
+        }
+
+        m_Ranks.resize(m_Nodes.size(), NULL);
+
+        ParallelFor(m_Nodes.size(), numThreads,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t node = begin; node < end; node++)
+                {
+                    m_Ranks[node] = new rank_select_c(*m_Nodes[node]);
+                }
+            });
+    }
+    catch (...)
+    {
+        Free();
+        throw;
+    }
+}
+
+/***************************************************************************
+*   Method     : ~huffman_wavelet_c - destructor
+*   Description: This is the huffman_wavelet_c destructor.  It frees the
+*                nodes.
+*   Parameters : None
+*   Effects    : Nodes and directories are freed
+*   Returned   : None
+***************************************************************************/
+huffman_wavelet_c::~huffman_wavelet_c(void)
+{
+    Free();
+}
+
+/***************************************************************************
+*   Method     : Free
+*   Description: This method frees the nodes and their directories.
+*   Parameters : None
+*   Effects    : Nodes and directories are freed
+*   Returned   : None
+***************************************************************************/
+void huffman_wavelet_c::Free(void)
+{
+    for (size_t i = 0; i < m_Ranks.size(); i++)
+    {
+        delete m_Ranks[i];
+    }
+
+    for (size_t i = 0; i < m_Nodes.size(); i++)
+    {
+        delete m_Nodes[i];
+    }
+
+    m_Ranks.clear();
+    m_Nodes.clear();
+}
+
+/***************************************************************************
+*   Method     : Access
+*   Description: This method returns the symbol at a position by following
+*                its code down from the root.
+*   Parameters : pos - position (less than Size())
+*   Effects    : None
+*   Returned   : Symbol at pos, 0 if pos is out of range
+***************************************************************************/
+unsigned char huffman_wavelet_c::Access(const size_t pos) const
+{
+    size_t rank;
+
+    return Access(pos, rank);
+}
+
+/***************************************************************************
+*   Method     : Access
+*   Description: This method returns the symbol at a position along with
+*                the number of times it occurs before the position.  Each
+*                node maps the position to its position in the child it
+*                goes to, so at the leaf it is the symbol's rank.
+*   Parameters : pos - position (less than Size())
+*                rank - set to the occurrences of the symbol in [0, pos)
+*   Effects    : rank is set
+*   Returned   : Symbol at pos, 0 (with rank 0) if pos is out of range
+***************************************************************************/
+unsigned char huffman_wavelet_c::Access(size_t pos, size_t &rank) const
+{
+    int32_t node;
+
+    rank = 0;
+
+    if (pos >= m_Size)
+    {
+        return 0;
+    }
+
+    if (m_Nodes.empty())
+    {
+        rank = pos;
+        return m_Only;
+    }
+
+    node = (int32_t)m_Nodes.size() - 1;
+
+    do
+    {
+        if ((*m_Nodes[node])[pos])
+        {
+            pos = m_Ranks[node]->Rank1(pos);
+            node = m_Children[(node * 2) + 1];
+        }
+        else
+        {
+            pos = m_Ranks[node]->Rank0(pos);
+            node = m_Children[node * 2];
+        }
+    } while (node >= 0);
+
+    rank = pos;
+    return (unsigned char)~node;
+}
+
+/***************************************************************************
+*   Method     : Rank
+*   Description: This method counts the occurrences of a symbol before a
+*                position by following the symbol's code down from the
+*                root.
+*   Parameters : symbol - symbol to count
+*                pos - position (positions past the end count as Size())
+*   Effects    : None
+*   Returned   : Occurrences of symbol in [0, pos)
+***************************************************************************/
+size_t huffman_wavelet_c::Rank(const unsigned char symbol, size_t pos) const
+{
+    if (m_Counts[symbol] == 0)
+    {
+        return 0;
+    }
+
+    pos = min(pos, m_Size);
+
+    for (size_t j = m_PathStart[symbol]; j < m_PathStart[symbol + 1]; j++)
+    {
+        const rank_select_c *ranks = m_Ranks[m_Paths[j] / 2];
+
+        pos = (m_Paths[j] & 1) ? ranks->Rank1(pos) : ranks->Rank0(pos);
+    }
+
+    return pos;
+}
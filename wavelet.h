@@ -0,0 +1,148 @@
+/***************************************************************************
+*                            Wavelet Matrix
+*
+*   File    : wavelet.h
+*   Purpose : Header file for a wavelet matrix, a sequence of 32 bit
+*             symbols stored as rank/select indexed bit arrays that
+*             supports access, rank, select, quantile and top-k queries,
+*             and a Huffman shaped wavelet tree of bytes that supports
+*             access and rank in about the zero order entropy.
+*   Author  : Jordan Ellis
+*   Date    : October 18, 2026
+*
+****************************************************************************
+*
+* Bitarray: An ANSI C++ class for manipulating arbitrary length bit arrays
+* Copyright (C) 2026 by
+*       Jordan Ellis
+*
+* This file is part of the bit array library.
+*
+* The bit array library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public License as
+* published by the Free Software Foundation; either version 3 of the
+* License, or (at your option) any later version.
+*
+* The bit array library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+* General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+***************************************************************************/
+#ifndef WAVELET_H
+#define WAVELET_H
+
+/***************************************************************************
+*                             INCLUDED FILES
+***************************************************************************/
+#include <climits>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <stdint.h>
+#include "bitarray.h"
+#include "rankbits.h"
+
+/***************************************************************************
+*                            TYPE DEFINITIONS
+***************************************************************************/
+class wavelet_matrix_c
+{
+    public:
+        wavelet_matrix_c(const uint32_t *values, const size_t count,
+            const unsigned int numThreads);
+        wavelet_matrix_c(std::istream &inStream);  /* from Serialize */
+        virtual ~wavelet_matrix_c(void);
+
+        size_t Size() const { return m_Size; };
+        unsigned int Levels() const { return m_Levels.size(); };
+
+        /* value at a position */
+        uint32_t Access(const size_t pos) const;
+        uint32_t operator[](const size_t pos) const { return Access(pos); };
+
+        /* value at a position and its occurrences in [0, pos) */
+        uint32_t Access(const size_t pos, size_t &rank) const;
+
+        /* occurrences of value in [0, pos) */
+        size_t Rank(const uint32_t value, const size_t pos) const;
+
+        /* position of occurrence rank (from 0) of value, Size() if none */
+        size_t Select(const uint32_t value, const size_t rank) const;
+
+        /* value number k (from 0) of [begin, end) in sorted order */
+        uint32_t Quantile(size_t begin, size_t end, size_t k) const;
+
+        /* up to k most frequent values in [begin, end), most frequent
+         * first, returns the number found */
+        size_t TopK(const size_t begin, const size_t end, const size_t k,
+            uint32_t *values, size_t *counts) const;
+
+        void Serialize(std::ostream &outStream) const;
+
+    private:
+        /* matrices can't be copied */
+        wavelet_matrix_c(const wavelet_matrix_c &);
+        wavelet_matrix_c& operator=(const wavelet_matrix_c &);
+
+        void Free(void);
+
+        size_t m_Size;                          /* number of values */
+        std::vector<bit_array_c *> m_Levels;    /* one bit per value */
+        std::vector<rank_select_c *> m_Ranks;   /* directory per level */
+        std::vector<size_t> m_Zeros;            /* 0s in each level */
+};
+
+/***************************************************************************
+* Each internal node of the tree has one bit for every symbol whose
+* Huffman code passes through it, 0 for the left child and 1 for the
+* right.  The root is the last node.
+***************************************************************************/
+class huffman_wavelet_c
+{
+    public:
+        huffman_wavelet_c(const unsigned char *symbols, const size_t count,
+            const unsigned int numThreads);
+        virtual ~huffman_wavelet_c(void);
+
+        size_t Size() const { return m_Size; };
+        size_t Bits() const { return m_Bits; };     /* bits in the nodes */
+
+        /* symbol at a position */
+        unsigned char Access(const size_t pos) const;
+        unsigned char operator[](const size_t pos) const
+            { return Access(pos); };
+
+        /* symbol at a position and its occurrences in [0, pos) */
+        unsigned char Access(const size_t pos, size_t &rank) const;
+
+        /* occurrences of symbol in [0, pos) */
+        size_t Rank(const unsigned char symbol, const size_t pos) const;
+
+    private:
+        /* trees can't be copied */
+        huffman_wavelet_c(const huffman_wavelet_c &);
+        huffman_wavelet_c& operator=(const huffman_wavelet_c &);
+
+        void Free(void);
+
+        size_t m_Size;                          /* number of symbols */
+        size_t m_Bits;                          /* bits in all nodes */
+        size_t m_Counts[UCHAR_MAX + 1];         /* occurrences of symbols */
+        unsigned char m_Only;                   /* symbol if no nodes */
+        std::vector<bit_array_c *> m_Nodes;     /* bits of each node */
+        std::vector<rank_select_c *> m_Ranks;   /* directory per node */
+
+        /* child b of node n is entry 2n + b, ~symbol for a leaf */
+        std::vector<int32_t> m_Children;
+
+        /* code of symbol s, as node * 2 + bit from the root, is entries
+         * m_PathStart[s] to m_PathStart[s + 1] - 1 of m_Paths */
+        std::vector<uint32_t> m_Paths;
+        size_t m_PathStart[UCHAR_MAX + 2];
+};
+
+#endif  /* ndef WAVELET_H */